@@ -0,0 +1,6 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include "benchmark/benchmark.h"
+
+#endif
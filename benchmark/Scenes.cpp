@@ -0,0 +1,204 @@
+#include "Benchmarks.h"
+
+#include <physics/Physics.h>
+#include <cmath>
+#include <chrono>
+
+using namespace physics;
+
+namespace {
+
+/* Time step of every step */
+constexpr float TIME_STEP = 1.0f / 60.0f;
+
+/* Timed steps of a scene, fixed so that every run simulates the same frames */
+constexpr uint32 NUM_TIMED_STEPS = 120;
+
+/* Create a static box */
+void createStaticBox(World* world, BoxShape* box, const Vector2& position) {
+  Body* body = world->createBody(Transform(position, Rotation(0.0f)));
+  body->setType(BodyType::Static);
+  body->addCollider(box, Transform());
+}
+
+/* Create a dynamic body with a single collider */
+Body* createDynamicBody(World* world, Shape* shape, const Vector2& position, float angle) {
+  Body* body = world->createBody(Transform(position, Rotation(angle)));
+  body->addCollider(shape, Transform());
+  body->setMassPropertiesUsingColliders();
+  return body;
+}
+
+/* Create a ground with walls on both sides which keep the bodies falling onto it in place */
+void createContainer(Factory& factory, World* world, float halfWidth, float height) {
+  BoxShape* ground = factory.createBox(halfWidth + 1.0f, 1.0f);
+  BoxShape* wall = factory.createBox(1.0f, 0.5f * height);
+  createStaticBox(world, ground, Vector2(0.0f, -1.0f));
+  createStaticBox(world, wall, Vector2(-halfWidth - 1.0f, 0.5f * height));
+  createStaticBox(world, wall, Vector2(halfWidth + 1.0f, 0.5f * height));
+}
+
+/* Step a scene once per iteration and report the duration of a step and the number of bodies simulated per second */
+void runScene(benchmark::State& state, World* world, uint32 numBodies, uint32 numWarmUpSteps) {
+  /* Let the scene reach the state it is meant to measure */
+  for(uint32 i = 0; i < numWarmUpSteps; i++) {
+    world->step(TIME_STEP);
+  }
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  for(auto _ : state) {
+    world->step(TIME_STEP);
+  }
+
+  const std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+  state.counters["bodies"] = static_cast<double>(numBodies);
+  state.counters["ms/step"] = benchmark::Counter(duration.count(), benchmark::Counter::kAvgIterations);
+  state.counters["bodies/sec"] = benchmark::Counter(static_cast<double>(numBodies), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+}
+
+/* Pyramid of boxes resting on the ground, which stresses the contact solver with one large island */
+static void BoxPyramid(benchmark::State& state) {
+  const uint32 numRows = static_cast<uint32>(state.range(0));
+  Factory factory;
+  World* world = factory.createWorld();
+  BoxShape* ground = factory.createBox(1.0f * numRows + 10.0f, 1.0f);
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+  uint32 numBodies = 0;
+
+  createStaticBox(world, ground, Vector2(0.0f, -1.0f));
+
+  for(uint32 i = 0; i < numRows; i++) {
+    const uint32 numRowBoxes = numRows - i;
+
+    for(uint32 j = 0; j < numRowBoxes; j++) {
+      createDynamicBody(world, box, Vector2(1.05f * j - 0.525f * (numRowBoxes - 1), 0.5f + 1.0f * i), 0.0f);
+      numBodies++;
+    }
+  }
+
+  runScene(state, world, numBodies, 0);
+}
+
+/* Circles falling from a staggered grid into a container, which stresses the broad phase as contacts keep appearing */
+static void CircleRain(benchmark::State& state) {
+  const uint32 numBodies = static_cast<uint32>(state.range(0));
+  const uint32 numColumns = 64;
+  Factory factory;
+  World* world = factory.createWorld();
+  CircleShape* circle = factory.createCircle(0.25f);
+
+  createContainer(factory, world, 0.6f * numColumns, 0.6f * numBodies / numColumns + 20.0f);
+
+  for(uint32 i = 0; i < numBodies; i++) {
+    const uint32 row = i / numColumns;
+    const uint32 column = i % numColumns;
+    const float offset = (row % 2) ? 0.3f : 0.0f;
+    createDynamicBody(world, circle, Vector2(1.2f * column - 0.6f * numColumns + offset + 0.3f, 10.0f + 1.2f * row), 0.0f);
+  }
+
+  runScene(state, world, numBodies, 0);
+}
+
+/* Boxes, circles and hexagons dropped onto each other, which exercises every narrow phase algorithm */
+static void MixedShapeHeap(benchmark::State& state) {
+  const uint32 numBodies = static_cast<uint32>(state.range(0));
+  const uint32 numColumns = 32;
+  Factory factory;
+  World* world = factory.createWorld();
+  BoxShape* box = factory.createBox(0.4f, 0.4f);
+  CircleShape* circle = factory.createCircle(0.4f);
+  Vector2 points[6];
+
+  for(uint32 i = 0; i < 6; i++) {
+    const float angle = i * (2.0f * PI / 6.0f);
+    points[i] = Vector2(0.45f * std::cos(angle), 0.45f * std::sin(angle));
+  }
+
+  PolygonShape* hexagon = factory.createPolygon(points, 6);
+  Shape* shapes[] = {box, circle, hexagon};
+
+  createContainer(factory, world, 0.5f * numColumns, 1.0f * numBodies / numColumns + 10.0f);
+
+  for(uint32 i = 0; i < numBodies; i++) {
+    const uint32 row = i / numColumns;
+    const uint32 column = i % numColumns;
+    createDynamicBody(world, shapes[i % 3], Vector2(1.0f * column - 0.5f * numColumns + 0.5f, 1.0f + 1.0f * row), 0.1f * (i % 7));
+  }
+
+  runScene(state, world, numBodies, 60);
+}
+
+/* Bodies bouncing through a large level of static platforms, which stresses the broad phase with many bodies which never move */
+static void StaticLevel(benchmark::State& state) {
+  const uint32 numBodies = static_cast<uint32>(state.range(0));
+  const uint32 numLevelRows = 32;
+  const uint32 numLevelColumns = 64;
+  const uint32 numColumns = 64;
+  Factory factory;
+  World* world = factory.createWorld();
+  BoxShape* platform = factory.createBox(0.75f, 0.1f);
+  BoxShape* box = factory.createBox(0.25f, 0.25f);
+  CircleShape* circle = factory.createCircle(0.25f);
+  const float halfWidth = 1.0f * numLevelColumns;
+
+  createContainer(factory, world, halfWidth, 3.0f * numLevelRows + 2.0f * numBodies / numColumns + 10.0f);
+
+  /* Staggered rows of tilted platforms */
+  for(uint32 i = 0; i < numLevelRows; i++) {
+    for(uint32 j = 0; j < numLevelColumns; j++) {
+      const float offset = (i % 2) ? 1.0f : 0.0f;
+      Body* body = world->createBody(Transform(Vector2(2.0f * j - halfWidth + offset + 0.5f, 2.0f + 3.0f * i), Rotation((j % 2) ? 0.3f : -0.3f)));
+      body->setType(BodyType::Static);
+      body->addCollider(platform, Transform());
+    }
+  }
+
+  for(uint32 i = 0; i < numBodies; i++) {
+    const uint32 row = i / numColumns;
+    const uint32 column = i % numColumns;
+    Shape* shape = (i % 2) ? static_cast<Shape*>(box) : static_cast<Shape*>(circle);
+    createDynamicBody(world, shape, Vector2(2.0f * column - halfWidth + 1.0f, 3.0f * numLevelRows + 4.0f + 2.0f * row), 0.0f);
+  }
+
+  runScene(state, world, numBodies, 30);
+}
+
+/* Rows of circles resting on the ground which fall asleep except for a few, which measures the cost of bodies which are not simulated */
+static void SleepingWorld(benchmark::State& state) {
+  const uint32 numBodies = static_cast<uint32>(state.range(0));
+  const uint32 numColumns = 128;
+  const uint32 numRows = (numBodies + numColumns - 1) / numColumns;
+  Factory factory;
+  World* world = factory.createWorld();
+  BoxShape* ground = factory.createBox(1.0f * numColumns + 1.0f, 0.5f);
+  CircleShape* circle = factory.createCircle(0.5f);
+
+  /* Each row rests on its own ground, far enough from the next row for the rows never to touch */
+  for(uint32 i = 0; i < numRows; i++) {
+    createStaticBox(world, ground, Vector2(0.0f, 4.0f * i - 0.5f));
+  }
+
+  for(uint32 i = 0; i < numBodies; i++) {
+    const uint32 row = i / numColumns;
+    const uint32 column = i % numColumns;
+    Body* body = createDynamicBody(world, circle, Vector2(2.0f * column - 1.0f * numColumns + 1.0f, 4.0f * row + 0.5f), 0.0f);
+
+    /* One body in thirty two stays awake and keeps rolling */
+    if(i % 32 == 0) {
+      body->setIsAllowedToSleep(false);
+      body->setLinearVelocity(Vector2(1.0f, 0.0f));
+    }
+  }
+
+  /* The resting bodies fall asleep after the sleep time */
+  runScene(state, world, numBodies, 90);
+}
+
+BENCHMARK(BoxPyramid)->Arg(10)->Arg(20)->Arg(40)->Iterations(NUM_TIMED_STEPS)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(CircleRain)->Arg(256)->Arg(1024)->Arg(4096)->Iterations(NUM_TIMED_STEPS)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(MixedShapeHeap)->Arg(256)->Arg(1024)->Arg(4096)->Iterations(NUM_TIMED_STEPS)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(StaticLevel)->Arg(256)->Arg(1024)->Arg(4096)->Iterations(NUM_TIMED_STEPS)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(SleepingWorld)->Arg(1024)->Arg(4096)->Arg(16384)->Iterations(NUM_TIMED_STEPS)->UseRealTime()->Unit(benchmark::kMillisecond);
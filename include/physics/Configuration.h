@@ -90,6 +90,30 @@ namespace physics {
 
   /* Maximum rotation */
   constexpr float MAX_ROTATION = (0.5f * PI) * (0.5f * PI);
+
+  /* Number of bodies handled by a single task when updating bodies in parallel */
+  constexpr uint32 BODY_TASK_GRAIN_SIZE = 256;
+
+  /* Number of moved shapes queried against the dynamic tree by a single task */
+  constexpr uint32 BROAD_PHASE_TASK_GRAIN_SIZE = 64;
+
+  /* Number of narrow phase entries executed by a single task */
+  constexpr uint32 NARROW_PHASE_TASK_GRAIN_SIZE = 64;
+
+  /* Number of contact pairs merged into islands by a single task */
+  constexpr uint32 ISLAND_TASK_GRAIN_SIZE = 256;
+
+  /* Minimum number of manifolds in a batch of islands solved by a single task */
+  constexpr uint32 CONTACT_SOLVER_TASK_GRAIN_SIZE = 32;
+
+  /* Maximum number of colors of a colored island, the last color holds the remaining constraints and is solved sequentially */
+  constexpr uint8 GRAPH_COLORING_MAX_COLORS = 64;
+
+  /* Number of constraints of a single color solved by a single task */
+  constexpr uint32 GRAPH_COLOR_TASK_GRAIN_SIZE = 64;
+
+  /* Number of wide constraints of a single color solved by a single task */
+  constexpr uint32 GRAPH_COLOR_WIDE_TASK_GRAIN_SIZE = 8;
 }
 
 #endif
\ No newline at end of file
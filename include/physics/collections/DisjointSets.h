@@ -0,0 +1,132 @@
+#ifndef PHYSICS_DISJOINT_SETS_H
+#define PHYSICS_DISJOINT_SETS_H
+
+#include <physics/Configuration.h>
+#include <physics/memory/MemoryHandler.h>
+#include <atomic>
+#include <new>
+#include <cstdint>
+#include <cassert>
+
+namespace physics {
+
+/* Disjoint sets over a fixed number of elements which may be merged from several threads at once */
+/* A set is always linked under the smallest of the two roots so its final root is its smallest element regardless of the order of the merges */
+class DisjointSets {
+
+  private:
+    /* -- Attributes -- */
+
+    /* Memory handler */
+    MemoryHandler& mMemoryHandler;
+
+    /* Parent of each element */
+    std::atomic<uint32>* mParents;
+
+    /* Number of elements */
+    uint32 mSize;
+
+  public:
+    /* -- Methods -- */
+
+    /* Constructor */
+    DisjointSets(MemoryHandler& memoryHandler, uint32 size);
+
+    /* Destructor */
+    ~DisjointSets();
+
+    /* Deleted copy constructor */
+    DisjointSets(const DisjointSets& sets) = delete;
+
+    /* Deleted assignment operator */
+    DisjointSets& operator=(const DisjointSets& sets) = delete;
+
+    /* Get the number of elements */
+    uint32 size() const;
+
+    /* Get the root of the set of an element */
+    uint32 findRoot(uint32 element);
+
+    /* Merge the sets of two elements */
+    void merge(uint32 first, uint32 second);
+};
+
+/* Constructor */
+inline DisjointSets::DisjointSets(MemoryHandler& memoryHandler, uint32 size) : mMemoryHandler(memoryHandler), mParents(nullptr), mSize(size) {
+  if(mSize) {
+    mParents = static_cast<std::atomic<uint32>*>(mMemoryHandler.allocate(mSize * sizeof(std::atomic<uint32>)));
+    assert(mParents);
+
+    /* Misaligned atomics are undefined and may straddle cache lines */
+    assert(reinterpret_cast<std::uintptr_t>(mParents) % alignof(std::atomic<uint32>) == 0);
+
+    /* Every element starts in a set of its own */
+    for(uint32 i = 0; i < mSize; i++) {
+      new (mParents + i) std::atomic<uint32>(i);
+    }
+  }
+}
+
+/* Destructor */
+inline DisjointSets::~DisjointSets() {
+  if(mParents) {
+    mMemoryHandler.free(mParents, mSize * sizeof(std::atomic<uint32>));
+  }
+}
+
+/* Get the number of elements */
+inline uint32 DisjointSets::size() const {
+  return mSize;
+}
+
+/* Get the root of the set of an element */
+inline uint32 DisjointSets::findRoot(uint32 element) {
+  assert(element < mSize);
+
+  while(true) {
+    uint32 parent = mParents[element].load(std::memory_order_relaxed);
+
+    if(parent == element) {
+      return element;
+    }
+
+    const uint32 grandParent = mParents[parent].load(std::memory_order_relaxed);
+
+    /* Path halving, losing the race to another thread only leaves the path longer */
+    if(parent != grandParent) {
+      mParents[element].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+    }
+
+    element = grandParent;
+  }
+}
+
+/* Merge the sets of two elements */
+inline void DisjointSets::merge(uint32 first, uint32 second) {
+  while(true) {
+    first = findRoot(first);
+    second = findRoot(second);
+
+    if(first == second) {
+      return;
+    }
+
+    /* Link the larger root under the smaller one so that parents never exceed their children */
+    if(first < second) {
+      const uint32 element = first;
+      first = second;
+      second = element;
+    }
+
+    uint32 expected = first;
+
+    /* Another thread may have linked the root in the meantime in which case we start over from the new roots */
+    if(mParents[first].compare_exchange_strong(expected, second, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+}
+
+#endif
@@ -547,6 +547,8 @@ inline void Map<K, V, Hash, KeyEqual>::clear(bool free) {
     mNextElements = nullptr;
     mNumAllocatedElements = 0;
     mHashSize = 0;
+    /* The free list referred to the released elements */
+    mFree = POISON_INDEX;
   }
 
   mNumElements = 0;
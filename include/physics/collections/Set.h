@@ -538,6 +538,8 @@ inline void Set<V, Hash, KeyEqual>::clear(bool free) {
     mNextElements = nullptr;
     mNumAllocatedElements = 0;
     mHashSize = 0;
+    /* The free list referred to the released elements */
+    mFree = POISON_INDEX;
   }
 
   mNumElements = 0;
@@ -7,6 +7,7 @@
 #include <physics/common/TransformComponents.h>
 #include <physics/common/ColliderComponents.h>
 #include <physics/common/BodyComponents.h>
+#include <physics/common/TaskScheduler.h>
 
 namespace physics {
 
@@ -22,7 +23,10 @@ class BroadPhase {
   private:
     /* -- Attributes -- */
 
-    /* Dynamic Tree */
+    /* Dynamic tree of the shapes of static bodies, which is built once and rarely changes */
+    DynamicTree mStaticTree;
+
+    /* Dynamic tree of the shapes of dynamic and kinematic bodies */
     DynamicTree mDynamicTree;
 
     /* Body components */
@@ -42,6 +46,21 @@ class BroadPhase {
 
     /* -- Methods -- */
 
+    /* Get the broad phase identifier of a node of one of the trees */
+    static int32 getBroadPhaseIdentifier(int32 node, bool isStatic);
+
+    /* Get the node of the tree holding the shape associated with the provided broad phase identifier */
+    static int32 getNode(int32 broadPhaseIdentifier);
+
+    /* Get the tree holding the shape associated with the provided broad phase identifier */
+    DynamicTree& getTree(int32 broadPhaseIdentifier);
+
+    /* Get the tree holding the shape associated with the provided broad phase identifier */
+    const DynamicTree& getTree(int32 broadPhaseIdentifier) const;
+
+    /* Append the pairs of broad phase identifiers of the shapes of a tree overlapping with a range of test shapes of a tree */
+    void getOverlapNodes(MemoryHandler& memoryHandler, const DynamicTree& testTree, const DynamicArray<int32>& testNodes, uint32 begin, uint32 end, const DynamicTree& tree, DynamicArray<Pair<int32, int32>>& overlapNodes) const;
+
     /* Notify tree about collider update */
     void notifyColliderUpdate(int32 broadPhaseIdentifier, Collider* collider, const AABB& aabb, bool forceInsert);
 
@@ -81,11 +100,17 @@ class BroadPhase {
     /* Remove collider to be tested for overlap */
     void removeColliderForTest(int32 broadPhaseIdentifier);
 
+    /* Query whether the shape associated with the provided broad phase identifier is held by the static tree */
+    static bool isStatic(int32 broadPhaseIdentifier);
+
     /* Get the collider associated with the provided broad phase identifier */
     Collider* getCollider(int32 broadPhaseIdentifier) const;
 
-    /* Compute overlap pairs */
-    void computeOverlapPairs(MemoryStrategy& memoryStrategy, DynamicArray<Pair<int32, int32>>& overlapNodes);
+    /* Get the number of moved shapes to be tested for overlap */
+    uint32 getNumShapesToTest() const;
+
+    /* Compute overlap pairs where chunks of the moved shapes are queried in parallel */
+    void computeOverlapPairs(MemoryStrategy& memoryStrategy, TaskScheduler& taskScheduler, DynamicArray<Pair<int32, int32>>& overlapNodes);
 
     /* Query whether two shapes are overlapping */
     bool testShapesOverlap(int32 firstBroadPhaseIdentifier, int32 secondBroadPhaseIdentifier) const;
@@ -94,6 +119,34 @@ class BroadPhase {
     const AABB& getFatAABB(int32 broadPhaseIdentifier);
 };
 
+/* Get the broad phase identifier of a node of one of the trees */
+inline int32 BroadPhase::getBroadPhaseIdentifier(int32 node, bool isStatic) {
+  assert(node >= 0);
+  return (node << 1) | static_cast<int32>(isStatic);
+}
+
+/* Get the node of the tree holding the shape associated with the provided broad phase identifier */
+inline int32 BroadPhase::getNode(int32 broadPhaseIdentifier) {
+  assert(broadPhaseIdentifier >= 0);
+  return broadPhaseIdentifier >> 1;
+}
+
+/* Query whether the shape associated with the provided broad phase identifier is held by the static tree */
+inline bool BroadPhase::isStatic(int32 broadPhaseIdentifier) {
+  assert(broadPhaseIdentifier >= 0);
+  return broadPhaseIdentifier & 1;
+}
+
+/* Get the tree holding the shape associated with the provided broad phase identifier */
+inline DynamicTree& BroadPhase::getTree(int32 broadPhaseIdentifier) {
+  return isStatic(broadPhaseIdentifier) ? mStaticTree : mDynamicTree;
+}
+
+/* Get the tree holding the shape associated with the provided broad phase identifier */
+inline const DynamicTree& BroadPhase::getTree(int32 broadPhaseIdentifier) const {
+  return isStatic(broadPhaseIdentifier) ? mStaticTree : mDynamicTree;
+}
+
 }
 
 #endif
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <physics/collision/OverlapPairs.h>
 #include <physics/collision/NarrowPhase.h>
 #include <physics/collision/algorithms/AlgorithmDispatch.h>
+#include <physics/common/TaskScheduler.h>
 
 namespace physics {
 
@@ -37,6 +38,9 @@ class CollisionDetection {
     /* Transform components */
     TransformComponents& mTransformComponents;
 
+    /* Task scheduler */
+    TaskScheduler& mTaskScheduler;
+
     /* Overlapping nodes in broad phase */
     DynamicArray<Pair<int32, int32>> mBroadPhaseOverlapNodes;
 
@@ -79,6 +83,9 @@ class CollisionDetection {
     /* Previous contact manifolds */
     DynamicArray<LocalManifold>* mLastManifolds;
 
+    /* Contacts which started or ended since the last frame, consumed by the persistent islands */
+    DynamicArray<ContactEvent> mContactEvents;
+
     /* Broad phase */
     BroadPhase mBroadPhase;
 
@@ -96,6 +103,9 @@ class CollisionDetection {
     /* Prepare for narrow phase collision detection*/
     void prepareNarrowPhase(NarrowPhase& narrowPhase);
 
+    /* Query whether the relative transform of two shapes is within the manifold reuse tolerances of another one */
+    bool isRelativeTransformUnchanged(const Transform& lastRelativeTransform, const Transform& relativeTransform) const;
+
     /* Compute narrow phase collision detection */
     void runNarrowPhase();
 
@@ -133,7 +143,7 @@ class CollisionDetection {
     /* -- Methods -- */
 
     /* Constructor */
-    CollisionDetection(World* world, MemoryStrategy& memoryStrategy, BodyComponents& bodyComponents, ColliderComponents& colliderComponents, TransformComponents& transformComponents);
+    CollisionDetection(World* world, MemoryStrategy& memoryStrategy, BodyComponents& bodyComponents, ColliderComponents& colliderComponents, TransformComponents& transformComponents, TaskScheduler& taskScheduler);
 
     /* Destructor */
     ~CollisionDetection() = default;
@@ -171,6 +181,9 @@ class CollisionDetection {
     /* Notify that overlap pairs where the given collider is involved need to be tested for overlap */
     void notifyOverlapPairsToTest(Collider* collider);
 
+    /* Discard the results kept by the overlap pairs of a collider whose geometry relative to its body changed */
+    void invalidateOverlapPairs(Entity colliderEntity);
+
     /* Get collision algorithm dispatch */
     AlgorithmDispatch& getAlgorithmDispatch();
 
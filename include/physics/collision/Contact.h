@@ -188,6 +188,30 @@ struct ContactPair {
                 isInIsland(false) {}
 };
 
+/* Contact between two bodies which started or ended since the last frame */
+struct ContactEvent {
+
+  public:
+    /* -- Attributes -- */
+
+    /* First body entity */
+    Entity firstBodyEntity;
+
+    /* Second body entity */
+    Entity secondBodyEntity;
+
+    /* True if the contact started, false if it ended */
+    bool isStarted;
+
+    /* -- Methods -- */
+
+    /* Constructor */
+    ContactEvent(Entity firstBodyEntity, Entity secondBodyEntity, bool isStarted) :
+                 firstBodyEntity(firstBodyEntity),
+                 secondBodyEntity(secondBodyEntity),
+                 isStarted(isStarted) {}
+};
+
 inline LocalManifold::LocalManifold(LocalManifoldInfo info,
                                     Entity firstBodyEntity,
                                     Entity secondBodyEntity,
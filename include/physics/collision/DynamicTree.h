@@ -144,12 +144,18 @@ class DynamicTree {
     /* Update object when it has moved */
     bool update(int32 node, const AABB& aabb, bool forceInsert = false);
 
-    /* Get all of the shapes that are overlapping with the provided test shapes */
-    void getShapeShapeOverlaps(const DynamicArray<int32>& testNodes, uint32 begin, uint32 end, DynamicArray<Pair<int32, int32>>& overlappingNodes) const;
+    /* Get all of the shapes that are overlapping with the provided test shapes, the traversal stack being allocated from the provided memory handler */
+    void getShapeShapeOverlaps(MemoryHandler& memoryHandler, const DynamicArray<int32>& testNodes, uint32 begin, uint32 end, DynamicArray<Pair<int32, int32>>& overlappingNodes) const;
+
+    /* Get all of the shapes that are overlapping with the provided test shapes of another tree, the traversal stack being allocated from the provided memory handler */
+    void getShapeShapeOverlaps(MemoryHandler& memoryHandler, const DynamicTree& testTree, const DynamicArray<int32>& testNodes, uint32 begin, uint32 end, DynamicArray<Pair<int32, int32>>& overlappingNodes) const;
 
     /* Get all of the shapes that are overlapping with the provided AABB */
     void getShapeAABBOverlap(const AABB& aabb, DynamicArray<int32>& overlappingNodes) const;
 
+    /* Get all of the shapes that are overlapping with the provided AABB, the traversal stack being allocated from the provided memory handler */
+    void getShapeAABBOverlap(MemoryHandler& memoryHandler, const AABB& aabb, DynamicArray<int32>& overlappingNodes) const;
+
     /* Clear the tree */
     void clear();
 };
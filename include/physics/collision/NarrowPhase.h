@@ -8,7 +8,7 @@
 namespace physics {
 
 /* Forward declarations */
-class CollisionAlgorithm;
+enum class CollisionAlgorithmType;
 
 class NarrowPhase {
 
@@ -21,71 +21,109 @@ class NarrowPhase {
     /* Broad phase overlap pairs */
     OverlapPairs& mOverlapPairs;
 
-    /* Cached capacity */
-    uint32 mCachedCapacity = 0;
-
   public:
     /* -- Nested classes -- */
 
-    /* Input information to the narrow phase module */
-    struct NarrowPhaseInfo {
-      
+    /* Input and output of the narrow phase for the entries of a single collision algorithm, stored as a structure of arrays */
+    struct NarrowPhaseBatch {
+
+      private:
+        /* -- Attributes -- */
+
+        /* Cached capacity */
+        uint32 mCachedCapacity;
+
       public:
         /* -- Attributes -- */
 
         /* Overlap pairs identifiers from broadphase */
-        uint64 overlapPairIdentifier;
+        DynamicArray<uint64> overlapPairIdentifiers;
+
+        /* Index of each overlap pair in the overlap pairs, valid until the overlap pairs change */
+        DynamicArray<uint32> overlapPairIndices;
 
         /* Entity of the first collider */
-        Entity firstColliderEntity;
+        DynamicArray<Entity> firstColliderEntities;
 
         /* Entity of the second collider */
-        Entity secondColliderEntity;
+        DynamicArray<Entity> secondColliderEntities;
 
         /* First collision shape */
-        Shape* firstShape;
+        DynamicArray<Shape*> firstShapes;
 
         /* Second collision shape */
-        Shape* secondShape;
+        DynamicArray<Shape*> secondShapes;
 
         /* Local to world transform of the first shape */
-        Transform firstShapeTransform;
+        DynamicArray<Transform> firstShapeTransforms;
 
         /* Local to world transform of the second shape */
-        Transform secondShapeTransform;
+        DynamicArray<Transform> secondShapeTransforms;
 
-        /* Collision algorithm based on shape type */
-        CollisionAlgorithm* algorithm;
+        /* Contact manifold found by the narrow phase */
+        DynamicArray<LocalManifoldInfo> manifolds;
 
         /* Result of the collision detection test in narrow phase */
-        bool isColliding;
+        DynamicArray<bool> isColliding;
+
+        /* Axis found during the last frame on input and during the current frame on output */
+        DynamicArray<SeparatingAxis> separatingAxes;
 
         /* -- Methods -- */
 
         /* Constructor */
-        NarrowPhaseInfo(uint64 overlapPairIdentifier,
-                        Entity firstColliderEntity,
-                        Entity secondColliderEntity,
-                        Shape* firstShape,
-                        Shape* secondShape,
-                        Transform firstShapeTransform,
-                        Transform secondShapeTransform,
-                        CollisionAlgorithm* algorithm) :
-                        overlapPairIdentifier(overlapPairIdentifier),
-                        firstColliderEntity(firstColliderEntity),
-                        secondColliderEntity(secondColliderEntity),
-                        firstShape(firstShape),
-                        secondShape(secondShape),
-                        firstShapeTransform(firstShapeTransform),
-                        secondShapeTransform(secondShapeTransform),
-                        algorithm(algorithm),
-                        isColliding(false) {}
+        NarrowPhaseBatch(MemoryHandler& memoryHandler);
+
+        /* Get the number of entries */
+        uint32 size() const;
+
+        /* Add an entry */
+        void add(uint64 overlapPairIdentifier,
+                 uint32 overlapPairIndex,
+                 Entity firstColliderEntity,
+                 Entity secondColliderEntity,
+                 Shape* firstShape,
+                 Shape* secondShape,
+                 const Transform& firstShapeTransform,
+                 const Transform& secondShapeTransform,
+                 const SeparatingAxis& separatingAxis);
+
+        /* Initialize using cached capacity */
+        void reserve();
+
+        /* Clear all entries */
+        void clear();
     };
 
+  private:
+  /* -- Methods -- */
+
+  /* Add narrow phase entry to a batch */
+  void addBatchEntry(NarrowPhaseBatch& batch,
+                     uint64 overlapPairIdentifier,
+                     uint32 overlapPairIndex,
+                     Entity firstColliderEntity,
+                     Entity secondColliderEntity,
+                     Shape* firstShape,
+                     Shape* secondShape,
+                     const Transform& firstShapeTransform,
+                     const Transform& secondShapeTransform,
+                     const SeparatingAxis& separatingAxis);
+
+  public:
   /* -- Attributes -- */
 
-  /* Narrow phase entries */
-  DynamicArray<NarrowPhaseInfo> entries;
+  /* Circle-Circle narrow phase entries */
+  NarrowPhaseBatch circleVCircleBatch;
+
+  /* Circle-Polygon narrow phase entries */
+  NarrowPhaseBatch circleVPolygonBatch;
+
+  /* Polygon-Polygon narrow phase entries */
+  NarrowPhaseBatch polygonVPolygonBatch;
+
+  /* Entries whose last manifold is reused instead of executing their collision algorithm */
+  NarrowPhaseBatch reusedBatch;
 
   /* -- Methods -- */
   
@@ -95,15 +133,33 @@ class NarrowPhase {
   /* Destructor */
   ~NarrowPhase();
 
+  /* Get the narrow phase entries of a collision algorithm */
+  NarrowPhaseBatch& getBatch(CollisionAlgorithmType algorithmType);
+
   /* Add narrow phase entry */
   void addEntry(uint64 overlapPairIdentifier,
+                uint32 overlapPairIndex,
                 Entity firstColliderEntity,
                 Entity secondColliderEntity,
                 Shape* firstShape,
                 Shape* secondShape,
                 const Transform& firstShapeTransform,
                 const Transform& secondShapeTransform,
-                CollisionAlgorithm* algorithm);
+                CollisionAlgorithmType algorithmType,
+                const SeparatingAxis& separatingAxis);
+
+  /* Add narrow phase entry whose last manifold is reused */
+  void addReusedEntry(uint64 overlapPairIdentifier,
+                      uint32 overlapPairIndex,
+                      Entity firstColliderEntity,
+                      Entity secondColliderEntity,
+                      Shape* firstShape,
+                      Shape* secondShape,
+                      const Transform& firstShapeTransform,
+                      const Transform& secondShapeTransform,
+                      const SeparatingAxis& separatingAxis,
+                      const LocalManifoldInfo& manifold,
+                      bool isColliding);
 
   /* Initialize using cached capacity */
   void reserve();
@@ -112,6 +168,11 @@ class NarrowPhase {
   void clear();
 };
 
+/* Get the number of entries */
+inline uint32 NarrowPhase::NarrowPhaseBatch::size() const {
+  return static_cast<uint32>(overlapPairIdentifiers.size());
+}
+
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -2,6 +2,7 @@
 #define PHYSICS_OVERLAP_PAIRS_H
 
 #include <physics/collision/Collider.h>
+#include <physics/collision/Contact.h>
 #include <physics/common/BodyComponents.h>
 #include <physics/common/ColliderComponents.h>
 #include <physics/common/TransformComponents.h>
@@ -18,6 +19,31 @@ class NarrowPhase;
 class AlgorithmDispatch;
 class Shape;
 
+/* Axis which separated the shapes of an overlap pair, or served as their reference face, during the last narrow phase */
+/* The owner refers to the order of the shapes within the narrow phase entry of the pair */
+struct SeparatingAxis {
+
+  public:
+    /* -- Nested Classes -- */
+    enum class Owner : uint8 {None, FirstShape, SecondShape};
+
+    /* -- Attributes -- */
+
+    /* Shape whose edge normal is the axis */
+    Owner owner;
+
+    /* Edge of the owning shape */
+    uint8 edge;
+
+    /* -- Methods -- */
+
+    /* Constructor */
+    SeparatingAxis() : owner(Owner::None), edge(0) {}
+
+    /* Constructor */
+    SeparatingAxis(Owner owner, uint8 edge) : owner(owner), edge(edge) {}
+};
+
 class OverlapPairs {
 
   public:
@@ -49,6 +75,24 @@ class OverlapPairs {
 
         CollisionAlgorithmType collisionAlgorithmType;
 
+        /* Axis found by the narrow phase during the last frame */
+        SeparatingAxis separatingAxis;
+
+        /* Relative transform of the shapes for which the last manifold was computed */
+        Transform relativeTransform;
+
+        /* Manifold computed by the narrow phase for the relative transform, in narrow phase entry order */
+        LocalManifoldInfo lastManifold;
+
+        /* True if the shapes were colliding at the relative transform */
+        bool wasColliding;
+
+        /* True if the last manifold has been computed */
+        bool isLastManifoldValid;
+
+        /* True if the shapes were touching at the end of the last narrow phase, only tracked for persistent islands */
+        bool isTouching;
+
         /* -- Methods -- */
 
         /* Constructor */
@@ -64,7 +108,13 @@ class OverlapPairs {
                     firstColliderEntity(firstColliderEntity),
                     secondColliderEntity(secondColliderEntity),
                     testOverlap(false),
-                    collisionAlgorithmType(collisionAlgorithmType) {}
+                    collisionAlgorithmType(collisionAlgorithmType),
+                    separatingAxis(),
+                    relativeTransform(),
+                    lastManifold(),
+                    wasColliding(false),
+                    isLastManifoldValid(false),
+                    isTouching(false) {}
     };
 
   private:
@@ -94,6 +144,9 @@ class OverlapPairs {
     /* Collision algorithm dispatch */
     AlgorithmDispatch& mAlgorithmDispatch;
 
+    /* Contacts which started or ended since the last frame */
+    DynamicArray<ContactEvent>& mContactEvents;
+
   public:
     /* -- Methods -- */
 
@@ -102,7 +155,8 @@ class OverlapPairs {
                  BodyComponents& bodyComponents,
                  ColliderComponents& colliderComponents,
                  Set<Pair<Entity, Entity>>& incompatibleCollisionPairs,
-                 AlgorithmDispatch& algorithmDispatch);
+                 AlgorithmDispatch& algorithmDispatch,
+                 DynamicArray<ContactEvent>& contactEvents);
 
     /* Destructor */
     ~OverlapPairs();
@@ -35,7 +35,24 @@ class PolygonShape : public Shape {
     /* Number of vertices */
     uint32 mNumVertices;
 
+    /* Vertices and normals laid out per component for the separating axis kernels */
+    /* Lanes past the number of vertices repeat the first vertex and normal so that they never change a minimum or a maximum */
+
+    /* x components of the vertices */
+    float mVerticesX[MAX_POLYGON_VERTICES];
+
+    /* y components of the vertices */
+    float mVerticesY[MAX_POLYGON_VERTICES];
+
+    /* x components of the normals */
+    float mNormalsX[MAX_POLYGON_VERTICES];
+
+    /* y components of the normals */
+    float mNormalsY[MAX_POLYGON_VERTICES];
+
     /* -- Methods -- */
+
+    /* Constructor */
     PolygonShape(MemoryHandler& memoryHandler);
 
     /* Constructor */
@@ -50,6 +67,9 @@ class PolygonShape : public Shape {
     /* Compute geometric properties of the shape */
     void computeGeometricProperties();
 
+    /* Copy the vertices and normals into their padded per component layout */
+    void packVertices();
+
   public:
     /* -- Methods -- */
 
@@ -3,11 +3,18 @@
 
 #include <physics/collision/algorithms/CollisionAlgorithm.h>
 #include <physics/collision/CircleShape.h>
+#include <physics/mathematics/SIMD.h>
 
 namespace physics {
 
 class CircleVCircleAlgorithm : public CollisionAlgorithm {
 
+  private:
+    /* -- Methods -- */
+
+    /* Populate the manifold of a colliding entry of a narrow phase batch */
+    void populateManifold(NarrowPhase::NarrowPhaseBatch& batch, uint32 entryIndex);
+
   public:
     /* -- Methods -- */
 
@@ -23,8 +30,11 @@ class CircleVCircleAlgorithm : public CollisionAlgorithm {
     /* Deleted assignment operator */
     CircleVCircleAlgorithm& operator=(const CircleVCircleAlgorithm& algorithm) = delete;
 
-    /* Execute the collision algorithm */
-    virtual void execute(NarrowPhase& narrowPhase, uint32 entryIndex, LocalManifoldInfo& manifold) override;
+    /* Execute the collision algorithm on a single entry of a narrow phase batch */
+    void execute(NarrowPhase::NarrowPhaseBatch& batch, uint32 entryIndex);
+
+    /* Execute the collision algorithm on the entries [begin, end) of a narrow phase batch, testing SIMD_WIDTH pairs at a time */
+    virtual void executeBatch(NarrowPhase::NarrowPhaseBatch& batch, uint32 begin, uint32 end) override;
 };
 
 }
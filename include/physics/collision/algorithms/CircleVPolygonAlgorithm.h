@@ -24,8 +24,11 @@ class CircleVPolygonAlgorithm : public CollisionAlgorithm {
     /* Deleted assignment operator */
     CircleVPolygonAlgorithm& operator=(const CircleVPolygonAlgorithm& algorithm) = delete;
 
-    /* Execute the collision algorithm */
-    virtual void execute(NarrowPhase& narrowPhase, uint32 entryIndex, LocalManifoldInfo& manifold) override;
+    /* Execute the collision algorithm on a single entry of a narrow phase batch */
+    void execute(NarrowPhase::NarrowPhaseBatch& batch, uint32 entryIndex);
+
+    /* Execute the collision algorithm on the entries [begin, end) of a narrow phase batch */
+    virtual void executeBatch(NarrowPhase::NarrowPhaseBatch& batch, uint32 begin, uint32 end) override;
 };
 
 }
@@ -28,8 +28,8 @@ class CollisionAlgorithm {
     /* Deleted assignment operator */
     CollisionAlgorithm& operator=(const CollisionAlgorithm& algorithm) = delete;
 
-    /* Execute the collision algorithm */
-    virtual void execute(NarrowPhase& narrowPhase, uint32 entryIndex, LocalManifoldInfo& manifold)=0;
+    /* Execute the collision algorithm on the entries [begin, end) of a narrow phase batch, disjoint ranges of the same batch may be executed from several threads at once */
+    virtual void executeBatch(NarrowPhase::NarrowPhaseBatch& batch, uint32 begin, uint32 end)=0;
 };
 
 }
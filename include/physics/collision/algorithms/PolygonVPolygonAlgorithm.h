@@ -3,6 +3,7 @@
 
 #include <physics/collision/algorithms/CollisionAlgorithm.h>
 #include <physics/collision/PolygonShape.h>
+#include <physics/mathematics/SIMD.h>
 
 namespace physics {
 
@@ -15,6 +16,9 @@ class PolygonVPolygonAlgorithm : public CollisionAlgorithm {
   
     /* -- Methods -- */
 
+    /* Get the separation between the two polygons along a single edge normal of the first polygon */
+    float getEdgeSeparation(const PolygonShape* firstShape, const PolygonShape* secondShape, const Transform& firstTransform, const Transform& secondTransform, uint32 edgeIndex);
+
     /* Get the maximum separation between the two polygons using the edge normals of the first polygon */
     float getMaxSeparation(const PolygonShape* firstShape, const PolygonShape* secondShape, const Transform& firstTransform, const Transform& secondTransform, uint32* edgeIndex);
 
@@ -39,8 +43,11 @@ class PolygonVPolygonAlgorithm : public CollisionAlgorithm {
     /* Deleted assignment operator */
     PolygonVPolygonAlgorithm& operator=(const PolygonVPolygonAlgorithm& algorithm) = delete;
 
-    /* Execute the collision algorithm */
-    virtual void execute(NarrowPhase& narrowPhase, uint32 entryIndex, LocalManifoldInfo& manifold) override;
+    /* Execute the collision algorithm on a single entry of a narrow phase batch */
+    void execute(NarrowPhase::NarrowPhaseBatch& batch, uint32 entryIndex);
+
+    /* Execute the collision algorithm on the entries [begin, end) of a narrow phase batch */
+    virtual void executeBatch(NarrowPhase::NarrowPhaseBatch& batch, uint32 begin, uint32 end) override;
 };
 
 }
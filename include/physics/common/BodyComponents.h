@@ -123,6 +123,12 @@ class BodyComponents : public Components {
     /* Array of indices of contact pairs which the body is part of */
     DynamicArray<uint32>* mContactPairs;
 
+    /* Number of sleeping bodies */
+    uint32 mNumSleepingBodies;
+
+    /* Number of static bodies */
+    uint32 mNumStaticBodies;
+
     /* -- Methods -- */
 
     /* Allocate memory for components */
@@ -173,6 +179,12 @@ class BodyComponents : public Components {
     /* Set sleep status */
     void setIsSleeping(Entity entity, bool isSleeping);
 
+    /* Get the number of sleeping bodies */
+    uint32 getNumSleepingBodies() const;
+
+    /* Get the number of static bodies */
+    uint32 getNumStaticBodies() const;
+
     /* Get sleep time */
     float getSleepTime(Entity entity) const;
 
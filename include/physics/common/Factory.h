@@ -8,7 +8,12 @@
 #include <physics/collision/CircleShape.h>
 #include <physics/common/Logger.h>
 
-#define LOG(message) if (physics::Factory::getLogger() != nullptr) Factory::getLogger()->log(message);
+/* Log call sites only exist when logging is compiled in, and their message is only built when the logger accepts its severity and subsystem */
+#if defined(PHYSICS_LOGGING)
+#define LOG(level, category, message) do { physics::Logger* physicsLogger = physics::Factory::getLogger(); if(physicsLogger && physicsLogger->isEnabled(level, category)) { physicsLogger->log(level, category, message); } } while(false)
+#else
+#define LOG(level, category, message) do {} while(false)
+#endif
 
 namespace physics {
 
@@ -59,7 +64,7 @@ class Factory {
     /* -- Methods -- */
 
     /* Constructor */
-    Factory(MemoryHandler* primaryMemoryHandler = nullptr);
+    Factory(MemoryHandler* primaryMemoryHandler = nullptr, MemoryStrategy::HandlerType generalHandlerType = MemoryStrategy::HandlerType::FreeList);
 
     /* Destructor */
     ~Factory();
@@ -88,6 +93,12 @@ class Factory {
     /* Destroy circle shape */
     void destroyCircle(CircleShape* circle);
 
+    /* Release the object pool memory which holds no objects and return the number of bytes released */
+    size_t trimMemory();
+
+    /* Set the number of free object pool bytes above which the memory holding no objects is released automatically, zero to disable */
+    void setMemoryTrimThreshold(size_t trimThreshold);
+
     /* Get logger */
     static Logger* getLogger();
 
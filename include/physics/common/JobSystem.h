@@ -0,0 +1,132 @@
+#ifndef PHYSICS_JOB_SYSTEM_H
+#define PHYSICS_JOB_SYSTEM_H
+
+#include <physics/common/TaskScheduler.h>
+#include <physics/collections/DynamicArray.h>
+#include <physics/memory/MemoryHandler.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+namespace physics {
+
+class JobSystem : public TaskScheduler {
+
+  private:
+    /* -- Nested Classes -- */
+
+    /* Chunk of a parallel for loop */
+    struct Job {
+
+      public:
+        /* -- Attributes -- */
+
+        /* Task to execute */
+        const Task* task;
+
+        /* Beginning of the range */
+        uint32 begin;
+
+        /* End of the range */
+        uint32 end;
+
+        /* Number of unfinished jobs of the parallel for loop which owns this job */
+        std::atomic<uint32>* numPendingJobs;
+    };
+
+    /* Work queue owned by a single thread */
+    struct Worker {
+
+      public:
+        /* -- Attributes -- */
+
+        /* Mutex to guard the queue */
+        std::mutex mutex;
+
+        /* Queued jobs where the owner works from the back and thieves steal from the front */
+        DynamicArray<Job> jobs;
+
+        /* Index of the first job which has not been stolen */
+        uint32 head;
+
+        /* -- Methods -- */
+
+        /* Constructor */
+        Worker(MemoryHandler& memoryHandler) : jobs(memoryHandler), head(0) {}
+    };
+
+    /* -- Attributes -- */
+
+    /* Memory handler */
+    MemoryHandler& mMemoryHandler;
+
+    /* Number of worker threads */
+    uint32 mNumWorkerThreads;
+
+    /* Work queues, the first queue belongs to the external thread calling parallelFor while the others belong to the worker threads */
+    Worker* mWorkers;
+
+    /* Mutex held by the external thread which currently owns the first queue */
+    std::mutex mExternalThreadMutex;
+
+    /* Worker threads */
+    std::thread* mThreads;
+
+    /* Number of jobs that are queued but have not been picked up yet */
+    std::atomic<uint32> mNumQueuedJobs;
+
+    /* Number of jobs that were stolen from the queue of another thread */
+    std::atomic<uint32> mNumStolenJobs;
+
+    /* Stop the worker threads */
+    std::atomic<bool> mIsStopped;
+
+    /* Mutex used to put idle worker threads to sleep */
+    std::mutex mSleepMutex;
+
+    /* Condition used to wake up idle worker threads */
+    std::condition_variable mSleepCondition;
+
+    /* -- Methods -- */
+
+    /* Main loop of a worker thread */
+    void run(uint32 threadIndex);
+
+    /* Pop a job from the back of the queue of the given thread */
+    bool popJob(uint32 threadIndex, Job& job);
+
+    /* Steal a job from the front of the queue of any other thread */
+    bool stealJob(uint32 threadIndex, Job& job);
+
+    /* Find and execute a single job, return false if no job was found */
+    bool executeJob(uint32 threadIndex);
+
+    /* Split the range into chunks and help executing them from the queue of the given thread */
+    void distribute(uint32 count, uint32 grainSize, const Task& task, uint32 threadIndex);
+
+  public:
+    /* -- Methods -- */
+
+    /* Constructor */
+    JobSystem(MemoryHandler& memoryHandler, uint32 numWorkerThreads);
+
+    /* Destructor */
+    ~JobSystem() override;
+
+    /* Get the number of threads which may execute tasks including the calling thread */
+    uint32 getNumThreads() const override;
+
+    /* Get the number of jobs that were stolen from the queue of another thread */
+    uint32 getNumStolenJobs() const;
+
+    /*
+     * Split the range into chunks which are executed by the worker threads and the calling thread
+     * Worker threads may call this from within a task while threads outside of the job system take turns
+     */
+    void parallelFor(uint32 count, uint32 grainSize, const Task& task) override;
+};
+
+}
+
+#endif
@@ -1,77 +1,177 @@
 #ifndef PHYSICS_LOGGER_H
 #define PHYSICS_LOGGER_H
 
-#include <sstream>
-#include <iostream>
-#include <fstream>
+#include <physics/Configuration.h>
+#include <atomic>
+#include <condition_variable>
 #include <ctime>
-#include <iomanip>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
 
 namespace physics {
 
+/* Severity of a log message */
+enum class LogLevel {Debug, Info, Warning, Error};
+
+/* Subsystem which logged a message */
+enum class LogCategory {Common, Memory, Collision, Dynamics};
+
+/* Queues messages from any thread into a lock-free ring buffer which a background thread writes to a file kept open for the lifetime of the logger */
+/* Messages which do not fit into the ring buffer are dropped rather than blocking the logging thread */
 class Logger {
 
   private:
+    /* -- Constants -- */
+
+    /* Maximum number of characters of a message, longer messages are truncated */
+    static constexpr uint32 MAX_MESSAGE_LENGTH = 255;
+
+    /* -- Nested Classes -- */
+
+    /* Slot of the ring buffer */
+    struct Slot {
+
+      public:
+        /* -- Attributes -- */
+
+        /* Position of the message which may next be written into or read from the slot */
+        std::atomic<uint64> sequence;
+
+        /* Time at which the message was logged */
+        std::time_t time;
+
+        /* Severity */
+        LogLevel level;
+
+        /* Subsystem */
+        LogCategory category;
+
+        /* Null terminated message */
+        char message[MAX_MESSAGE_LENGTH + 1];
+    };
+
     /* -- Attributes -- */
 
-    /* Output destination file */
-    std::string file;
+    /* Output destination file, standard output if empty */
+    std::string mFile;
+
+    /* Output destination stream */
+    std::ofstream mStream;
+
+    /* Ring buffer of messages */
+    Slot* mSlots;
+
+    /* Capacity of the ring buffer, a power of two */
+    uint32 mCapacity;
+
+    /* Position at which the next message is queued */
+    std::atomic<uint64> mEnqueuePosition;
+
+    /* Position of the next message to be written, every message before it has been written */
+    std::atomic<uint64> mDequeuePosition;
+
+    /* Number of messages dropped because the ring buffer was full */
+    std::atomic<uint64> mNumDroppedMessages;
+
+    /* Lowest severity of the messages which are logged */
+    std::atomic<int> mLevel;
+
+    /* Bitmask of the subsystems whose messages are logged */
+    std::atomic<uint32> mCategories;
+
+    /* Writer thread keeps running */
+    std::atomic<bool> mIsRunning;
+
+    /* Writer thread is about to wait or waiting for messages, so logging threads have to wake it up */
+    std::atomic<bool> mIsWriterWaiting;
+
+    /* Mutex guarding the waits of the writer thread and of the flushing threads */
+    std::mutex mMutex;
+
+    /* Wakes the writer thread up */
+    std::condition_variable mWriterCondition;
+
+    /* Wakes the flushing threads up once messages have been written */
+    std::condition_variable mFlushCondition;
+
+    /* Background thread writing the messages */
+    std::thread mWriter;
 
     /* -- Methods -- */
 
-    /* Retrieve the current timestamp */
-    std::string getTime() const;
+    /* Retrieve a timestamp */
+    static std::string getTime(std::time_t time);
 
-    /* Retrieve a formatted log message */
-    std::string getFormattedMessage(const std::string& message) const;
+    /* Retrieve the name of a severity */
+    static const char* getLevelName(LogLevel level);
+
+    /* Retrieve the name of a subsystem */
+    static const char* getCategoryName(LogCategory category);
+
+    /* Return whether a message is ready to be written */
+    bool hasQueuedMessages() const;
+
+    /* Write the queued messages until the ring buffer is empty and return the number of messages written */
+    uint64 writeMessages();
+
+    /* Run the writer thread */
+    void run();
 
   public:
     /* -- Methods -- */
 
     /* Constructor */
-    Logger(const std::string& file = "");
+    Logger(const std::string& file = "", uint32 capacity = 4096, LogLevel level = LogLevel::Info);
 
     /* Destructor */
-    ~Logger() = default;
+    ~Logger();
 
-    /* Log message to destination file */
-    void log(const std::string& message);
-};
+    /* Deleted copy constructor */
+    Logger(const Logger& logger) = delete;
 
-inline Logger::Logger(const std::string& file) : file(file) {}
+    /* Deleted assignment operator */
+    Logger& operator=(const Logger& logger) = delete;
 
-/* Retrieve the current timestamp */
-inline std::string Logger::getTime() const {
-  std::time_t now = std::time(nullptr);
-  std::tm timeInfo;
+    /* Query whether messages of a severity and subsystem are logged */
+    bool isEnabled(LogLevel level, LogCategory category) const;
 
-  if(localtime_s(&timeInfo, &now) != 0) {
-    return "ERR";
-  }
+    /* Set the lowest severity of the messages which are logged */
+    void setLevel(LogLevel level);
 
-  std::stringstream ss;
-  ss << std::put_time(&timeInfo, "%Y-%m-%d %H:%M:%S");;
-  return ss.str();
-}
+    /* Enable/Disable logging the messages of a subsystem */
+    void setIsCategoryEnabled(LogCategory category, bool isEnabled);
+
+    /* Queue a message to be written */
+    void log(LogLevel level, LogCategory category, const std::string& message);
+
+    /* Queue an informational message to be written */
+    void log(const std::string& message);
 
-/* Retrieve a formatted log message */
-inline std::string Logger::getFormattedMessage(const std::string& message) const {
-  return "[" + getTime() + "]" + " " +  message;
+    /* Block until every message queued before the call has been written */
+    void flush();
+
+    /* Get the number of messages dropped because the ring buffer was full */
+    uint64 getNumDroppedMessages() const;
+};
+
+/* Query whether messages of a severity and subsystem are logged */
+inline bool Logger::isEnabled(LogLevel level, LogCategory category) const {
+  return static_cast<int>(level) >= mLevel.load(std::memory_order_relaxed) &&
+         (mCategories.load(std::memory_order_relaxed) & (1u << static_cast<uint32>(category)));
 }
 
-/* Log message to destination file */
+/* Queue an informational message to be written */
 inline void Logger::log(const std::string& message) {
-  std::string formattedMessage = getFormattedMessage(message);
-
-  if(!file.empty()) {
-    std::ofstream logStream(file, std::ios::app);
-    logStream << formattedMessage << std::endl;
-  }
-  else {
-    std::cout << formattedMessage << std::endl;
-  }
+  log(LogLevel::Info, LogCategory::Common, message);
+}
+
+/* Get the number of messages dropped because the ring buffer was full */
+inline uint64 Logger::getNumDroppedMessages() const {
+  return mNumDroppedMessages.load(std::memory_order_relaxed);
 }
 
 }
 
-#endif
\ No newline at end of file
+#endif
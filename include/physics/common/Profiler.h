@@ -0,0 +1,198 @@
+#ifndef PHYSICS_PROFILER_H
+#define PHYSICS_PROFILER_H
+
+#include <physics/Configuration.h>
+#include <physics/collections/DynamicArray.h>
+#include <physics/memory/MemoryHandler.h>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+
+/* Profile scopes only exist when the profiler is compiled in */
+#define PHYSICS_PROFILE_CONCAT_IMPL(first, second) first##second
+#define PHYSICS_PROFILE_CONCAT(first, second) PHYSICS_PROFILE_CONCAT_IMPL(first, second)
+
+#if defined(PHYSICS_PROFILING)
+#define PROFILE_SCOPE(profiler, name) physics::ProfileScope PHYSICS_PROFILE_CONCAT(profileScope, __LINE__)(profiler, name)
+#else
+#define PROFILE_SCOPE(profiler, name)
+#endif
+
+namespace physics {
+
+/* Records timed scopes into a ring buffer which can be exported as a Chrome trace or read back per frame */
+/* Scopes may be recorded from several threads at once while reading the events back must happen in between steps */
+class Profiler {
+
+  public:
+    /* -- Nested Classes -- */
+
+    /* Timed scope */
+    struct Event {
+
+      public:
+        /* -- Attributes -- */
+
+        /* Name of the scope, which must outlive the profiler */
+        const char* name;
+
+        /* Start time in nanoseconds since the creation of the profiler */
+        uint64 start;
+
+        /* Duration in nanoseconds */
+        uint64 duration;
+
+        /* Frame during which the scope was recorded */
+        uint32 frame;
+
+        /* Index of the thread which recorded the scope */
+        uint32 threadIndex;
+    };
+
+  private:
+    /* -- Attributes -- */
+
+    /* Memory handler */
+    MemoryHandler& mMemoryHandler;
+
+    /* Ring buffer of events */
+    Event* mEvents;
+
+    /* Capacity of the ring buffer */
+    uint32 mCapacity;
+
+    /* Number of events recorded since the last clear, the oldest ones being overwritten */
+    std::atomic<uint64> mNumRecordedEvents;
+
+    /* Scopes are recorded */
+    std::atomic<bool> mIsEnabled;
+
+    /* Current frame */
+    std::atomic<uint32> mFrame;
+
+    /* Creation time of the profiler */
+    std::chrono::steady_clock::time_point mEpoch;
+
+  public:
+    /* -- Methods -- */
+
+    /* Constructor */
+    Profiler(MemoryHandler& memoryHandler, uint32 capacity, bool isEnabled);
+
+    /* Destructor */
+    ~Profiler();
+
+    /* Deleted copy constructor */
+    Profiler(const Profiler& profiler) = delete;
+
+    /* Deleted assignment operator */
+    Profiler& operator=(const Profiler& profiler) = delete;
+
+    /* Query whether scopes are recorded */
+    bool isEnabled() const;
+
+    /* Enable/Disable recording scopes, the ring buffer being allocated the first time it is enabled */
+    void setIsEnabled(bool isEnabled);
+
+    /* Get the time in nanoseconds since the creation of the profiler */
+    uint64 getTime() const;
+
+    /* Record a timed scope */
+    void record(const char* name, uint64 start, uint64 end, uint32 threadIndex);
+
+    /* Start a new frame */
+    void beginFrame();
+
+    /* Get the current frame */
+    uint32 getFrame() const;
+
+    /* Get the number of events held by the ring buffer */
+    uint32 getNumEvents() const;
+
+    /* Get an event held by the ring buffer, the oldest one first */
+    const Event& getEvent(uint32 index) const;
+
+    /* Get the events of a frame which are still held by the ring buffer, in the order they ended */
+    void getFrameEvents(uint32 frame, DynamicArray<Event>& events) const;
+
+    /* Write the events held by the ring buffer as Chrome trace JSON */
+    void exportChromeTrace(std::ostream& stream) const;
+
+    /* Write the events held by the ring buffer as Chrome trace JSON into a file */
+    bool exportChromeTrace(const std::string& file) const;
+
+    /* Discard the recorded events */
+    void clear();
+};
+
+/* Records the duration of a scope into a profiler */
+class ProfileScope {
+
+  private:
+    /* -- Attributes -- */
+
+    /* Profiler */
+    Profiler& mProfiler;
+
+    /* Name of the scope */
+    const char* mName;
+
+    /* Index of the recording thread */
+    uint32 mThreadIndex;
+
+    /* Start time, only valid if the profiler was enabled when entering the scope */
+    uint64 mStart;
+
+    /* Profiler was enabled when entering the scope */
+    bool mIsRecording;
+
+  public:
+    /* -- Methods -- */
+
+    /* Constructor */
+    ProfileScope(Profiler& profiler, const char* name, uint32 threadIndex = 0);
+
+    /* Destructor */
+    ~ProfileScope();
+
+    /* Deleted copy constructor */
+    ProfileScope(const ProfileScope& scope) = delete;
+
+    /* Deleted assignment operator */
+    ProfileScope& operator=(const ProfileScope& scope) = delete;
+};
+
+/* Query whether scopes are recorded */
+inline bool Profiler::isEnabled() const {
+  return mIsEnabled.load(std::memory_order_relaxed);
+}
+
+/* Get the time in nanoseconds since the creation of the profiler */
+inline uint64 Profiler::getTime() const {
+  return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mEpoch).count());
+}
+
+/* Get the current frame */
+inline uint32 Profiler::getFrame() const {
+  return mFrame.load(std::memory_order_relaxed);
+}
+
+/* Constructor */
+inline ProfileScope::ProfileScope(Profiler& profiler, const char* name, uint32 threadIndex) : mProfiler(profiler), mName(name), mThreadIndex(threadIndex), mStart(0), mIsRecording(profiler.isEnabled()) {
+  /* Switched off profilers do not even read the clock */
+  if(mIsRecording) {
+    mStart = mProfiler.getTime();
+  }
+}
+
+/* Destructor */
+inline ProfileScope::~ProfileScope() {
+  if(mIsRecording) {
+    mProfiler.record(mName, mStart, mProfiler.getTime(), mThreadIndex);
+  }
+}
+
+}
+
+#endif
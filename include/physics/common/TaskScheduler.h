@@ -0,0 +1,102 @@
+#ifndef PHYSICS_TASK_SCHEDULER_H
+#define PHYSICS_TASK_SCHEDULER_H
+
+#include <physics/Configuration.h>
+#include <functional>
+#include <cassert>
+
+namespace physics {
+
+/* Results of a chunk which were appended to the per-thread results of the thread executing it */
+struct ChunkRange {
+
+  public:
+    /* -- Attributes -- */
+
+    /* Index of the thread which executed the chunk */
+    uint32 threadIndex;
+
+    /* Index of the first result of the chunk in the results of its thread */
+    uint32 begin;
+
+    /* Index past the last result of the chunk in the results of its thread */
+    uint32 end;
+};
+
+class TaskScheduler {
+
+  public:
+    /* -- Nested Classes -- */
+
+    /* Task operating on the range [begin, end) and executed by the thread with the given index */
+    using Task = std::function<void(uint32 begin, uint32 end, uint32 threadIndex)>;
+
+    /* -- Methods -- */
+
+    /* Constructor */
+    TaskScheduler() = default;
+
+    /* Destructor */
+    virtual ~TaskScheduler() = default;
+
+    /* Deleted copy constructor */
+    TaskScheduler(const TaskScheduler& taskScheduler) = delete;
+
+    /* Deleted assignment operator */
+    TaskScheduler& operator=(const TaskScheduler& taskScheduler) = delete;
+
+    /* Get the number of threads which may execute tasks, thread indices are in the range [0, getNumThreads()) */
+    virtual uint32 getNumThreads() const = 0;
+
+    /*
+     * Split the range [0, count) into chunks of at most grainSize elements and execute the task on every chunk
+     * Chunks always begin at a multiple of grainSize regardless of the scheduler so that per-chunk results can be merged in a deterministic order
+     * Returns once every chunk has been executed
+     */
+    virtual void parallelFor(uint32 count, uint32 grainSize, const Task& task) = 0;
+
+    /* Get the number of chunks that a range of count elements is split into */
+    static uint32 getNumChunks(uint32 count, uint32 grainSize);
+};
+
+class SerialTaskScheduler : public TaskScheduler {
+
+  public:
+    /* -- Methods -- */
+
+    /* Constructor */
+    SerialTaskScheduler() = default;
+
+    /* Destructor */
+    ~SerialTaskScheduler() override = default;
+
+    /* Get the number of threads which may execute tasks */
+    uint32 getNumThreads() const override;
+
+    /* Execute the chunks of the range one after another on the calling thread */
+    void parallelFor(uint32 count, uint32 grainSize, const Task& task) override;
+};
+
+/* Get the number of chunks that a range of count elements is split into */
+inline uint32 TaskScheduler::getNumChunks(uint32 count, uint32 grainSize) {
+  assert(grainSize > 0);
+  return (count + grainSize - 1) / grainSize;
+}
+
+/* Get the number of threads which may execute tasks */
+inline uint32 SerialTaskScheduler::getNumThreads() const {
+  return 1;
+}
+
+/* Execute the chunks of the range one after another on the calling thread */
+inline void SerialTaskScheduler::parallelFor(uint32 count, uint32 grainSize, const Task& task) {
+  assert(grainSize > 0);
+
+  for(uint32 begin = 0; begin < count; begin += grainSize) {
+    task(begin, count - begin > grainSize ? begin + grainSize : count, 0);
+  }
+}
+
+}
+
+#endif
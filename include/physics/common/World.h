@@ -13,8 +13,12 @@
 #include <physics/common/TransformComponents.h>
 #include <physics/collision/CollisionDetection.h>
 #include <physics/dynamics/Islands.h>
+#include <physics/dynamics/PersistentIslands.h>
 #include <physics/dynamics/ContactSolver.h>
 #include <physics/dynamics/Dynamics.h>
+#include <physics/common/TaskScheduler.h>
+#include <physics/common/JobSystem.h>
+#include <physics/common/Profiler.h>
 
 namespace physics {
 
@@ -23,6 +27,9 @@ class Body;
 class Factory;
 class CollisionDetection;
 
+/* Methods of generating the islands of a frame */
+enum class IslandGeneration {DepthFirstSearch, Persistent, Parallel};
+
 class World {
 
   public:
@@ -64,6 +71,39 @@ class World {
         /* Number of iterations to perform for position constraint solving */
         uint16 defaultPositionConstraintSolverIterations;
 
+        /* Number of worker threads spawned by the built-in job system, zero runs the simulation on the calling thread */
+        uint32 numWorkerThreads;
+
+        /* User provided task scheduler which takes precedence over the built-in job system */
+        TaskScheduler* taskScheduler;
+
+        /* Enable/Disable partitioning the contact constraints of large islands into colors which are solved in parallel */
+        bool isGraphColoringEnabled;
+
+        /* Minimum number of manifolds in an island for its contact constraints to be colored */
+        uint32 graphColoringManifoldThreshold;
+
+        /* Enable/Disable solving the contact constraints of colored islands SIMD_WIDTH at a time with vector instructions */
+        bool isSimdSolverEnabled;
+
+        /* Method of generating the islands of a frame */
+        IslandGeneration islandGeneration;
+
+        /* Enable/Disable reusing the last manifold of an overlap pair whose relative transform barely changed instead of executing the narrow phase */
+        bool isManifoldReuseEnabled;
+
+        /* Distance the shapes of an overlap pair may move relative to each other before their manifold is computed again */
+        float manifoldReuseLinearTolerance;
+
+        /* Angle the shapes of an overlap pair may rotate relative to each other before their manifold is computed again */
+        float manifoldReuseAngularTolerance;
+
+        /* Enable/Disable recording the duration of the stages of a step, provided the profiler is compiled in */
+        bool isProfilingEnabled;
+
+        /* Number of events held by the ring buffer of the profiler */
+        uint32 profilerCapacity;
+
         /* -- Methods -- */
 
         /* Constructor */
@@ -79,13 +119,125 @@ class World {
           defaultSleepTime = 1.0f;
           defaultVelocityConstraintSolverIterations = 10;
           defaultPositionConstraintSolverIterations = 8;
+          numWorkerThreads = 0;
+          taskScheduler = nullptr;
+          isGraphColoringEnabled = false;
+          graphColoringManifoldThreshold = 256;
+          isSimdSolverEnabled = false;
+          islandGeneration = IslandGeneration::DepthFirstSearch;
+          isManifoldReuseEnabled = false;
+          manifoldReuseLinearTolerance = 0.1f * LINEAR_SLOP;
+          manifoldReuseAngularTolerance = 0.1f * ANGULAR_SLOP;
+          isProfilingEnabled = false;
+          profilerCapacity = 8192;
         }
 
         /* Destructor */
         ~Settings() = default;
     };
 
+    /* Counters of the work done during the last step, filled as each stage completes */
+    struct StepStatistics {
+
+      public:
+        /* -- Attributes -- */
+
+        /* Number of moved shapes tested against the broad phase */
+        uint32 numMovedShapes;
+
+        /* Number of overlapping nodes found by the broad phase */
+        uint32 numOverlapNodes;
+
+        /* Number of live overlap pairs once the broad phase is done */
+        uint32 numOverlapPairs;
+
+        /* Number of narrow phase entries for the circle versus circle algorithm */
+        uint32 numCircleVCircleEntries;
+
+        /* Number of narrow phase entries for the circle versus polygon algorithm */
+        uint32 numCircleVPolygonEntries;
+
+        /* Number of narrow phase entries for the polygon versus polygon algorithm */
+        uint32 numPolygonVPolygonEntries;
+
+        /* Number of narrow phase entries which reused their last manifold */
+        uint32 numReusedEntries;
+
+        /* Number of contact pairs created by the narrow phase */
+        uint32 numContactPairs;
+
+        /* Number of manifolds handed to the contact solver */
+        uint32 numManifolds;
+
+        /* Number of islands */
+        uint32 numIslands;
+
+        /* Number of bodies in the largest island */
+        uint32 maxNumIslandBodies;
+
+        /* Number of bodies in the constrained arrays of the solver, sleeping bodies are left out */
+        uint32 numSolverBodies;
+
+        /* Number of non-static bodies which are not sleeping at the end of the step */
+        uint32 numAwakeBodies;
+
+        /* Number of sleeping bodies at the end of the step */
+        uint32 numSleepingBodies;
+
+        /* Number of batches of islands handed to the contact solver */
+        uint32 numIslandBatches;
+
+        /* Number of islands whose constraints are partitioned into colors */
+        uint32 numColoredIslands;
+
+        /* Number of colors summed over the colored islands */
+        uint32 numColors;
+
+        /* Number of wide constraints solved SIMD_WIDTH manifolds at a time */
+        uint32 numWideConstraints;
+
+        /* Number of velocity solver iterations run by each batch of islands and each colored island */
+        uint32 numVelocitySolverIterations;
+
+        /* Number of position solver iterations run by each batch of islands and each colored island */
+        uint32 numPositionSolverIterations;
+
+        /* -- Methods -- */
+
+        /* Constructor */
+        StepStatistics() {
+          numMovedShapes = 0;
+          numOverlapNodes = 0;
+          numOverlapPairs = 0;
+          numCircleVCircleEntries = 0;
+          numCircleVPolygonEntries = 0;
+          numPolygonVPolygonEntries = 0;
+          numReusedEntries = 0;
+          numContactPairs = 0;
+          numManifolds = 0;
+          numIslands = 0;
+          maxNumIslandBodies = 0;
+          numSolverBodies = 0;
+          numAwakeBodies = 0;
+          numSleepingBodies = 0;
+          numIslandBatches = 0;
+          numColoredIslands = 0;
+          numColors = 0;
+          numWideConstraints = 0;
+          numVelocitySolverIterations = 0;
+          numPositionSolverIterations = 0;
+        }
+    };
+
   protected:
+    /* -- Constants -- */
+
+    /* Invalid island index */
+    static constexpr uint32 INVALID_ISLAND_INDEX = PersistentIslands::INVALID_INDEX;
+
+    /* Invalid body index */
+    static constexpr uint32 INVALID_BODY_INDEX = 0xFFFFFFFF;
+
     /* -- Attributes -- */
 
     /* Memory strategy */
@@ -94,6 +246,21 @@ class World {
     /* World settings */
     Settings mSettings;
 
+    /* Fallback task scheduler running every task on the calling thread */
+    SerialTaskScheduler mSerialTaskScheduler;
+
+    /* Built-in job system owned by the world */
+    JobSystem* mJobSystem;
+
+    /* Task scheduler used to distribute the work of a step */
+    TaskScheduler* mTaskScheduler;
+
+    /* Profiler recording the duration of the stages of a step */
+    Profiler mProfiler;
+
+    /* Counters of the work done during the last step */
+    StepStatistics mStepStatistics;
+
     /* Entity handler */
     EntityHandler mEntityHandler;
 
@@ -118,6 +285,9 @@ class World {
     /* Contact pairs ordered based on the islands of the current frame */
     DynamicArray<uint32> mIslandOrderedContactPairs;
 
+    /* Islands kept across frames when they are generated persistently */
+    PersistentIslands mPersistentIslands;
+
     /* Contact solver */
     ContactSolver mContactSolver;
 
@@ -162,12 +332,39 @@ class World {
     /* Generate the islands of the current frame */
     void generateIslands();
 
+    /* Update the persistent islands with the contacts which started and ended since the last frame and generate the islands of the current frame */
+    void generatePersistentIslands();
+
+    /* Query whether a contact links the persistent islands of its bodies */
+    bool isPersistentIslandContact(Entity firstBodyEntity, Entity secondBodyEntity) const;
+
+    /* Put the persistent island of a body to sleep or wake it up as a whole */
+    void setIsPersistentIslandSleeping(Entity bodyEntity, bool isSleeping);
+
+    /* Generate the islands of the current frame by merging the bodies of the contact pairs from several threads */
+    void generateParallelIslands();
+
+    /* Wake up the sleeping bodies touched by the contact pairs of the current frame */
+    void wakeContactBodies();
+
+    /* Bucket the contact pairs of the current frame by island while keeping their relative order */
+    void orderContactPairs(const DynamicArray<uint32>& contactPairIslands, uint32 numIslands, DynamicArray<uint32>& islandOffsets);
+
+    /* Dissolve the persistent island of a body whose contacts no longer link it the same way */
+    void resetPersistentIsland(Entity entity);
+
     /* Solve the physics simulation */
     void solve(TimeStep timeStep);
 
+    /* Update the sleep time of a body and get it, static bodies never keep an island awake */
+    float updateSleepTime(Entity entity, TimeStep timeStep);
+
     /* Set bodies to sleep as appropriate */
     void sleepBodies(TimeStep timeStep);
 
+    /* Set the persistent islands to sleep as appropriate */
+    void sleepPersistentIslands(TimeStep timeStep);
+
   public:
     /* -- Methods -- */
 
@@ -186,6 +383,19 @@ class World {
     /* Destroy a body */
     void destroyBody(Body* body);
 
+    /* Get the task scheduler used to distribute the work of a step */
+    TaskScheduler& getTaskScheduler();
+
+    /* Get the profiler recording the duration of the stages of a step */
+    Profiler& getProfiler();
+
+    /* Get the counters of the work done during the last step */
+    const StepStatistics& getStepStatistics() const;
+
+    /* Get the live statistics of a memory handler of the memory strategy, which is shared by the worlds of a factory */
+    /* The Linear handlers may only be queried in between steps */
+    MemoryStatistics getMemoryStatistics(MemoryStrategy::HandlerType handlerType);
+
     /* -- Friends -- */
     
     friend class Collider;
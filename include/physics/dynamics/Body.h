@@ -34,6 +34,9 @@ class Body {
     /* Remove all of the overlapping pairs that the body is involved in */
     void resetOverlapPairs();
 
+    /* Move the collision shapes of the body into the broad phase tree matching its type */
+    void resetBroadPhaseTree();
+
     /* Compute the center of mass using the body's colliders */
     Vector2 computeMassProperties() const;
 
@@ -4,10 +4,12 @@
 #include <physics/Configuration.h>
 #include <physics/mathematics/Vector2.h>
 #include <physics/mathematics/Matrix22.h>
+#include <physics/mathematics/SIMD.h>
 #include <physics/collections/DynamicArray.h>
 #include <physics/dynamics/Material.h>
 #include <physics/collision/Contact.h>
 #include <physics/common/TimeStep.h>
+#include <physics/common/TaskScheduler.h>
 
 namespace physics {
 
@@ -72,10 +74,10 @@ class ContactSolver {
       /* K matrix */
       Matrix22 K;
 
-      /* First index */
+      /* Index of the first body in the body components */
       uint32 indexA;
 
-      /* Second index */
+      /* Index of the second body in the body components */
       uint32 indexB;
 
       /* First inverse mass */
@@ -115,10 +117,10 @@ class ContactSolver {
         /* Local point */
         Vector2 localPoint;
 
-        /* First index */
+        /* Index of the first body in the body components */
         uint32 indexA;
 
-        /* Second index */
+        /* Index of the second body in the body components */
         uint32 indexB;
 
         /* First inverse mass */
@@ -152,6 +154,145 @@ class ContactSolver {
         uint32 numPoints;
     };
 
+    /* Velocity constraints of up to SIMD_WIDTH manifolds that share no body that can move stored as structure of arrays */
+    struct WideVelocityConstraint {
+
+      public:
+        /* -- Nested Classes -- */
+
+        /* Wide velocity constraint point */
+        struct WideVelocityConstraintPoint {
+
+          public:
+            /* -- Attributes -- */
+
+            /* Vectors from first body center to contact point */
+            float rAX[SIMD_WIDTH];
+            float rAY[SIMD_WIDTH];
+
+            /* Vectors from second body center to contact point */
+            float rBX[SIMD_WIDTH];
+            float rBY[SIMD_WIDTH];
+
+            /* Normal masses */
+            float normalMass[SIMD_WIDTH];
+
+            /* Tangent masses */
+            float tangentMass[SIMD_WIDTH];
+
+            /* Normal impulses */
+            float normalImpulse[SIMD_WIDTH];
+
+            /* Tangent impulses */
+            float tangentImpulse[SIMD_WIDTH];
+
+            /* Velocity biases */
+            float velocityBias[SIMD_WIDTH];
+        };
+
+        /* -- Attributes -- */
+
+        /* Velocity constraint points, the second point of a lane with a single point has no mass and no impulse */
+        WideVelocityConstraintPoint points[MAX_MANIFOLD_POINTS];
+
+        /* Normals */
+        float normalX[SIMD_WIDTH];
+        float normalY[SIMD_WIDTH];
+
+        /* K matrices */
+        float K[2][2][SIMD_WIDTH];
+
+        /* Normal mass matrices */
+        float normalMass[2][2][SIMD_WIDTH];
+
+        /* First body indices */
+        uint32 indicesA[SIMD_WIDTH];
+
+        /* Second body indices */
+        uint32 indicesB[SIMD_WIDTH];
+
+        /* First inverse masses */
+        float inverseMassA[SIMD_WIDTH];
+
+        /* Second inverse masses */
+        float inverseMassB[SIMD_WIDTH];
+
+        /* First inverse inertias */
+        float inverseInertiaA[SIMD_WIDTH];
+
+        /* Second inverse inertias */
+        float inverseInertiaB[SIMD_WIDTH];
+
+        /* Frictions */
+        float friction[SIMD_WIDTH];
+
+        /* One for lanes which use the block solver and zero otherwise */
+        float isBlockSolved[SIMD_WIDTH];
+
+        /* Number of lanes holding a constraint */
+        uint32 numLanes;
+    };
+
+    /* Position constraints of up to SIMD_WIDTH manifolds that share no body that can move stored as structure of arrays */
+    struct WidePositionConstraint {
+
+      public:
+        /* -- Attributes -- */
+
+        /* Points */
+        float pointX[MAX_MANIFOLD_POINTS][SIMD_WIDTH];
+        float pointY[MAX_MANIFOLD_POINTS][SIMD_WIDTH];
+
+        /* Local normals */
+        float localNormalX[SIMD_WIDTH];
+        float localNormalY[SIMD_WIDTH];
+
+        /* Local points */
+        float localPointX[SIMD_WIDTH];
+        float localPointY[SIMD_WIDTH];
+
+        /* First local centers */
+        float localCenterAX[SIMD_WIDTH];
+        float localCenterAY[SIMD_WIDTH];
+
+        /* Second local centers */
+        float localCenterBX[SIMD_WIDTH];
+        float localCenterBY[SIMD_WIDTH];
+
+        /* First body indices */
+        uint32 indicesA[SIMD_WIDTH];
+
+        /* Second body indices */
+        uint32 indicesB[SIMD_WIDTH];
+
+        /* First inverse masses */
+        float inverseMassA[SIMD_WIDTH];
+
+        /* Second inverse masses */
+        float inverseMassB[SIMD_WIDTH];
+
+        /* First inverse inertias */
+        float inverseInertiaA[SIMD_WIDTH];
+
+        /* Second inverse inertias */
+        float inverseInertiaB[SIMD_WIDTH];
+
+        /* First radii */
+        float radiusA[SIMD_WIDTH];
+
+        /* Second radii */
+        float radiusB[SIMD_WIDTH];
+
+        /* Manifold types */
+        float type[SIMD_WIDTH];
+
+        /* Number of points */
+        float numPoints[SIMD_WIDTH];
+
+        /* Number of lanes holding a constraint */
+        uint32 numLanes;
+    };
+
     struct PositionSolverInfo {
       
       public:
@@ -242,6 +383,36 @@ class ContactSolver {
     /* Transform components */
     TransformComponents& mTransformComponents;
 
+    /* Task scheduler */
+    TaskScheduler& mTaskScheduler;
+
+    /* Range of islands [first, second) of each batch of islands solved by a single task */
+    DynamicArray<Pair<uint32, uint32>> mIslandBatches;
+
+    /* Islands whose constraints are partitioned into colors */
+    DynamicArray<uint32> mColoredIslands;
+
+    /* First color of each colored island followed by the total number of colors */
+    DynamicArray<uint32> mIslandColors;
+
+    /* First manifold of each color in the array of colored manifolds followed by the total number of colored manifolds */
+    DynamicArray<uint32> mColorOffsets;
+
+    /* Indices of the manifolds of the colored islands grouped by color */
+    DynamicArray<uint32> mColorManifolds;
+
+    /* First wide constraint of each color followed by the total number of wide constraints */
+    DynamicArray<uint32> mColorWideConstraints;
+
+    /* Wide velocity constraints of the colored islands */
+    WideVelocityConstraint* mWideVelocityConstraints;
+
+    /* Wide position constraints of the colored islands */
+    WidePositionConstraint* mWidePositionConstraints;
+
+    /* Number of wide constraints */
+    uint32 mNumWideConstraints;
+
     /* Velocity constraints */
     VelocityConstraint* mVelocityConstraints;
 
@@ -251,6 +422,15 @@ class ContactSolver {
     /* Restitution threshold */
     float& mRestitutionThreshold;
 
+    /* True if the constraints of large islands are partitioned into colors */
+    bool& mIsGraphColoringEnabled;
+
+    /* Minimum number of manifolds in an island for its constraints to be colored */
+    uint32& mGraphColoringManifoldThreshold;
+
+    /* True if the constraints of colored islands are solved SIMD_WIDTH at a time */
+    bool& mIsSimdSolverEnabled;
+
     /* -- Methods -- */
 
     /* Compute the collision restituion factor */
@@ -259,14 +439,71 @@ class ContactSolver {
     /* Compute the mixed friction coefficient */
     float computeMixedFriction(const Material& firstMaterial, const Material& secondMaterial) const;
 
-    /* Initialize contact solver for a given island */
-    void initializeIsland(uint32 islandIndex);
+    /* Resolve the body indices of the constraints in the range [begin, end) */
+    void resolveBodyIndices(uint32 begin, uint32 end);
+
+    /* Initialize the constraints in the range [begin, end) */
+    void initializeConstraints(uint32 begin, uint32 end);
     
-    /* Initialize velocity constraints */
-    void initializeVelocityConstraints();
+    /* Initialize the velocity constraints in the range [begin, end) */
+    void initializeVelocityConstraints(uint32 begin, uint32 end);
+
+    /* Warm start a single velocity constraint */
+    void warmStartConstraint(uint32 i);
+
+    /* Solve a single velocity constraint */
+    void solveVelocityConstraint(uint32 i);
+
+    /* Solve a single position constraint and return its minimum separation */
+    float solvePositionConstraint(uint32 i);
+
+    /* Store the impulses of the constraints in the range [begin, end) for warm starting in the next frame */
+    void storeImpulses(uint32 begin, uint32 end);
+
+    /* Get the range of manifolds [begin, end) of the given batch of islands */
+    void getIslandBatchManifolds(uint32 batchIndex, uint32& begin, uint32& end) const;
 
-    /* Warm start the solver */
-    void warmStart();
+    /* Partition the constraints of an island into colors where no two constraints of the same color share a body that can move */
+    void colorIsland(uint32 islandIndex, uint64* bodyColors);
+
+    /* Get the range [begin, end) of a color in the array of colored manifolds and the number of its manifolds solved by a single task */
+    void getColorManifolds(uint32 coloredIslandIndex, uint32 color, uint32& begin, uint32& end, uint32& grainSize) const;
+
+    /* Query whether the constraints of the given color are packed into wide constraints */
+    bool isColorWide(uint32 coloredIslandIndex, uint32 color) const;
+
+    /* Pack the constraints of the given wide constraint into lanes */
+    void packWideConstraint(uint32 color, uint32 wideIndex);
+
+    /* Copy the impulses of the given wide constraint back to the constraints of its lanes */
+    void unpackWideConstraint(uint32 color, uint32 wideIndex);
+
+    /* Load the velocities of the bodies with the given indices */
+    void loadVelocities(const uint32* indices, uint32 numLanes, SimdVector2& linearVelocity, SimdFloat& angularSpeed) const;
+
+    /* Store the velocities of the bodies with the given indices which can move */
+    void storeVelocities(const uint32* indices, const float* inverseMasses, const float* inverseInertias, uint32 numLanes, const SimdVector2& linearVelocity, const SimdFloat& angularSpeed);
+
+    /* Load the positions and angles of the bodies with the given indices */
+    void loadPositions(const uint32* indices, uint32 numLanes, SimdVector2& position, SimdFloat& angle) const;
+
+    /* Store the positions and angles of the bodies with the given indices which can move */
+    void storePositions(const uint32* indices, const float* inverseMasses, const float* inverseInertias, uint32 numLanes, const SimdVector2& position, const SimdFloat& angle);
+
+    /* Warm start a wide velocity constraint */
+    void warmStartWideConstraint(uint32 wideIndex);
+
+    /* Solve a wide velocity constraint */
+    void solveWideVelocityConstraint(uint32 wideIndex);
+
+    /* Solve a wide position constraint and return its minimum separation */
+    float solveWidePositionConstraint(uint32 wideIndex);
+
+    /* Solve the velocity constraints of a colored island where the constraints of each color are solved in parallel */
+    void solveColoredIslandVelocityConstraints(uint32 coloredIslandIndex, uint16 numIterations);
+
+    /* Solve the position constraints of a colored island where the constraints of each color are solved in parallel */
+    void solveColoredIslandPositionConstraints(uint32 coloredIslandIndex, uint16 numIterations);
 
   public:
 
@@ -279,7 +516,11 @@ class ContactSolver {
                   BodyComponents& bodyComponents,
                   ColliderComponents& colliderComponents,
                   TransformComponents& transformComponents,
-                  float& restitutionThreshold);
+                  TaskScheduler& taskScheduler,
+                  float& restitutionThreshold,
+                  bool& isGraphColoringEnabled,
+                  uint32& graphColoringManifoldThreshold,
+                  bool& isSimdSolverEnabled);
                   
     /* Destructor */
     ~ContactSolver() = default;
@@ -287,19 +528,50 @@ class ContactSolver {
     /* Initialize */
     void initialize(DynamicArray<LocalManifold>* manifolds, TimeStep timeStep);
 
-    /* Solve velocity constraints */
-    void solveVelocityConstraints();
+    /* Initialize, warm start and solve the velocity constraints of each batch of islands and each colored island in parallel, then store the impulses for warm starting */
+    /* Return the number of iterations run by each batch of islands and each colored island */
+    uint32 solveVelocityConstraints(uint16 numIterations);
+
+    /* Solve the position constraints of each batch of islands and each colored island in parallel */
+    /* Return the number of iterations run by each batch of islands and each colored island */
+    uint32 solvePositionConstraints(uint16 numIterations);
+
+    /* Get the number of batches of islands */
+    uint32 getNumIslandBatches() const;
 
-    /* Solve position constraints */
-    void solvePositionConstraints();
+    /* Get the number of colored islands */
+    uint32 getNumColoredIslands() const;
 
-    /* Store impulses for warm starting in the next frame */
-    void storeImpulses();
+    /* Get the number of colors summed over the colored islands */
+    uint32 getNumColors() const;
+
+    /* Get the number of wide constraints solved SIMD_WIDTH manifolds at a time */
+    uint32 getNumWideConstraints() const;
 
     /* Release allocated memory */
     void reset();
 };
 
+/* Get the number of batches of islands */
+inline uint32 ContactSolver::getNumIslandBatches() const {
+  return static_cast<uint32>(mIslandBatches.size());
+}
+
+/* Get the number of colored islands */
+inline uint32 ContactSolver::getNumColoredIslands() const {
+  return static_cast<uint32>(mColoredIslands.size());
+}
+
+/* Get the number of colors summed over the colored islands */
+inline uint32 ContactSolver::getNumColors() const {
+  return mIslandColors.empty() ? 0 : mIslandColors[mIslandColors.size() - 1];
+}
+
+/* Get the number of wide constraints solved SIMD_WIDTH manifolds at a time */
+inline uint32 ContactSolver::getNumWideConstraints() const {
+  return mNumWideConstraints;
+}
+
 }
 
 #endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <physics/common/BodyComponents.h>
 #include <physics/common/ColliderComponents.h>
 #include <physics/common/TransformComponents.h>
+#include <physics/common/TaskScheduler.h>
 
 namespace physics {
 
@@ -34,6 +35,9 @@ class Dynamics {
     /* Gravity */
     Vector2& mGravity;
 
+    /* Task scheduler */
+    TaskScheduler& mTaskScheduler;
+
   public:
     /* -- Methods -- */
     
@@ -43,7 +47,8 @@ class Dynamics {
              ColliderComponents& colliderComponents,
              TransformComponents& transformComponents,
              bool& isGravityEnabled,
-             Vector2& gravity);
+             Vector2& gravity,
+             TaskScheduler& taskScheduler);
 
     /* Destructor */
     ~Dynamics() = default;
@@ -67,6 +67,9 @@ class Islands {
     /* Get the number of islands */
     uint32 getNumIslands() const;
 
+    /* Get the maximum number of bodies in a particular island of the current frame */
+    uint32 getMaxNumBodies() const;
+
     /* Get the island index from the given manifold start index */
     uint32 getIslandIndex(uint32 manifoldStartIndex) const;
 
@@ -0,0 +1,226 @@
+#ifndef PHYSICS_PERSISTENT_ISLANDS_H
+#define PHYSICS_PERSISTENT_ISLANDS_H
+
+#include <physics/Configuration.h>
+#include <physics/collections/DynamicArray.h>
+#include <physics/common/Entity.h>
+#include <physics/memory/MemoryHandler.h>
+
+namespace physics {
+
+/* Islands which persist across frames as a disjoint set forest over the bodies of the world, indexed by body entity index */
+/* Contacts which start merge islands right away while contacts which end only mark their island, the island being split later on */
+/* The awake islands are kept in an array of their own so that a frame only visits islands which are simulated */
+class PersistentIslands {
+
+  private:
+    /* -- Attributes -- */
+
+    /* Entity of each body */
+    DynamicArray<Entity> mBodyEntities;
+
+    /* Parent of each body in the disjoint set forest, invalid if there is no body at the index */
+    DynamicArray<uint32> mParents;
+
+    /* Next body in the island of each body */
+    DynamicArray<uint32> mNextBodies;
+
+    /* First body in the island of each root body */
+    DynamicArray<uint32> mFirstBodies;
+
+    /* Last body in the island of each root body */
+    DynamicArray<uint32> mLastBodies;
+
+    /* Number of bodies in the island of each root body */
+    DynamicArray<uint32> mNumBodies;
+
+    /* Index in the awake islands of each root body, invalid if the island is sleeping */
+    DynamicArray<uint32> mAwakeIndices;
+
+    /* True if a body is static, static bodies stay in islands of their own which are never awake */
+    DynamicArray<bool> mIsStatic;
+
+    /* True if a contact of the island of a root body ended since the island was last split */
+    DynamicArray<bool> mIsSplitPending;
+
+    /* True if the contacts of a body have to be linked again since its island was dissolved */
+    DynamicArray<bool> mIsLinkPending;
+
+    /* Bodies whose contacts have to be linked again */
+    DynamicArray<uint32> mLinkPendingBodies;
+
+    /* Root body of each awake island */
+    DynamicArray<uint32> mAwakeIslands;
+
+    /* Root body of the island to split at the start of the next frame */
+    uint32 mSplitCandidate;
+
+    /* -- Methods -- */
+
+    /* Reset a body into an island of its own */
+    void resetBody(uint32 index);
+
+    /* Append the island of a root body to the awake islands */
+    void addAwakeIsland(uint32 root);
+
+    /* Remove the island of a root body from the awake islands */
+    void removeAwakeIsland(uint32 root);
+
+  public:
+    /* -- Constants -- */
+
+    /* Invalid body or island index */
+    static constexpr uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+    /* -- Methods -- */
+
+    /* Constructor */
+    PersistentIslands(MemoryHandler& memoryHandler);
+
+    /* Destructor */
+    ~PersistentIslands() = default;
+
+    /* Deleted copy constructor */
+    PersistentIslands(const PersistentIslands& islands) = delete;
+
+    /* Deleted assignment operator */
+    PersistentIslands& operator=(const PersistentIslands& islands) = delete;
+
+    /* Add a body into an awake island of its own */
+    void addBody(Entity bodyEntity);
+
+    /* Remove a body by dissolving its island */
+    void removeBody(Entity bodyEntity);
+
+    /* Query whether a body is part of the islands */
+    bool containsBody(Entity bodyEntity) const;
+
+    /* Query whether a body is static */
+    bool isStatic(uint32 index) const;
+
+    /* Set whether a body is static, which dissolves its island */
+    void setIsStatic(uint32 index, bool isStatic);
+
+    /* Get the root body of the island of a body */
+    uint32 findRoot(uint32 index);
+
+    /* Merge the islands of two bodies */
+    void merge(uint32 firstIndex, uint32 secondIndex);
+
+    /* Dissolve the island of a body into islands of their own whose contacts have to be linked again */
+    void dissolve(uint32 index);
+
+    /* Mark the island of a body as having lost a contact */
+    void markSplit(uint32 index);
+
+    /* Consider the island of a root body for the next split */
+    void considerSplit(uint32 root);
+
+    /* Split the island chosen during the last frame */
+    void split();
+
+    /* Query whether the contacts of a body have to be linked again */
+    bool isLinkPending(uint32 index) const;
+
+    /* Query whether any body has contacts which have to be linked again */
+    bool hasLinkPending() const;
+
+    /* Clear the bodies whose contacts have to be linked again */
+    void clearLinkPending();
+
+    /* Query whether the island of a root body is awake */
+    bool isAwake(uint32 root) const;
+
+    /* Set whether the island of a root body is awake */
+    void setIsAwake(uint32 root, bool isAwake);
+
+    /* Get the number of awake islands */
+    uint32 getNumAwakeIslands() const;
+
+    /* Get the root body of an awake island */
+    uint32 getAwakeIsland(uint32 awakeIndex) const;
+
+    /* Get the index in the awake islands of a root body */
+    uint32 getAwakeIndex(uint32 root) const;
+
+    /* Get the entity of a body */
+    Entity getBodyEntity(uint32 index) const;
+
+    /* Get the first body in the island of a root body */
+    uint32 getFirstBody(uint32 root) const;
+
+    /* Get the next body in the island of a body */
+    uint32 getNextBody(uint32 index) const;
+
+    /* Get the number of bodies in the island of a root body */
+    uint32 getNumBodies(uint32 root) const;
+};
+
+/* Query whether a body is part of the islands */
+inline bool PersistentIslands::containsBody(Entity bodyEntity) const {
+  const uint32 index = bodyEntity.getIndex();
+  return index < mParents.size() && mParents[index] != INVALID_INDEX && mBodyEntities[index] == bodyEntity;
+}
+
+/* Query whether a body is static */
+inline bool PersistentIslands::isStatic(uint32 index) const {
+  return mIsStatic[index];
+}
+
+/* Query whether the contacts of a body have to be linked again */
+inline bool PersistentIslands::isLinkPending(uint32 index) const {
+  return mIsLinkPending[index];
+}
+
+/* Query whether any body has contacts which have to be linked again */
+inline bool PersistentIslands::hasLinkPending() const {
+  return !mLinkPendingBodies.empty();
+}
+
+/* Query whether the island of a root body is awake */
+inline bool PersistentIslands::isAwake(uint32 root) const {
+  assert(mParents[root] == root);
+  return mAwakeIndices[root] != INVALID_INDEX;
+}
+
+/* Get the number of awake islands */
+inline uint32 PersistentIslands::getNumAwakeIslands() const {
+  return static_cast<uint32>(mAwakeIslands.size());
+}
+
+/* Get the root body of an awake island */
+inline uint32 PersistentIslands::getAwakeIsland(uint32 awakeIndex) const {
+  return mAwakeIslands[awakeIndex];
+}
+
+/* Get the index in the awake islands of a root body */
+inline uint32 PersistentIslands::getAwakeIndex(uint32 root) const {
+  assert(mParents[root] == root);
+  return mAwakeIndices[root];
+}
+
+/* Get the entity of a body */
+inline Entity PersistentIslands::getBodyEntity(uint32 index) const {
+  return mBodyEntities[index];
+}
+
+/* Get the first body in the island of a root body */
+inline uint32 PersistentIslands::getFirstBody(uint32 root) const {
+  assert(mParents[root] == root);
+  return mFirstBodies[root];
+}
+
+/* Get the next body in the island of a body */
+inline uint32 PersistentIslands::getNextBody(uint32 index) const {
+  return mNextBodies[index];
+}
+
+/* Get the number of bodies in the island of a root body */
+inline uint32 PersistentIslands::getNumBodies(uint32 root) const {
+  assert(mParents[root] == root);
+  return mNumBodies[root];
+}
+
+}
+
+#endif
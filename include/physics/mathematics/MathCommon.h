@@ -45,7 +45,7 @@ namespace physics {
       return getElegantPair(secondNumber, firstNumber);
     }
 
-    return static_cast<uint64>(firstNumber * firstNumber + firstNumber + secondNumber);
+    return static_cast<uint64>(firstNumber) * firstNumber + firstNumber + secondNumber;
   }
 
 }
@@ -0,0 +1,352 @@
+#ifndef PHYSICS_SIMD_H
+#define PHYSICS_SIMD_H
+
+#include <physics/mathematics/MathCommon.h>
+#include <cstring>
+
+/* Pick the widest instruction set enabled by the compiler, defining PHYSICS_SIMD_SCALAR forces the portable fallback */
+#if !defined(PHYSICS_SIMD_SCALAR) && defined(__AVX2__)
+  #define PHYSICS_SIMD_AVX2
+  #include <immintrin.h>
+#elif !defined(PHYSICS_SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define PHYSICS_SIMD_SSE
+  #include <emmintrin.h>
+#endif
+
+namespace physics {
+
+#if defined(PHYSICS_SIMD_AVX2)
+  /* Number of lanes of a wide float */
+  constexpr uint32 SIMD_WIDTH = 8;
+#else
+  /* Number of lanes of a wide float */
+  constexpr uint32 SIMD_WIDTH = 4;
+#endif
+
+/* Wide float holding one value per lane, comparisons return masks where every bit of a lane is either set or cleared */
+struct SimdFloat {
+
+  public:
+    /* -- Attributes -- */
+
+#if defined(PHYSICS_SIMD_AVX2)
+    /* Lanes */
+    __m256 value;
+#elif defined(PHYSICS_SIMD_SSE)
+    /* Lanes */
+    __m128 value;
+#else
+    /* Lanes */
+    float value[SIMD_WIDTH];
+#endif
+};
+
+/* Wide two dimensional vector holding one vector per lane */
+struct SimdVector2 {
+
+  public:
+    /* -- Attributes -- */
+
+    /* x components */
+    SimdFloat x;
+
+    /* y components */
+    SimdFloat y;
+};
+
+#if !defined(PHYSICS_SIMD_AVX2) && !defined(PHYSICS_SIMD_SSE)
+/* Reinterpret the bits of a float */
+inline uint32 simdBits(float value) {
+  uint32 bits;
+  std::memcpy(&bits, &value, sizeof(float));
+  return bits;
+}
+
+/* Reinterpret bits as a float */
+inline float simdFromBits(uint32 bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+#endif
+
+/* Load SIMD_WIDTH consecutive floats */
+inline SimdFloat simdLoad(const float* values) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_loadu_ps(values);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_loadu_ps(values);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = values[i];
+#endif
+  return result;
+}
+
+/* Store the lanes into SIMD_WIDTH consecutive floats */
+inline void simdStore(float* values, const SimdFloat& a) {
+#if defined(PHYSICS_SIMD_AVX2)
+  _mm256_storeu_ps(values, a.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  _mm_storeu_ps(values, a.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) values[i] = a.value[i];
+#endif
+}
+
+/* Set every lane to the given value */
+inline SimdFloat simdSet(float value) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_set1_ps(value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_set1_ps(value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = value;
+#endif
+  return result;
+}
+
+/* Set every lane to zero */
+inline SimdFloat simdZero() {
+  return simdSet(0.0f);
+}
+
+/* Lane-wise addition */
+inline SimdFloat operator+(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_add_ps(a.value, b.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_add_ps(a.value, b.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = a.value[i] + b.value[i];
+#endif
+  return result;
+}
+
+/* Lane-wise subtraction */
+inline SimdFloat operator-(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_sub_ps(a.value, b.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_sub_ps(a.value, b.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = a.value[i] - b.value[i];
+#endif
+  return result;
+}
+
+/* Lane-wise multiplication */
+inline SimdFloat operator*(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_mul_ps(a.value, b.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_mul_ps(a.value, b.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = a.value[i] * b.value[i];
+#endif
+  return result;
+}
+
+/* Lane-wise division */
+inline SimdFloat operator/(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_div_ps(a.value, b.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_div_ps(a.value, b.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = a.value[i] / b.value[i];
+#endif
+  return result;
+}
+
+/* Lane-wise negation */
+inline SimdFloat operator-(const SimdFloat& a) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_xor_ps(a.value, _mm256_set1_ps(-0.0f));
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_xor_ps(a.value, _mm_set1_ps(-0.0f));
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = -a.value[i];
+#endif
+  return result;
+}
+
+/* Lane-wise square root */
+inline SimdFloat simdSqrt(const SimdFloat& a) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_sqrt_ps(a.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_sqrt_ps(a.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = std::sqrt(a.value[i]);
+#endif
+  return result;
+}
+
+/* Lane-wise minimum with the same semantics as std::min */
+inline SimdFloat simdMin(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_min_ps(b.value, a.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_min_ps(b.value, a.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = std::min(a.value[i], b.value[i]);
+#endif
+  return result;
+}
+
+/* Lane-wise maximum with the same semantics as std::max */
+inline SimdFloat simdMax(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_max_ps(b.value, a.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_max_ps(b.value, a.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = std::max(a.value[i], b.value[i]);
+#endif
+  return result;
+}
+
+/* Lane-wise a > b mask */
+inline SimdFloat simdGreater(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_cmp_ps(a.value, b.value, _CMP_GT_OQ);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_cmpgt_ps(a.value, b.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = simdFromBits(a.value[i] > b.value[i] ? 0xFFFFFFFFu : 0u);
+#endif
+  return result;
+}
+
+/* Lane-wise a >= b mask */
+inline SimdFloat simdGreaterEqual(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_cmp_ps(a.value, b.value, _CMP_GE_OQ);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_cmpge_ps(a.value, b.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = simdFromBits(a.value[i] >= b.value[i] ? 0xFFFFFFFFu : 0u);
+#endif
+  return result;
+}
+
+/* Lane-wise a == b mask */
+inline SimdFloat simdEqual(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_cmp_ps(a.value, b.value, _CMP_EQ_OQ);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_cmpeq_ps(a.value, b.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = simdFromBits(a.value[i] == b.value[i] ? 0xFFFFFFFFu : 0u);
+#endif
+  return result;
+}
+
+/* Lane-wise conjunction of two masks */
+inline SimdFloat simdAnd(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_and_ps(a.value, b.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_and_ps(a.value, b.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = simdFromBits(simdBits(a.value[i]) & simdBits(b.value[i]));
+#endif
+  return result;
+}
+
+/* Lane-wise disjunction of two masks */
+inline SimdFloat simdOr(const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_or_ps(a.value, b.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_or_ps(a.value, b.value);
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = simdFromBits(simdBits(a.value[i]) | simdBits(b.value[i]));
+#endif
+  return result;
+}
+
+/* Lane-wise selection of a where the mask is set and of b elsewhere */
+inline SimdFloat simdSelect(const SimdFloat& mask, const SimdFloat& a, const SimdFloat& b) {
+  SimdFloat result;
+#if defined(PHYSICS_SIMD_AVX2)
+  result.value = _mm256_blendv_ps(b.value, a.value, mask.value);
+#elif defined(PHYSICS_SIMD_SSE)
+  result.value = _mm_or_ps(_mm_and_ps(mask.value, a.value), _mm_andnot_ps(mask.value, b.value));
+#else
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) result.value[i] = simdFromBits((simdBits(mask.value[i]) & simdBits(a.value[i])) | (~simdBits(mask.value[i]) & simdBits(b.value[i])));
+#endif
+  return result;
+}
+
+/* Gather the top bit of each lane of a mask into the low SIMD_WIDTH bits of an integer, lane i giving bit i */
+inline uint32 simdMask(const SimdFloat& mask) {
+#if defined(PHYSICS_SIMD_AVX2)
+  return static_cast<uint32>(_mm256_movemask_ps(mask.value));
+#elif defined(PHYSICS_SIMD_SSE)
+  return static_cast<uint32>(_mm_movemask_ps(mask.value));
+#else
+  uint32 bits = 0;
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) bits |= (simdBits(mask.value[i]) >> 31) << i;
+  return bits;
+#endif
+}
+
+/* Lane-wise clamp with the same semantics as the scalar clamp */
+inline SimdFloat simdClamp(const SimdFloat& value, const SimdFloat& low, const SimdFloat& high) {
+  return simdMax(low, simdMin(value, high));
+}
+
+/* Lane-wise vector addition */
+inline SimdVector2 operator+(const SimdVector2& a, const SimdVector2& b) {
+  return {a.x + b.x, a.y + b.y};
+}
+
+/* Lane-wise vector subtraction */
+inline SimdVector2 operator-(const SimdVector2& a, const SimdVector2& b) {
+  return {a.x - b.x, a.y - b.y};
+}
+
+/* Lane-wise vector scaling */
+inline SimdVector2 operator*(const SimdFloat& number, const SimdVector2& vector) {
+  return {number * vector.x, number * vector.y};
+}
+
+/* Lane-wise dot product */
+inline SimdFloat dot(const SimdVector2& a, const SimdVector2& b) {
+  return a.x * b.x + a.y * b.y;
+}
+
+/* Lane-wise cross product between two vectors */
+inline SimdFloat cross(const SimdVector2& a, const SimdVector2& b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+/* Lane-wise cross product between a number and a vector */
+inline SimdVector2 cross(const SimdFloat& number, const SimdVector2& vector) {
+  return {-number * vector.y, number * vector.x};
+}
+
+/* Lane-wise selection of vectors */
+inline SimdVector2 simdSelect(const SimdFloat& mask, const SimdVector2& a, const SimdVector2& b) {
+  return {simdSelect(mask, a.x, b.x), simdSelect(mask, a.y, b.y)};
+}
+
+}
+
+#endif
@@ -41,6 +41,11 @@ class FreeListMemoryHandler : public MemoryHandler {
         }
     };
 
+    /* -- Constants -- */
+
+    /* Size of an allocation header, padded to keep the memory blocks aligned */
+    static constexpr size_t HEADER_SIZE = alignSize(sizeof(AllocationHeader));
+
     /* -- Attributes -- */
 
     /* Initial size */
@@ -61,6 +66,18 @@ class FreeListMemoryHandler : public MemoryHandler {
     /* Free memory block */
     AllocationHeader* mFree;
 
+    /* Size of the memory blocks in use */
+    size_t mNumUsedBytes;
+
+    /* Highest size of the memory blocks in use at once */
+    size_t mNumPeakUsedBytes;
+
+    /* Number of allocations */
+    uint64 mNumAllocations;
+
+    /* Number of frees */
+    uint64 mNumFrees;
+
     /* -- Methods -- */
     
     /* Split memory block into two portions */
@@ -89,6 +106,9 @@ class FreeListMemoryHandler : public MemoryHandler {
 
     /* Free dynamically allocated memory */
     void free(void* ptr, size_t size) override;
+
+    /* Get the live statistics of the handler */
+    MemoryStatistics getStatistics() override;
 };
 
 }
@@ -3,25 +3,44 @@
 
 #include <physics/Configuration.h>
 #include <physics/memory/MemoryHandler.h>
-#include <mutex>
+#include <cstddef>
 
 namespace physics {
 
+/* Frame memory which is bump allocated and released all at once by a reset */
+/* Allocations do not lock so a handler must only be used by one thread at a time, threads executing tasks use their own handler */
 class LinearMemoryHandler : public MemoryHandler {
 
   private:
+    /* -- Nested Classes -- */
+
+    /* Header of a block chained to the memory space once the memory space is full */
+    struct Block {
+
+      public:
+        /* -- Attributes -- */
+
+        /* Block chained before this one */
+        Block* previous;
+
+        /* Size in bytes available after the header */
+        size_t size;
+    };
+
+    /* -- Constants -- */
+
+    /* Size of a block header, padded to keep the memory blocks aligned */
+    static constexpr size_t BLOCK_HEADER_SIZE = alignSize(sizeof(Block));
+
     /* -- Attributes -- */
     static const int NUM_FRAMES_BEFORE_SHRINK = 60;
 
     /* Initial size */
-    size_t INIT_SIZE = 5242880;
+    static constexpr size_t INIT_SIZE = 5242880;
 
     /* Size of memory space */
     size_t mSize;
 
-    /* Mutex to prevent simultaneous allocations */
-    std::mutex mMutex;
-
     /* Primary memory handler */
     MemoryHandler& mPrimaryMemoryHandler;
 
@@ -34,8 +53,31 @@ class LinearMemoryHandler : public MemoryHandler {
     /* Number of frames before shrinking the memory space when performing a reset */
     size_t mNumValidShrinkFrames;
 
-    /* Grow the memory space when performing a reset */
-    bool mGrow;
+    /* Last block chained during the current frame */
+    Block* mLastBlock;
+
+    /* Offset in bytes from the start of the last block */
+    size_t mBlockOffset;
+
+    /* Number of bytes allocated from the chained blocks during the current frame */
+    size_t mNumBlockBytes;
+
+    /* Highest number of bytes allocated during a frame */
+    size_t mNumPeakUsedBytes;
+
+    /* Number of allocations */
+    uint64 mNumAllocations;
+
+    /* Number of frees, which release nothing */
+    uint64 mNumFrees;
+
+    /* -- Methods -- */
+
+    /* Chain a new block which is able to hold an allocation of size in bytes */
+    void addBlock(size_t size);
+
+    /* Release the chained blocks */
+    void freeBlocks();
 
   public:
     /* -- Methods -- */
@@ -43,6 +85,12 @@ class LinearMemoryHandler : public MemoryHandler {
     /* Constructor */
     LinearMemoryHandler(MemoryHandler& primaryMemoryHandler);
 
+    /* Constructor */
+    LinearMemoryHandler(MemoryHandler& primaryMemoryHandler, size_t initSize);
+
+    /* Deleted copy constructor */
+    LinearMemoryHandler(const LinearMemoryHandler& memoryHandler) = delete;
+
     /* Destructor */
     ~LinearMemoryHandler() override;
 
@@ -57,8 +105,11 @@ class LinearMemoryHandler : public MemoryHandler {
 
     /* Reset pointer to mStart */
     void reset();
+
+    /* Get the live statistics of the handler, only while no other thread allocates from it */
+    MemoryStatistics getStatistics() override;
 };
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,13 +1,56 @@
 #ifndef PHYSICS_MEMORY_HANDLER_H
 #define PHYSICS_MEMORY_HANDLER_H
 
+#include <cstddef>
+#include <cstdint>
+
 namespace physics {
 
+/* Live statistics of a memory handler */
+struct MemoryStatistics {
+
+  public:
+    /* -- Attributes -- */
+
+    /* Number of bytes handed out and not yet freed */
+    size_t numUsedBytes;
+
+    /* Number of bytes held from the primary memory handler */
+    size_t numReservedBytes;
+
+    /* Highest number of bytes handed out at once */
+    size_t numPeakUsedBytes;
+
+    /* Number of allocations */
+    std::uint64_t numAllocations;
+
+    /* Number of frees */
+    std::uint64_t numFrees;
+
+    /* Share of the free memory lying outside of the largest free block, zero if the handler does not fragment */
+    float fragmentation;
+
+    /* -- Methods -- */
+
+    /* Constructor */
+    MemoryStatistics() : numUsedBytes(0), numReservedBytes(0), numPeakUsedBytes(0), numAllocations(0), numFrees(0), fragmentation(0.0f) {}
+};
+
 class MemoryHandler {
 
   public:
+    /* -- Constants -- */
+
+    /* Alignment of every memory block handed out, enough for any fundamental or synchronization type */
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
     /* -- Methods -- */
 
+    /* Round a size in bytes up to the alignment */
+    static constexpr size_t alignSize(size_t size) {
+      return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
     /* Constructor */
     MemoryHandler() = default;
 
@@ -22,6 +65,11 @@ class MemoryHandler {
 
     /* Free dynamically allocated memory */
     virtual void free(void* ptr, size_t size) = 0;
+
+    /* Get the live statistics of the handler, handlers which do not keep any report none */
+    virtual MemoryStatistics getStatistics() {
+      return MemoryStatistics();
+    }
 };
 
 }
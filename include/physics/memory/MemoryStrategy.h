@@ -5,6 +5,9 @@
 #include <physics/memory/Linear.h>
 #include <physics/memory/ObjectPool.h>
 #include <physics/memory/FreeList.h>
+#include <physics/memory/TLSF.h>
+#include <new>
+#include <cassert>
 
 namespace physics {
 
@@ -25,25 +28,56 @@ class MemoryStrategy {
     /* Free list memory handler */
     FreeListMemoryHandler mFreeListMemoryHandler;
 
+    /* Two-level segregated fit memory handler */
+    TLSFMemoryHandler mTLSFMemoryHandler;
+
+    /* General purpose memory handler, either the free list or the two-level segregated fit memory handler */
+    MemoryHandler* mGeneralMemoryHandler;
+
     /* Object pool memory handler */
     ObjectPoolMemoryHandler mObjectPoolMemoryHandler;
 
-    /* Linear memory handler */
+    /* Linear memory handler of the thread stepping the world */
     LinearMemoryHandler mLinearMemoryHandler;
 
+    /* Linear memory handlers of the threads executing the tasks of a frame, indexed by task thread index */
+    LinearMemoryHandler* mThreadLinearMemoryHandlers;
+
+    /* Number of thread linear memory handlers */
+    uint32 mNumThreadLinearMemoryHandlers;
+
+    /* -- Methods -- */
+
+    /* Destroy the thread linear memory handlers */
+    void destroyThreadLinearMemoryHandlers();
+
   public:
     /* -- Nested Classes -- */
 
     /* Handler types */
-    enum class HandlerType {Linear, ObjectPool, FreeList, Vanilla, Primary};
+    enum class HandlerType {Linear, ObjectPool, FreeList, TLSF, Vanilla, Primary};
+
+    /* -- Constants -- */
+
+    /* Initial size of the general purpose memory handler which has not been selected */
+    static constexpr size_t IDLE_GENERAL_INIT_SIZE = 1024;
+
+    /* Initial size of a thread linear memory handler, which grows on demand like any linear memory handler */
+    static constexpr size_t THREAD_LINEAR_INIT_SIZE = 1048576;
 
     /* -- Methods -- */
 
     /* Constructor */
-    MemoryStrategy(MemoryHandler* primaryMemoryHandler, size_t initSize = 0);
+    MemoryStrategy(MemoryHandler* primaryMemoryHandler, size_t initSize = 0, HandlerType generalHandlerType = HandlerType::FreeList);
 
     /* Destructor */
-    ~MemoryStrategy() = default;
+    ~MemoryStrategy();
+
+    /* Deleted copy constructor */
+    MemoryStrategy(const MemoryStrategy& memoryStrategy) = delete;
+
+    /* Deleted assignment operator */
+    MemoryStrategy& operator=(const MemoryStrategy& memoryStrategy) = delete;
 
     /* Dynamically allocate memory using a specific memory handler */
     void* allocate(HandlerType handlerType, size_t size);
@@ -54,26 +88,67 @@ class MemoryStrategy {
     /* Get Linear handler */
     LinearMemoryHandler& getLinearMemoryHandler();
 
+    /* Get the Linear handler of a thread executing a task */
+    LinearMemoryHandler& getThreadLinearMemoryHandler(uint32 threadIndex);
+
+    /* Make sure that there is a thread Linear handler for every thread index below numThreads */
+    void reserveThreadLinearMemoryHandlers(uint32 numThreads);
+
     /* Get Object Pool handler */
     ObjectPoolMemoryHandler& getObjectPoolMemoryHandler();
 
     /* Get Free List handler */
     FreeListMemoryHandler& getFreeListMemoryHandler();
 
+    /* Get TLSF handler */
+    TLSFMemoryHandler& getTLSFMemoryHandler();
+
+    /* Get the general purpose handler backing the world, the Object Pool and the Linear handlers */
+    MemoryHandler& getGeneralMemoryHandler();
+
     /* Get Vanilla handler */
     VanillaMemoryHandler& getVanillaMemoryHandler();
 
     /* Reset memory handler if applicable */
     void reset(HandlerType handlerType);
+
+    /* Get the live statistics of a specific memory handler, those of the Linear handlers of every thread being summed */
+    MemoryStatistics getStatistics(HandlerType handlerType);
 };
 
 /* Constructor */
 inline MemoryStrategy::MemoryStrategy(MemoryHandler* primaryMemoryHandler,
-                                      size_t initSize) :
+                                      size_t initSize,
+                                      HandlerType generalHandlerType) :
                                       mPrimaryMemoryHandler(!primaryMemoryHandler ? &mVanillaMemoryHandler : primaryMemoryHandler),
-                                      mFreeListMemoryHandler(*mPrimaryMemoryHandler, initSize),
-                                      mLinearMemoryHandler(mFreeListMemoryHandler), /* Change back to free list */
-                                      mObjectPoolMemoryHandler(mFreeListMemoryHandler) {} /* Change back to free list */
+                                      mFreeListMemoryHandler(*mPrimaryMemoryHandler, generalHandlerType == HandlerType::FreeList ? initSize : IDLE_GENERAL_INIT_SIZE),
+                                      mTLSFMemoryHandler(*mPrimaryMemoryHandler, generalHandlerType == HandlerType::TLSF ? initSize : IDLE_GENERAL_INIT_SIZE),
+                                      mGeneralMemoryHandler(generalHandlerType == HandlerType::TLSF ? static_cast<MemoryHandler*>(&mTLSFMemoryHandler) : static_cast<MemoryHandler*>(&mFreeListMemoryHandler)),
+                                      mObjectPoolMemoryHandler(*mGeneralMemoryHandler),
+                                      mLinearMemoryHandler(*mGeneralMemoryHandler),
+                                      mThreadLinearMemoryHandlers(nullptr),
+                                      mNumThreadLinearMemoryHandlers(0) {
+  assert(generalHandlerType == HandlerType::FreeList || generalHandlerType == HandlerType::TLSF);
+}
+
+/* Destructor */
+inline MemoryStrategy::~MemoryStrategy() {
+  destroyThreadLinearMemoryHandlers();
+}
+
+/* Destroy the thread linear memory handlers */
+inline void MemoryStrategy::destroyThreadLinearMemoryHandlers() {
+  for(uint32 i = 0; i < mNumThreadLinearMemoryHandlers; i++) {
+    mThreadLinearMemoryHandlers[i].~LinearMemoryHandler();
+  }
+
+  if(mThreadLinearMemoryHandlers) {
+    mPrimaryMemoryHandler->free(mThreadLinearMemoryHandlers, mNumThreadLinearMemoryHandlers * sizeof(LinearMemoryHandler));
+  }
+
+  mThreadLinearMemoryHandlers = nullptr;
+  mNumThreadLinearMemoryHandlers = 0;
+}
 
 /* Dynamically allocate memory using a specific memory handler */
 inline void* MemoryStrategy::allocate(HandlerType handlerType, size_t size) {
@@ -81,6 +156,7 @@ inline void* MemoryStrategy::allocate(HandlerType handlerType, size_t size) {
     case HandlerType::Linear: return mLinearMemoryHandler.allocate(size);
     case HandlerType::ObjectPool: return mObjectPoolMemoryHandler.allocate(size);
     case HandlerType::FreeList: return mFreeListMemoryHandler.allocate(size);
+    case HandlerType::TLSF: return mTLSFMemoryHandler.allocate(size);
     case HandlerType::Vanilla: return mVanillaMemoryHandler.allocate(size);
     case HandlerType::Primary: return mPrimaryMemoryHandler->allocate(size);
     default: return nullptr;
@@ -93,6 +169,7 @@ inline void MemoryStrategy::free(HandlerType handlerType, void* ptr, size_t size
     case HandlerType::Linear: mLinearMemoryHandler.free(ptr, size); break;
     case HandlerType::ObjectPool: mObjectPoolMemoryHandler.free(ptr, size); break;
     case HandlerType::FreeList: mFreeListMemoryHandler.free(ptr, size); break;
+    case HandlerType::TLSF: mTLSFMemoryHandler.free(ptr, size); break;
     case HandlerType::Vanilla: mVanillaMemoryHandler.free(ptr, size); break;
     case HandlerType::Primary: mPrimaryMemoryHandler->free(ptr, size); break;
     default: return;
@@ -104,6 +181,30 @@ inline LinearMemoryHandler& MemoryStrategy::getLinearMemoryHandler() {
   return mLinearMemoryHandler;
 }
 
+/* Get the Linear handler of a thread executing a task */
+inline LinearMemoryHandler& MemoryStrategy::getThreadLinearMemoryHandler(uint32 threadIndex) {
+  assert(threadIndex < mNumThreadLinearMemoryHandlers);
+  return mThreadLinearMemoryHandlers[threadIndex];
+}
+
+/* Make sure that there is a thread Linear handler for every thread index below numThreads */
+inline void MemoryStrategy::reserveThreadLinearMemoryHandlers(uint32 numThreads) {
+  if(numThreads <= mNumThreadLinearMemoryHandlers) {
+    return;
+  }
+
+  /* Handlers are only reserved in between frames so they hold no memory which would have to be kept */
+  destroyThreadLinearMemoryHandlers();
+  mThreadLinearMemoryHandlers = static_cast<LinearMemoryHandler*>(mPrimaryMemoryHandler->allocate(numThreads * sizeof(LinearMemoryHandler)));
+  assert(mThreadLinearMemoryHandlers);
+
+  for(uint32 i = 0; i < numThreads; i++) {
+    new (mThreadLinearMemoryHandlers + i) LinearMemoryHandler(*mGeneralMemoryHandler, THREAD_LINEAR_INIT_SIZE);
+  }
+
+  mNumThreadLinearMemoryHandlers = numThreads;
+}
+
 /* Get Object Pool handler */
 inline ObjectPoolMemoryHandler& MemoryStrategy::getObjectPoolMemoryHandler() {
   return mObjectPoolMemoryHandler;
@@ -114,6 +215,16 @@ inline FreeListMemoryHandler& MemoryStrategy::getFreeListMemoryHandler() {
   return mFreeListMemoryHandler;
 }
 
+/* Get TLSF handler */
+inline TLSFMemoryHandler& MemoryStrategy::getTLSFMemoryHandler() {
+  return mTLSFMemoryHandler;
+}
+
+/* Get the general purpose handler backing the world, the Object Pool and the Linear handlers */
+inline MemoryHandler& MemoryStrategy::getGeneralMemoryHandler() {
+  return *mGeneralMemoryHandler;
+}
+
 /* Get Vanilla memory handler */
 inline VanillaMemoryHandler& MemoryStrategy::getVanillaMemoryHandler() {
   return mVanillaMemoryHandler;
@@ -122,14 +233,49 @@ inline VanillaMemoryHandler& MemoryStrategy::getVanillaMemoryHandler() {
 /* Reset memory handler if applicable */
 inline void MemoryStrategy::reset(HandlerType handlerType) {
   switch(handlerType) {
-    case HandlerType::Linear: mLinearMemoryHandler.reset(); break;
-    case HandlerType::ObjectPool: break;
+    case HandlerType::Linear:
+      mLinearMemoryHandler.reset();
+
+      /* Frame memory of every thread is released together */
+      for(uint32 i = 0; i < mNumThreadLinearMemoryHandlers; i++) {
+        mThreadLinearMemoryHandlers[i].reset();
+      }
+
+      break;
+    case HandlerType::ObjectPool: mObjectPoolMemoryHandler.trim(); break;
     case HandlerType::FreeList: break;
+    case HandlerType::TLSF: break;
     case HandlerType::Vanilla: break;
     case HandlerType::Primary: break;
   }
 }
 
+/* Get the live statistics of a specific memory handler, those of the Linear handlers of every thread being summed */
+inline MemoryStatistics MemoryStrategy::getStatistics(HandlerType handlerType) {
+  switch(handlerType) {
+    case HandlerType::Linear: {
+      MemoryStatistics statistics = mLinearMemoryHandler.getStatistics();
+
+      for(uint32 i = 0; i < mNumThreadLinearMemoryHandlers; i++) {
+        const MemoryStatistics threadStatistics = mThreadLinearMemoryHandlers[i].getStatistics();
+        statistics.numUsedBytes += threadStatistics.numUsedBytes;
+        statistics.numReservedBytes += threadStatistics.numReservedBytes;
+        statistics.numPeakUsedBytes += threadStatistics.numPeakUsedBytes;
+        statistics.numAllocations += threadStatistics.numAllocations;
+        statistics.numFrees += threadStatistics.numFrees;
+      }
+
+      return statistics;
+    }
+    case HandlerType::ObjectPool: return mObjectPoolMemoryHandler.getStatistics();
+    case HandlerType::FreeList: return mFreeListMemoryHandler.getStatistics();
+    case HandlerType::TLSF: return mTLSFMemoryHandler.getStatistics();
+    case HandlerType::Vanilla: return mVanillaMemoryHandler.getStatistics();
+    case HandlerType::Primary: return mPrimaryMemoryHandler->getStatistics();
+    default: return MemoryStatistics();
+  }
+}
+
 }
 
 #endif
\ No newline at end of file
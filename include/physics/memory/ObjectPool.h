@@ -4,12 +4,27 @@
 #include <physics/Configuration.h>
 #include <physics/memory/MemoryHandler.h>
 #include <mutex>
+#include <atomic>
 
 namespace physics {
 
 class ObjectPoolMemoryHandler : public MemoryHandler {
 
   private:
+    /* -- Constants -- */
+
+    /* Maximum chunk size */
+    static const size_t MAX_CHUNK_SIZE = 1024;
+
+    /* Pool size */
+    static const size_t POOL_SIZE = 16 * MAX_CHUNK_SIZE;
+
+    /* Number of pool size groups */
+    static const uint NUM_POOL_GROUPS = 128;
+
+    /* Maximum number of object pools a thread keeps caches for at once */
+    static const uint MAX_THREAD_CACHES = 4;
+
     /* -- Nested Classes -- */
 
     /* Chunks are of predefined size and are the smallest units of memory in object pool allocation */
@@ -29,29 +44,81 @@ class ObjectPoolMemoryHandler : public MemoryHandler {
 
         /* Pointer to the first chunk in the pool */
         Chunk* chunks;
+
+        /* Pool group the chunks of the pool belong to */
+        uint poolGroupIndex;
+
+        /* Number of chunks of the pool found in the shared pool group by the last trim */
+        uint numFreeChunks;
     };
 
-    /* -- Attributes -- */
+    /* Chunks of each pool group cached by a thread so that it can allocate and free them without locking */
+    struct ThreadCache {
 
-    /* Maximum chunk size */
-    static const size_t MAX_CHUNK_SIZE = 1024;
+      public:
+        /* -- Attributes -- */
 
-    /* Pool size */
-    static const size_t POOL_SIZE = 16 * MAX_CHUNK_SIZE;
+        /* Object pool the chunks are cached from, null if the cache is unused */
+        std::atomic<ObjectPoolMemoryHandler*> handler;
 
-    /* Number of pool size groups */
-    static const uint NUM_POOL_GROUPS = 128;
+        /* Next cache of the same object pool */
+        ThreadCache* nextCache;
+
+        /* Previous cache of the same object pool */
+        ThreadCache* previousCache;
+
+        /* First cached chunk of each pool group */
+        Chunk* heads[NUM_POOL_GROUPS];
+
+        /* Number of cached chunks of each pool group, only written by the thread owning the cache */
+        std::atomic<uint> numChunks[NUM_POOL_GROUPS];
+
+        /* Number of allocations served by the cache, only written by the thread owning the cache */
+        std::atomic<uint64> numAllocations;
+
+        /* Number of frees served by the cache, only written by the thread owning the cache */
+        std::atomic<uint64> numFrees;
+    };
+
+    /* Thread caches of a thread, which are drained back into their object pools when the thread exits */
+    struct ThreadCaches {
+
+      public:
+        /* -- Attributes -- */
+
+        /* Caches */
+        ThreadCache caches[MAX_THREAD_CACHES];
+
+        /* -- Methods -- */
+
+        /* Constructor */
+        ThreadCaches();
+
+        /* Destructor */
+        ~ThreadCaches();
+    };
+
+    /* -- Attributes -- */
 
     /* Chunk sizes associated with a specific pool group */
     static uint mChunkSizes[NUM_POOL_GROUPS];
 
+    /* Number of chunks moved at once between a thread cache and the shared pool group */
+    static uint mBatchSizes[NUM_POOL_GROUPS];
+
     /* Associate allocation sizes with pool groups */
     static uint mChunkSizePoolMap[MAX_CHUNK_SIZE + 1];
 
     /* Pools initialized */
     static bool init;
 
-    /* Mutex to prevent simultaneous allocations */
+    /* Thread caches of the calling thread */
+    static thread_local ThreadCaches mCallingThreadCaches;
+
+    /* Mutex guarding the attachment of thread caches to object pools */
+    static std::mutex mThreadCacheMutex;
+
+    /* Mutex to prevent simultaneous allocations from the shared pool groups */
     std::mutex mMutex;
 
     /* Primary memory handler */
@@ -69,6 +136,71 @@ class ObjectPoolMemoryHandler : public MemoryHandler {
     /* Number of used pools */
     uint mNumUsedPools;
 
+    /* First thread cache attached to this object pool */
+    ThreadCache* mFirstThreadCache;
+
+    /* Total size of the chunks held by the shared pool groups */
+    size_t mNumFreeBytes;
+
+    /* Size of the chunks held by the shared pool groups above which pools are trimmed automatically, zero if never */
+    size_t mTrimThreshold;
+
+    /* Size of the chunks held by the shared pool groups at which the next automatic trim happens */
+    size_t mNextTrimBytes;
+
+    /* Number of chunks in the pools of each pool group */
+    uint mNumGroupChunks[NUM_POOL_GROUPS];
+
+    /* Number of chunks held by each shared pool group */
+    uint mNumSharedChunks[NUM_POOL_GROUPS];
+
+    /* Total size of the chunks in the pools */
+    size_t mNumChunkBytes;
+
+    /* Highest size of the chunks outside of the shared pool groups and of the allocations too large for a chunk at once */
+    size_t mNumPeakUsedBytes;
+
+    /* Size of the allocations too large for a chunk */
+    std::atomic<size_t> mNumLargeBytes;
+
+    /* Number of allocations which did not go through a thread cache, including those of detached caches */
+    std::atomic<uint64> mNumAllocations;
+
+    /* Number of frees which did not go through a thread cache, including those of detached caches */
+    std::atomic<uint64> mNumFrees;
+
+    /* -- Methods -- */
+
+    /* Allocate a new pool and add its chunks to the shared pool group */
+    void allocatePool(uint poolGroupIndex);
+
+    /* Get the cache of the calling thread for this object pool, null if the thread holds too many caches already */
+    ThreadCache* getThreadCache();
+
+    /* Move a batch of chunks from the shared pool group into a thread cache */
+    void refill(ThreadCache& cache, uint poolGroupIndex);
+
+    /* Move chunks from a thread cache back into the shared pool group until the cache holds at most a number of chunks */
+    void drain(ThreadCache& cache, uint poolGroupIndex, uint numChunks);
+
+    /* Detach a thread cache after returning all of its chunks */
+    void detach(ThreadCache& cache);
+
+    /* Find the pool containing a chunk, the pools being sorted by address */
+    Pool* findPool(const Chunk* chunk);
+
+    /* Release the pools whose chunks are all in the shared pool groups and return the number of bytes released */
+    size_t trimPools();
+
+    /* Trim the pools once the shared pool groups hold enough memory as per the trim threshold */
+    void autoTrim();
+
+    /* Record the size of the chunks outside of the shared pool groups if it is the highest so far */
+    void updatePeakUsedBytes();
+
+    /* Get the number of chunks of a pool group which are in use, the shared pool groups and the thread caches being locked */
+    uint getNumUsedChunksLocked(uint poolGroupIndex) const;
+
   public:
     /* -- Methods -- */
 
@@ -86,6 +218,26 @@ class ObjectPoolMemoryHandler : public MemoryHandler {
 
     /* Free dynamically allocated memory */
     void free(void* ptr, size_t size) override;
+
+    /* Release the pools of which no chunk is in use and return the number of bytes released */
+    /* Chunks cached by other threads than the calling one count as being in use */
+    size_t trim();
+
+    /* Set the size of the chunks held by the shared pool groups above which pools are trimmed automatically, zero to disable */
+    void setTrimThreshold(size_t trimThreshold);
+
+    /* Get the live statistics of the handler */
+    /* Chunks cached by a thread count as free while the peak counts them as used since it is only updated when chunks leave the shared pool groups */
+    MemoryStatistics getStatistics() override;
+
+    /* Get the number of chunks of a pool group which are in use */
+    uint getNumUsedChunks(uint poolGroupIndex);
+
+    /* Get the number of pool groups */
+    static uint getNumPoolGroups();
+
+    /* Get the chunk size of a pool group */
+    static uint getChunkSize(uint poolGroupIndex);
 };
 
 }
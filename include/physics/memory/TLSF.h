@@ -0,0 +1,179 @@
+#ifndef PHYSICS_TLSF_H
+#define PHYSICS_TLSF_H
+
+#include <physics/Configuration.h>
+#include <physics/memory/MemoryHandler.h>
+#include <mutex>
+
+namespace physics {
+
+/* Two-level segregated fit memory handler */
+/* Free blocks are kept in lists indexed by a power of two size class which is split into linear subclasses so that both allocating and freeing take constant time */
+class TLSFMemoryHandler : public MemoryHandler {
+
+  private:
+    /* -- Nested Classes -- */
+
+    /* Block headers precede every block, free or not, and link the free blocks of a size class together */
+    struct BlockHeader {
+
+      public:
+        /* -- Attributes -- */
+
+        /* Previous block in memory within the same region */
+        BlockHeader* previousPhysical;
+
+        /* Size of the memory block following the header */
+        size_t size;
+
+        /* Memory block is free */
+        bool isFree;
+
+        /* Memory block is the last one of its region */
+        bool isLast;
+
+        /* Next free block of the same size class */
+        BlockHeader* nextFree;
+
+        /* Previous free block of the same size class */
+        BlockHeader* previousFree;
+    };
+
+    /* Region headers record the memory apportioned from the primary memory handler */
+    struct RegionHeader {
+
+      public:
+        /* -- Attributes -- */
+
+        /* Next region */
+        RegionHeader* next;
+
+        /* Size of the region including its header */
+        size_t size;
+    };
+
+    /* -- Constants -- */
+
+    /* Log2 of the alignment of the memory blocks */
+    static constexpr uint32 ALIGNMENT_LOG2 = 4;
+
+    /* Alignment of the memory blocks */
+    static constexpr size_t ALIGNMENT = size_t(1) << ALIGNMENT_LOG2;
+    static_assert(ALIGNMENT >= MemoryHandler::ALIGNMENT, "TLSF blocks must satisfy the memory handler alignment");
+
+    /* Log2 of the number of second level size classes within each first level size class */
+    static constexpr uint32 SECOND_LEVEL_LOG2 = 4;
+
+    /* Number of second level size classes within each first level size class */
+    static constexpr uint32 SECOND_LEVEL_COUNT = uint32(1) << SECOND_LEVEL_LOG2;
+
+    /* Log2 of the first size which is not handled by the linearly spaced first level size class */
+    static constexpr uint32 FIRST_LEVEL_SHIFT = SECOND_LEVEL_LOG2 + ALIGNMENT_LOG2;
+
+    /* Blocks below this size are all kept within the first level size class zero */
+    static constexpr size_t SMALL_BLOCK_SIZE = size_t(1) << FIRST_LEVEL_SHIFT;
+
+    /* Log2 of the upper bound on the size of a memory block */
+    static constexpr uint32 FIRST_LEVEL_MAX_LOG2 = 32;
+
+    /* Number of first level size classes */
+    static constexpr uint32 FIRST_LEVEL_COUNT = FIRST_LEVEL_MAX_LOG2 - FIRST_LEVEL_SHIFT + 1;
+
+    /* Size of a block header, padded to keep the memory blocks aligned */
+    static constexpr size_t BLOCK_HEADER_SIZE = (sizeof(BlockHeader) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    /* Size of a region header, padded to keep the memory blocks aligned */
+    static constexpr size_t REGION_HEADER_SIZE = (sizeof(RegionHeader) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    /* -- Attributes -- */
+
+    /* Initial size */
+    static size_t INIT_SIZE;
+
+    /* Mutex to prevent simultaneous allocations */
+    std::mutex mMutex;
+
+    /* Primary memory handler */
+    MemoryHandler& mPrimaryMemoryHandler;
+
+    /* Total size of apportioned memory */
+    size_t mAllocated;
+
+    /* First region */
+    RegionHeader* mRegions;
+
+    /* Bitmap of the first level size classes holding a free block */
+    uint32 mFirstLevelBitmap;
+
+    /* Bitmaps of the second level size classes holding a free block, per first level size class */
+    uint32 mSecondLevelBitmaps[FIRST_LEVEL_COUNT];
+
+    /* First free block of each size class */
+    BlockHeader* mFreeBlocks[FIRST_LEVEL_COUNT][SECOND_LEVEL_COUNT];
+
+    /* Size of the memory blocks in use */
+    size_t mNumUsedBytes;
+
+    /* Highest size of the memory blocks in use at once */
+    size_t mNumPeakUsedBytes;
+
+    /* Number of allocations */
+    uint64 mNumAllocations;
+
+    /* Number of frees */
+    uint64 mNumFrees;
+
+    /* -- Methods -- */
+
+    /* Get the size class of a block */
+    static void mapping(size_t size, uint32& firstLevel, uint32& secondLevel);
+
+    /* Get the smallest size class whose blocks can all accomodate a size */
+    static void mappingSearch(size_t size, uint32& firstLevel, uint32& secondLevel);
+
+    /* Get the next block in memory */
+    static BlockHeader* getNextPhysical(BlockHeader* block);
+
+    /* Insert a free block into the list of its size class */
+    void insertFreeBlock(BlockHeader* block);
+
+    /* Remove a free block from the list of its size class */
+    void removeFreeBlock(BlockHeader* block);
+
+    /* Find and remove a free block which can accomodate a size */
+    BlockHeader* findFreeBlock(size_t size);
+
+    /* Split memory block into two portions, keeping the remainder free */
+    void split(BlockHeader* block, size_t size);
+
+    /* Absorb the next block in memory into a block */
+    void absorb(BlockHeader* block, BlockHeader* next);
+
+    /* Apportion additional memory */
+    void apportion(size_t size);
+
+  public:
+    /* -- Methods -- */
+
+    /* Constructor */
+    TLSFMemoryHandler(MemoryHandler& primaryMemoryHandler, size_t initSize = 0);
+
+    /* Destructor */
+    ~TLSFMemoryHandler() override;
+
+    /* Overloaded assignment operator */
+    TLSFMemoryHandler& operator=(TLSFMemoryHandler& memoryHandler) = delete;
+
+    /* Dynamically allocate memory of size in bytes and return a pointer to the heap allocated block */
+    void* allocate(size_t size) override;
+
+    /* Free dynamically allocated memory */
+    void free(void* ptr, size_t size) override;
+
+    /* Get the live statistics of the handler */
+    MemoryStatistics getStatistics() override;
+};
+
+}
+
+#endif
@@ -45,6 +45,7 @@ void BoxShape::set(float hx, float hy) {
 	mNormals[1].set(1.0f, 0.0f);
 	mNormals[2].set(0.0f, 1.0f);
 	mNormals[3].set(-1.0f, 0.0f);
+  packVertices();
 
   /* Alert broad phase that the geometry of the collision shape has changed */
   alertSizeChange();
@@ -71,6 +72,8 @@ void BoxShape::set(float hx, float hy, const Vector2& center, float angle) {
     mNormals[i] = transform.getOrientation() * mNormals[i];
   }
 
+  packVertices();
+
   /* Alert broad phase that the geometry of the collision shape has changed */
   alertSizeChange();
 }
@@ -9,18 +9,19 @@ BroadPhase::BroadPhase(CollisionDetection& collisionDetection,
                        BodyComponents& bodyComponents,
                        ColliderComponents& colliderComponents,
                        TransformComponents& transformComponents) :
-                       mDynamicTree(collisionDetection.getMemoryStrategy().getFreeListMemoryHandler(), DYNAMIC_TREE_FAT_AABB_INFLATION),
+                       mStaticTree(collisionDetection.getMemoryStrategy().getGeneralMemoryHandler()),
+                       mDynamicTree(collisionDetection.getMemoryStrategy().getGeneralMemoryHandler(), DYNAMIC_TREE_FAT_AABB_INFLATION),
                        mBodyComponents(bodyComponents),
                        mColliderComponents(colliderComponents),
                        mTransformComponents(transformComponents),
-                       mShapesToTest(collisionDetection.getMemoryStrategy().getFreeListMemoryHandler()),
+                       mShapesToTest(collisionDetection.getMemoryStrategy().getGeneralMemoryHandler()),
                        mCollisionDetection(collisionDetection) {}
 
 /* Notify tree about collider update */
 void BroadPhase::notifyColliderUpdate(int32 broadPhaseIdentifier, Collider* collider, const AABB& aabb, bool forceInsert) {
   assert(broadPhaseIdentifier >= 0);
-  /* Update the dynamic tree */
-  bool reinsert = mDynamicTree.update(broadPhaseIdentifier, aabb, forceInsert);
+  /* Update the tree holding the shape */
+  bool reinsert = getTree(broadPhaseIdentifier).update(getNode(broadPhaseIdentifier), aabb, forceInsert);
 
   /* Shape has moved out of the bound of its fat AABB which means it has been reinserted into the tree */
   if(reinsert) {
@@ -59,10 +60,12 @@ void BroadPhase::updateColliderComponents(uint32 start, uint32 numComponents) {
 /* Add collider */
 void BroadPhase::addCollider(Collider* collider, const AABB& aabb) {
   assert(collider->getBroadPhaseIdentifier() == -1);
-  /* Insert the collider into the dynamic tree and get the broad phase identifier */
-  int32 nodeIdentifier = mDynamicTree.add(aabb, collider);
+  /* Shapes of static bodies are kept apart so that moved shapes never walk them unless they reach them */
+  const bool isStaticBody = mBodyComponents.getType(mColliderComponents.getBodyEntity(collider->getEntity())) == BodyType::Static;
+  /* Insert the collider into its tree and get the broad phase identifier */
+  int32 node = (isStaticBody ? mStaticTree : mDynamicTree).add(aabb, collider);
   /* Assign the broad phase identifier */
-  mColliderComponents.setBroadPhaseIdentifier(collider->getEntity(), nodeIdentifier);
+  mColliderComponents.setBroadPhaseIdentifier(collider->getEntity(), getBroadPhaseIdentifier(node, isStaticBody));
   /* Mark the shape as having moved in the previous frame */
   addColliderForTest(collider->getBroadPhaseIdentifier(), collider);
 }
@@ -72,8 +75,8 @@ void BroadPhase::removeCollider(Collider* collider) {
   assert(collider->getBroadPhaseIdentifier() != -1);
   int32 broadPhaseIdentifier = collider->getBroadPhaseIdentifier();
   mColliderComponents.setBroadPhaseIdentifier(collider->getEntity(), -1);
-  /* Remove the collider from the dynamic tree */
-  mDynamicTree.remove(broadPhaseIdentifier);
+  /* Remove the collider from its tree */
+  getTree(broadPhaseIdentifier).remove(getNode(broadPhaseIdentifier));
   /* Unmark the shape as having moved in the previous frame */
   removeColliderForTest(broadPhaseIdentifier);
 }
@@ -111,15 +114,88 @@ void BroadPhase::removeColliderForTest(int32 broadPhaseIdentifier) {
 
 /* Get the collider associated with the provided broad phase identifier */
 Collider* BroadPhase::getCollider(int32 broadPhaseIdentifier) const {
-  return static_cast<Collider*>(mDynamicTree.getNodeData(broadPhaseIdentifier));
+  return static_cast<Collider*>(getTree(broadPhaseIdentifier).getNodeData(getNode(broadPhaseIdentifier)));
 }
 
-/* Compute overlap pairs */
-void BroadPhase::computeOverlapPairs(MemoryStrategy& memoryStrategy, DynamicArray<Pair<int32, int32>>& overlapNodes) {
+/* Get the number of moved shapes to be tested for overlap */
+uint32 BroadPhase::getNumShapesToTest() const {
+  return static_cast<uint32>(mShapesToTest.size());
+}
+
+/* Append the pairs of broad phase identifiers of the shapes of a tree overlapping with a range of test shapes of a tree */
+void BroadPhase::getOverlapNodes(MemoryHandler& memoryHandler, const DynamicTree& testTree, const DynamicArray<int32>& testNodes, uint32 begin, uint32 end, const DynamicTree& tree, DynamicArray<Pair<int32, int32>>& overlapNodes) const {
+  const uint32 start = static_cast<uint32>(overlapNodes.size());
+  tree.getShapeShapeOverlaps(memoryHandler, testTree, testNodes, begin, end, overlapNodes);
+  const bool isTestTreeStatic = &testTree == &mStaticTree;
+  const bool isTreeStatic = &tree == &mStaticTree;
+
+  /* Turn the nodes of both trees back into broad phase identifiers */
+  for(uint32 i = start; i < overlapNodes.size(); i++) {
+    overlapNodes[i].first = getBroadPhaseIdentifier(overlapNodes[i].first, isTestTreeStatic);
+    overlapNodes[i].second = getBroadPhaseIdentifier(overlapNodes[i].second, isTreeStatic);
+  }
+}
+
+/* Compute overlap pairs where chunks of the moved shapes are queried in parallel */
+void BroadPhase::computeOverlapPairs(MemoryStrategy& memoryStrategy, TaskScheduler& taskScheduler, DynamicArray<Pair<int32, int32>>& overlapNodes) {
   /* All colliders that have been marked as having moved in the previous frame */
-  DynamicArray<int32> shapesToTest = mShapesToTest.toArray(memoryStrategy.getFreeListMemoryHandler());
+  DynamicArray<int32> shapesToTest = mShapesToTest.toArray(memoryStrategy.getGeneralMemoryHandler());
+  const uint32 numShapesToTest = static_cast<uint32>(shapesToTest.size());
+  /* Nodes of the moved shapes of each tree, the dynamic ones being tested first */
+  DynamicArray<int32> dynamicNodes(memoryStrategy.getLinearMemoryHandler(), numShapesToTest);
+  DynamicArray<int32> staticNodes(memoryStrategy.getLinearMemoryHandler());
+
+  for(uint32 i = 0; i < numShapesToTest; i++) {
+    (isStatic(shapesToTest[i]) ? staticNodes : dynamicNodes).add(getNode(shapesToTest[i]));
+  }
+
+  const uint32 numDynamicNodes = static_cast<uint32>(dynamicNodes.size());
+  const uint32 numChunks = TaskScheduler::getNumChunks(numShapesToTest, BROAD_PHASE_TASK_GRAIN_SIZE);
+  const uint32 numThreads = taskScheduler.getNumThreads();
+  /* Each thread appends the overlapping nodes of the chunks it executes to its own array allocated from its own frame memory */
+  DynamicArray<DynamicArray<Pair<int32, int32>>> threadOverlapNodes(memoryStrategy.getLinearMemoryHandler(), numThreads);
+  DynamicArray<ChunkRange> chunks(memoryStrategy.getLinearMemoryHandler(), numChunks);
+
+  for(uint32 i = 0; i < numThreads; i++) {
+    threadOverlapNodes.emplace(memoryStrategy.getThreadLinearMemoryHandler(i));
+  }
+
+  chunks.fill(numChunks);
+
   /* Use the dynamic structure to determine all shapes which overlap with the shapes of those colliders that have moved in the previous frame */
-  mDynamicTree.getShapeShapeOverlaps(shapesToTest, 0, static_cast<uint32>(shapesToTest.size()), overlapNodes);
+  taskScheduler.parallelFor(numShapesToTest, BROAD_PHASE_TASK_GRAIN_SIZE, [this, &memoryStrategy, &dynamicNodes, &staticNodes, numDynamicNodes, &threadOverlapNodes, &chunks](uint32 begin, uint32 end, uint32 threadIndex) {
+    /* Traversal stacks come from the frame memory of the thread like the overlapping nodes */
+    LinearMemoryHandler& linearMemoryHandler = memoryStrategy.getThreadLinearMemoryHandler(threadIndex);
+    ChunkRange& chunk = chunks[begin / BROAD_PHASE_TASK_GRAIN_SIZE];
+    chunk.threadIndex = threadIndex;
+    chunk.begin = static_cast<uint32>(threadOverlapNodes[threadIndex].size());
+    /* A chunk may straddle the moved shapes of both trees */
+    const uint32 dynamicBegin = std::min(begin, numDynamicNodes);
+    const uint32 dynamicEnd = std::min(end, numDynamicNodes);
+    const uint32 staticBegin = std::max(begin, numDynamicNodes) - numDynamicNodes;
+    const uint32 staticEnd = std::max(end, numDynamicNodes) - numDynamicNodes;
+
+    /* Moved dynamic shapes may overlap with the shapes of both trees */
+    if(dynamicBegin < dynamicEnd) {
+      getOverlapNodes(linearMemoryHandler, mDynamicTree, dynamicNodes, dynamicBegin, dynamicEnd, mDynamicTree, threadOverlapNodes[threadIndex]);
+      getOverlapNodes(linearMemoryHandler, mDynamicTree, dynamicNodes, dynamicBegin, dynamicEnd, mStaticTree, threadOverlapNodes[threadIndex]);
+    }
+
+    /* Moved static shapes are never tested against each other since static bodies do not collide */
+    if(staticBegin < staticEnd) {
+      getOverlapNodes(linearMemoryHandler, mStaticTree, staticNodes, staticBegin, staticEnd, mDynamicTree, threadOverlapNodes[threadIndex]);
+    }
+
+    chunk.end = static_cast<uint32>(threadOverlapNodes[threadIndex].size());
+  });
+
+  /* Merge in chunk order so that the result does not depend on the number of threads */
+  for(uint32 i = 0; i < numChunks; i++) {
+    for(uint32 j = chunks[i].begin; j < chunks[i].end; j++) {
+      overlapNodes.add(threadOverlapNodes[chunks[i].threadIndex][j]);
+    }
+  }
+
   mShapesToTest.clear();
 }
 
@@ -128,13 +204,13 @@ bool BroadPhase::testShapesOverlap(int32 firstBroadPhaseIdentifier, int32 second
   assert(firstBroadPhaseIdentifier != -1);
   assert(secondBroadPhaseIdentifier != -1);
   /* Need to obtain the AABBs to test possible overlap in broad phase */
-  const AABB& firstAABB = mDynamicTree.getFatAABB(firstBroadPhaseIdentifier);
-  const AABB& secondAABB = mDynamicTree.getFatAABB(secondBroadPhaseIdentifier);
+  const AABB& firstAABB = getTree(firstBroadPhaseIdentifier).getFatAABB(getNode(firstBroadPhaseIdentifier));
+  const AABB& secondAABB = getTree(secondBroadPhaseIdentifier).getFatAABB(getNode(secondBroadPhaseIdentifier));
   /* Use overlap test API of the AABB */
   return firstAABB.isOverlapping(secondAABB);
 }
 
 /* Get fat AABB of the shape associated with the provided broad phase identifier */
 const AABB& BroadPhase::getFatAABB(int32 broadPhaseIdentifier) {
-  return mDynamicTree.getFatAABB(broadPhaseIdentifier);
+  return getTree(broadPhaseIdentifier).getFatAABB(getNode(broadPhaseIdentifier));
 }
\ No newline at end of file
@@ -15,6 +15,11 @@ Collider::Collider(Entity entity,
 /* Collider's representative collision shape has been changed */
 void Collider::setShapeSizeChanged(bool shapeSizeChanged) {
   mBody->mWorld.mColliderComponents.setHasSizeChanged(mEntity, shapeSizeChanged);
+
+  /* Manifolds computed for the old geometry must not be reused */
+  if(shapeSizeChanged) {
+    mBody->mWorld.mCollisionDetection.invalidateOverlapPairs(mEntity);
+  }
 }
 
 /* Get collider's identifier */
@@ -54,6 +59,8 @@ void Collider::setTransformLocalBody(const Transform& transform) {
     body->setIsSleeping(false);
   }
 
+  /* Manifolds computed for the old local transform must not be reused */
+  mBody->mWorld.mCollisionDetection.invalidateOverlapPairs(mEntity);
   /* Update the broad phase state of the collider */
   mBody->mWorld.mCollisionDetection.updateCollider(mEntity);
 }
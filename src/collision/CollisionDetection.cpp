@@ -10,17 +10,19 @@ CollisionDetection::CollisionDetection(World* world,
                                        MemoryStrategy& memoryStrategy,
                                        BodyComponents& bodyComponents,
                                        ColliderComponents& colliderComponents,
-                                       TransformComponents& transformComponents) :
+                                       TransformComponents& transformComponents,
+                                       TaskScheduler& taskScheduler) :
                                        mWorld(world),
                                        mMemoryStrategy(memoryStrategy),
                                        mBodyComponents(bodyComponents),
                                        mColliderComponents(colliderComponents),
                                        mTransformComponents(transformComponents),
-                                       mBroadPhaseOverlapNodes(mMemoryStrategy.getFreeListMemoryHandler(), 32),
+                                       mTaskScheduler(taskScheduler),
+                                       mBroadPhaseOverlapNodes(mMemoryStrategy.getGeneralMemoryHandler(), 32),
                                        mIncompatibleCollisionPairs(mMemoryStrategy.getObjectPoolMemoryHandler()),
                                        mIdentifierEntityMap(mMemoryStrategy.getObjectPoolMemoryHandler()),
                                        mAlgorithmDispatch(mMemoryStrategy.getObjectPoolMemoryHandler()),
-                                       mOverlapPairLastContactPairMap(mMemoryStrategy.getFreeListMemoryHandler()),
+                                       mOverlapPairLastContactPairMap(mMemoryStrategy.getGeneralMemoryHandler()),
                                        mContactPairsA(mMemoryStrategy.getObjectPoolMemoryHandler()),
                                        mContactPairsB(mMemoryStrategy.getObjectPoolMemoryHandler()),
                                        mLastContactPairs(&mContactPairsA),
@@ -30,6 +32,7 @@ CollisionDetection::CollisionDetection(World* world,
                                        mLastManifolds(&mManifoldsA),
                                        mCurrentManifolds(&mManifoldsB),
                                        mRawManifolds(mMemoryStrategy.getLinearMemoryHandler()),
+                                       mContactEvents(mMemoryStrategy.getGeneralMemoryHandler()),
                                        mBroadPhase(*this,
                                                     mBodyComponents, 
                                                     mColliderComponents, 
@@ -38,20 +41,25 @@ CollisionDetection::CollisionDetection(World* world,
                                                      mBodyComponents,
                                                      mColliderComponents,
                                                      mIncompatibleCollisionPairs,
-                                                     mAlgorithmDispatch),
+                                                     mAlgorithmDispatch,
+                                                     mContactEvents),
                                        mNarrowPhase(mOverlapPairs,
                                                     mMemoryStrategy.getLinearMemoryHandler()) {}
 
 /* Compute broad phase collision detection */
 void CollisionDetection::runBroadPhase() {
   assert(!mBroadPhaseOverlapNodes.size());
+  World::StepStatistics& stepStatistics = mWorld->mStepStatistics;
+  stepStatistics.numMovedShapes = mBroadPhase.getNumShapesToTest();
   /* Use dynamic tree to find all shapes overlapping with those that have moved in the previous frame */
-  mBroadPhase.computeOverlapPairs(mMemoryStrategy, mBroadPhaseOverlapNodes);
-  LOG(std::to_string(mBroadPhaseOverlapNodes.size()) + " overlapping node(s) found");
+  mBroadPhase.computeOverlapPairs(mMemoryStrategy, mTaskScheduler, mBroadPhaseOverlapNodes);
+  LOG(LogLevel::Debug, LogCategory::Collision, std::to_string(mBroadPhaseOverlapNodes.size()) + " overlapping node(s) found");
+  stepStatistics.numOverlapNodes = static_cast<uint32>(mBroadPhaseOverlapNodes.size());
   /* Create new overlap pairs */
   updateOverlapPairs(mBroadPhaseOverlapNodes);
   /* Remove overlap pairs which are not overlapping anymore */
   removeOverlapPairs();
+  stepStatistics.numOverlapPairs = static_cast<uint32>(mOverlapPairs.mPairs.size());
   mBroadPhaseOverlapNodes.clear();
 }
 
@@ -59,7 +67,9 @@ void CollisionDetection::prepareNarrowPhase(NarrowPhase& narrowPhase) {
   /* Use cache to reserve sufficient memory for the narrow phase entries */
   narrowPhase.reserve();
   const uint32 numPairs = static_cast<uint32>(mOverlapPairs.mPairs.size());
-  LOG("Retrieved " + std::to_string(numPairs) + " overlap pair(s) from broad phase");
+  LOG(LogLevel::Debug, LogCategory::Collision, "Retrieved " + std::to_string(numPairs) + " overlap pair(s) from broad phase");
+  const bool isManifoldReuseEnabled = mWorld->mSettings.isManifoldReuseEnabled;
+  const uint32 numEnabledColliderComponents = mColliderComponents.getNumEnabledComponents();
 
   for(uint32 i = 0; i < numPairs; i++) {
     OverlapPairs::OverlapPair& overlapPair = mOverlapPairs.mPairs[i];
@@ -70,34 +80,86 @@ void CollisionDetection::prepareNarrowPhase(NarrowPhase& narrowPhase) {
     const Entity secondColliderEntity = overlapPair.secondColliderEntity;
     const uint32 firstColliderIndex = mColliderComponents.getComponentEntityIndex(firstColliderEntity);
     const uint32 secondColliderIndex = mColliderComponents.getComponentEntityIndex(secondColliderEntity);
+    const bool isFirstColliderEnabled = firstColliderIndex < numEnabledColliderComponents;
+    const bool isSecondColliderEnabled = secondColliderIndex < numEnabledColliderComponents;
+
+    /* Disregard pairs whose bodies are asleep or static since none of them can move */
+    if(isFirstColliderEnabled != isSecondColliderEnabled) {
+      const Entity bodyEntity = mColliderComponents.mBodyEntities[isFirstColliderEnabled ? firstColliderIndex : secondColliderIndex];
+
+      if(mBodyComponents.getType(bodyEntity) == BodyType::Static) {
+        continue;
+      }
+    }
+    else if(!isFirstColliderEnabled) {
+      continue;
+    }
+
     Shape* firstShape = mColliderComponents.mShapes[firstColliderIndex];
     Shape* secondShape = mColliderComponents.mShapes[secondColliderIndex];
     CollisionAlgorithmType algorithmType = overlapPair.collisionAlgorithmType;
 
-    std::stringstream ss;
-    ss << " First Index: " << firstColliderEntity.getIndex() << ", Second Index: " << secondColliderEntity.getIndex() << ", Algorithm Type: " << (int)algorithmType;
-    LOG("Overlap pair " + std::to_string(i) + ss.str());
+    LOG(LogLevel::Debug, LogCategory::Collision, "Overlap pair " + std::to_string(i) + " First Index: " + std::to_string(firstColliderEntity.getIndex()) + ", Second Index: " + std::to_string(secondColliderEntity.getIndex()) + ", Algorithm Type: " + std::to_string(static_cast<int>(algorithmType)));
+
+    const Transform& firstShapeTransform = mColliderComponents.mTransformsLocalWorld[firstColliderIndex];
+    const Transform& secondShapeTransform = mColliderComponents.mTransformsLocalWorld[secondColliderIndex];
+    const Transform relativeTransform = firstShapeTransform ^ secondShapeTransform;
+
+    /* Reuse the last manifold if the shapes have barely moved relative to each other since it was computed */
+    if(isManifoldReuseEnabled && overlapPair.isLastManifoldValid && isRelativeTransformUnchanged(overlapPair.relativeTransform, relativeTransform)) {
+      narrowPhase.addReusedEntry(overlapPair.pairIdentifier,
+                                 i,
+                                 firstColliderEntity,
+                                 secondColliderEntity,
+                                 firstShape,
+                                 secondShape,
+                                 firstShapeTransform,
+                                 secondShapeTransform,
+                                 overlapPair.separatingAxis,
+                                 overlapPair.lastManifold,
+                                 overlapPair.wasColliding);
+      continue;
+    }
+
+    /* The manifold computed during this frame belongs to the current relative transform */
+    overlapPair.relativeTransform = relativeTransform;
 
     /* Add an entry for the current broadphase overlap pair into the narrow phase */
     narrowPhase.addEntry(overlapPair.pairIdentifier,
+                         i,
                          firstColliderEntity,
                          secondColliderEntity,
                          firstShape,
                          secondShape,
-                         mColliderComponents.mTransformsLocalWorld[firstColliderIndex],
-                         mColliderComponents.mTransformsLocalWorld[secondColliderIndex],
-                         mAlgorithmDispatch.getCollisionAlgorithm(algorithmType));
+                         firstShapeTransform,
+                         secondShapeTransform,
+                         algorithmType,
+                         overlapPair.separatingAxis);
   }
 }
 
+/* Query whether the relative transform of two shapes is within the manifold reuse tolerances of another one */
+bool CollisionDetection::isRelativeTransformUnchanged(const Transform& lastRelativeTransform, const Transform& relativeTransform) const {
+  const float linearTolerance = mWorld->mSettings.manifoldReuseLinearTolerance;
+  const Rotation rotation = lastRelativeTransform.getOrientation() ^ relativeTransform.getOrientation();
+
+  /* The rotation between the two transforms is compared by its sine which is close enough to the angle for small tolerances */
+  return (relativeTransform.getPosition() - lastRelativeTransform.getPosition()).lengthSquare() <= linearTolerance * linearTolerance &&
+         rotation.c > 0.0f && std::fabs(rotation.s) <= std::sin(mWorld->mSettings.manifoldReuseAngularTolerance);
+}
+
 /* Compute narrow phase collision detection */
 void CollisionDetection::runNarrowPhase() {
   /* Swap the pointers for the current and previous contact pairs and manifolds */
   exchangeFrameInfo();
+  World::StepStatistics& stepStatistics = mWorld->mStepStatistics;
+  stepStatistics.numCircleVCircleEntries = mNarrowPhase.circleVCircleBatch.size();
+  stepStatistics.numCircleVPolygonEntries = mNarrowPhase.circleVPolygonBatch.size();
+  stepStatistics.numPolygonVPolygonEntries = mNarrowPhase.polygonVPolygonBatch.size();
+  stepStatistics.numReusedEntries = mNarrowPhase.reusedBatch.size();
   /* Populate the contacts for each entry in the narrow phase input which includes creating the contact pair and populating the manifold for the pair */
   processNarrowPhase(mNarrowPhase, mCurrentContactPairs, mRawManifolds);
-  /* Link the contact pairs to their respective bodies */
-  associateContactPairs();
+  stepStatistics.numContactPairs = static_cast<uint32>(mCurrentContactPairs->size());
   assert(!mCurrentManifolds->size());
 }
 
@@ -173,13 +235,13 @@ void CollisionDetection::updateOverlapPairs(const DynamicArray<Pair<int32, int32
               /* Disregard if the two shapes cannot collide due to filtering */
               if((firstCollisionFilter & secondCollisionCategory) != 0 && (firstCollisionCategory & secondCollisionFilter) != 0) {
                 mOverlapPairs.addOverlapPair(firstColliderIndex, secondColliderIndex);
-                LOG("Overlap pair created - First Index: " + std::to_string(firstColliderEntity.getIndex()) + ", Second Index: " + std::to_string(secondColliderEntity.getIndex()) + ", Identifier: " + std::to_string(pairIdentifier));
+                LOG(LogLevel::Debug, LogCategory::Collision, "Overlap pair created - First Index: " + std::to_string(firstColliderEntity.getIndex()) + ", Second Index: " + std::to_string(secondColliderEntity.getIndex()) + ", Identifier: " + std::to_string(pairIdentifier));
               }
             }
             else {
               /* The colliders of the overlap pair still overlap so no need to test */
               overlapPair->testOverlap = false;
-              LOG("Overlap pair already created - First Index: " + std::to_string(firstColliderEntity.getIndex()) + ", Second Index: " + std::to_string(secondColliderEntity.getIndex()));
+              LOG(LogLevel::Debug, LogCategory::Collision, "Overlap pair already created - First Index: " + std::to_string(firstColliderEntity.getIndex()) + ", Second Index: " + std::to_string(secondColliderEntity.getIndex()));
             }
           }
         }
@@ -204,7 +266,7 @@ void CollisionDetection::removeOverlapPairs() {
         /* Otherwise, remove overlap pair from broad phase */
         mOverlapPairs.removeOverlapPair(i);
         i--;
-        LOG("Removed overlap pair " + std::to_string(i));
+        LOG(LogLevel::Debug, LogCategory::Collision, "Removed overlap pair " + std::to_string(i));
       }
     }
   }
@@ -240,45 +302,153 @@ void CollisionDetection::filterOverlapPairs(Entity firstBodyEntity, Entity secon
 /* Process narrow phase input */
 void CollisionDetection::processNarrowPhase(NarrowPhase& narrowPhase, DynamicArray<ContactPair>* contactPairs, DynamicArray<LocalManifold>& manifolds) {
   assert(!contactPairs->size());
-  const uint32 numNarrowPhaseEntries = static_cast<uint32>(narrowPhase.entries.size());
-  LOG("Retrieved " + std::to_string(numNarrowPhaseEntries) + " narrow phase entry(s)");
+  LinearMemoryHandler& linearMemoryHandler = mMemoryStrategy.getLinearMemoryHandler();
+  const uint32 numThreads = mTaskScheduler.getNumThreads();
+  /* Reused entries come last and have no collision algorithm to execute */
+  NarrowPhase::NarrowPhaseBatch* batches[] = {&narrowPhase.circleVCircleBatch, &narrowPhase.circleVPolygonBatch, &narrowPhase.polygonVPolygonBatch, &narrowPhase.reusedBatch};
+  const CollisionAlgorithmType algorithmTypes[] = {CollisionAlgorithmType::CircleVCircle, CollisionAlgorithmType::CircleVPolygon, CollisionAlgorithmType::PolygonVPolygon};
+  const uint32 numAlgorithmTypes = sizeof(algorithmTypes) / sizeof(algorithmTypes[0]);
+  uint32 numChunks = 0;
+
+  for(NarrowPhase::NarrowPhaseBatch* batch : batches) {
+    LOG(LogLevel::Debug, LogCategory::Collision, "Retrieved " + std::to_string(batch->size()) + " narrow phase entry(s)");
+    numChunks += TaskScheduler::getNumChunks(batch->size(), NARROW_PHASE_TASK_GRAIN_SIZE);
+  }
 
-  for(uint32 i = 0; i < numNarrowPhaseEntries; i++) {
-    LocalManifoldInfo manifoldInfo;
-    /* Debug */
-    /* Execute the appropriate narrow phase algorithm based on the types of the collision shapes */
-    narrowPhase.entries[i].algorithm->execute(narrowPhase, i, manifoldInfo);
-
-    /* Only process the result into a contact pair if the two shape have been found to be colliding (there is more than one contact point)*/
-    if(narrowPhase.entries[i].isColliding) {
-      LOG("Collision detected for narrow phase entry " + std::to_string(i) + " associated with overlap pair identifier " + std::to_string(narrowPhase.entries[i].overlapPairIdentifier));
-      const uint64 pairIdentifier = narrowPhase.entries[i].overlapPairIdentifier;
-      OverlapPairs::OverlapPair* overlapPair = mOverlapPairs.getOverlapPair(pairIdentifier);
-      assert(overlapPair);
-      const Entity firstColliderEntity = narrowPhase.entries[i].firstColliderEntity;
-      const Entity secondColliderEntity = narrowPhase.entries[i].secondColliderEntity;
-      const uint32 firstColliderIndex = mColliderComponents.getComponentEntityIndex(firstColliderEntity);
-      const uint32 secondColliderIndex = mColliderComponents.getComponentEntityIndex(secondColliderEntity);
-      const Entity firstBodyEntity = mColliderComponents.mBodyEntities[firstColliderIndex];
-      const Entity secondBodyEntity = mColliderComponents.mBodyEntities[secondColliderIndex];
-      /* Confirm that neither of the bodies involved in the contact is not disabled */
-      assert(!mWorld->mBodyComponents.getIsEntityDisabled(firstBodyEntity) || !mWorld->mBodyComponents.getIsEntityDisabled(secondBodyEntity));
+  /* Each thread appends the contact pairs and manifolds of the chunks it executes to its own arrays allocated from its own frame memory */
+  DynamicArray<DynamicArray<ContactPair>> threadContactPairs(linearMemoryHandler, numThreads);
+  DynamicArray<DynamicArray<LocalManifold>> threadManifolds(linearMemoryHandler, numThreads);
+  DynamicArray<DynamicArray<ContactEvent>> threadContactEvents(linearMemoryHandler, numThreads);
+  DynamicArray<ChunkRange> chunks(linearMemoryHandler, numChunks);
+  DynamicArray<ChunkRange> eventChunks(linearMemoryHandler, numChunks);
+
+  for(uint32 i = 0; i < numThreads; i++) {
+    threadContactPairs.emplace(mMemoryStrategy.getThreadLinearMemoryHandler(i));
+    threadManifolds.emplace(mMemoryStrategy.getThreadLinearMemoryHandler(i));
+    threadContactEvents.emplace(mMemoryStrategy.getThreadLinearMemoryHandler(i));
+  }
+
+  chunks.fill(numChunks);
+  eventChunks.fill(numChunks);
+  const bool isManifoldReuseEnabled = mWorld->mSettings.isManifoldReuseEnabled;
+  /* Only the persistent islands are updated from the contacts which started and ended */
+  const bool isContactEventEnabled = mWorld->mSettings.islandGeneration == IslandGeneration::Persistent;
+  uint32 firstChunk = 0;
+
+  for(uint32 k = 0; k < sizeof(batches) / sizeof(batches[0]); k++) {
+    NarrowPhase::NarrowPhaseBatch& batch = *batches[k];
+    CollisionAlgorithm* algorithm = k < numAlgorithmTypes ? mAlgorithmDispatch.getCollisionAlgorithm(algorithmTypes[k]) : nullptr;
+    /* Without manifold reuse only the separating axes of polygons are worth keeping */
+    const bool isResultKept = algorithm && (isManifoldReuseEnabled || algorithmTypes[k] == CollisionAlgorithmType::PolygonVPolygon);
+
+    mTaskScheduler.parallelFor(batch.size(), NARROW_PHASE_TASK_GRAIN_SIZE, [this, &batch, &threadContactPairs, &threadManifolds, &threadContactEvents, &chunks, &eventChunks, algorithm, isResultKept, isManifoldReuseEnabled, isContactEventEnabled, firstChunk](uint32 begin, uint32 end, uint32 threadIndex) {
+      if(algorithm) {
+        algorithm->executeBatch(batch, begin, end);
+      }
+
+      /* Keep the results of the collision algorithm in the overlap pairs for the next frame */
+      if(isResultKept) {
+        for(uint32 i = begin; i < end; i++) {
+          OverlapPairs::OverlapPair& overlapPair = mOverlapPairs.mPairs[batch.overlapPairIndices[i]];
+          assert(overlapPair.pairIdentifier == batch.overlapPairIdentifiers[i]);
+          overlapPair.separatingAxis = batch.separatingAxes[i];
+
+          if(isManifoldReuseEnabled) {
+            overlapPair.lastManifold = batch.manifolds[i];
+            overlapPair.wasColliding = batch.isColliding[i];
+            overlapPair.isLastManifoldValid = true;
+
+            /* Reused manifolds are warm started from the impulses of the last frame like any other manifold */
+            for(uint8 j = 0; j < overlapPair.lastManifold.numPoints; j++) {
+              overlapPair.lastManifold.points[j].normalImpulse = 0.0f;
+              overlapPair.lastManifold.points[j].tangentImpulse = 0.0f;
+            }
+          }
+        }
+      }
+
+      /* Record the contacts whose state changed since the last frame so that the islands do not have to compare every contact */
+      if(isContactEventEnabled) {
+        DynamicArray<ContactEvent>& chunkContactEvents = threadContactEvents[threadIndex];
+        ChunkRange& eventChunk = eventChunks[firstChunk + begin / NARROW_PHASE_TASK_GRAIN_SIZE];
+        eventChunk.threadIndex = threadIndex;
+        eventChunk.begin = static_cast<uint32>(chunkContactEvents.size());
+
+        for(uint32 i = begin; i < end; i++) {
+          OverlapPairs::OverlapPair& overlapPair = mOverlapPairs.mPairs[batch.overlapPairIndices[i]];
+
+          if(overlapPair.isTouching != batch.isColliding[i]) {
+            overlapPair.isTouching = batch.isColliding[i];
+            chunkContactEvents.emplace(mColliderComponents.getBodyEntity(batch.firstColliderEntities[i]),
+                                       mColliderComponents.getBodyEntity(batch.secondColliderEntities[i]),
+                                       batch.isColliding[i]);
+          }
+        }
+
+        eventChunk.end = static_cast<uint32>(chunkContactEvents.size());
+      }
+
+      DynamicArray<ContactPair>& chunkContactPairs = threadContactPairs[threadIndex];
+      DynamicArray<LocalManifold>& chunkManifolds = threadManifolds[threadIndex];
+      ChunkRange& chunk = chunks[firstChunk + begin / NARROW_PHASE_TASK_GRAIN_SIZE];
+      chunk.threadIndex = threadIndex;
+      chunk.begin = static_cast<uint32>(chunkContactPairs.size());
+
+      for(uint32 i = begin; i < end; i++) {
+        /* Only process the result into a contact pair if the two shape have been found to be colliding (there is more than one contact point)*/
+        if(batch.isColliding[i]) {
+          const uint64 pairIdentifier = batch.overlapPairIdentifiers[i];
+          assert(mOverlapPairs.getOverlapPair(pairIdentifier));
+          const Entity firstColliderEntity = batch.firstColliderEntities[i];
+          const Entity secondColliderEntity = batch.secondColliderEntities[i];
+          const uint32 firstColliderIndex = mColliderComponents.getComponentEntityIndex(firstColliderEntity);
+          const uint32 secondColliderIndex = mColliderComponents.getComponentEntityIndex(secondColliderEntity);
+          const Entity firstBodyEntity = mColliderComponents.mBodyEntities[firstColliderIndex];
+          const Entity secondBodyEntity = mColliderComponents.mBodyEntities[secondColliderIndex];
+          /* Confirm that neither of the bodies involved in the contact is not disabled */
+          assert(!mWorld->mBodyComponents.getIsEntityDisabled(firstBodyEntity) || !mWorld->mBodyComponents.getIsEntityDisabled(secondBodyEntity));
+          /* The contact pair and manifold indices are only known once the chunks are merged */
+          chunkContactPairs.emplace(pairIdentifier, 0, firstBodyEntity, secondBodyEntity, firstColliderEntity, secondColliderEntity);
+          chunkManifolds.emplace(batch.manifolds[i], firstBodyEntity, secondBodyEntity, firstColliderEntity, secondColliderEntity);
+        }
+      }
+
+      chunk.end = static_cast<uint32>(chunkContactPairs.size());
+    });
+
+    firstChunk += TaskScheduler::getNumChunks(batch.size(), NARROW_PHASE_TASK_GRAIN_SIZE);
+  }
+
+  /* Merge in chunk order so that the result does not depend on the number of threads */
+  for(uint32 i = 0; i < numChunks; i++) {
+    const ChunkRange& chunk = chunks[i];
+
+    for(uint32 j = chunk.begin; j < chunk.end; j++) {
       const uint32 newContactPairIndex = static_cast<uint32>(contactPairs->size());
-      /* Add the contact pair to the array */
-      LOG("Creating contact pair for - First Index: " + std::to_string(firstColliderEntity.getIndex()) + ", Second Index: " + std::to_string(secondColliderEntity.getIndex()));
-      contactPairs->emplace(pairIdentifier, newContactPairIndex, firstBodyEntity, secondBodyEntity, firstColliderEntity, secondColliderEntity);
       const uint32 newManifoldIndex = static_cast<uint32>(manifolds.size());
+      /* Add the contact pair to the array */
+      contactPairs->add(threadContactPairs[chunk.threadIndex][j]);
+      (*contactPairs)[newContactPairIndex].contactPairIndex = newContactPairIndex;
       /* Add the manifold for the contact pair into the array */
-      manifolds.emplace(manifoldInfo, firstBodyEntity, secondBodyEntity, firstColliderEntity, secondColliderEntity);
+      manifolds.add(threadManifolds[chunk.threadIndex][j]);
       /* Associate this manifold with the contact pair */
       (*contactPairs)[newContactPairIndex].rawManifoldsIndex = newManifoldIndex;
     }
+
+    if(isContactEventEnabled) {
+      const ChunkRange& eventChunk = eventChunks[i];
+
+      for(uint32 j = eventChunk.begin; j < eventChunk.end; j++) {
+        mContactEvents.add(threadContactEvents[eventChunk.threadIndex][j]);
+      }
+    }
   }
+
+  LOG(LogLevel::Debug, LogCategory::Collision, "Created " + std::to_string(contactPairs->size()) + " contact pair(s)");
 }
 
 /* Add the contact pairs to the appropriate bodies */
 void CollisionDetection::associateContactPairs() {
-  std::stringstream ss;
   const uint32 numCurrentContactPairs = static_cast<uint32>(mCurrentContactPairs->size());
 
   /* Add the contact pairs to both bodies of the pair so that we can create islands for contact solving */
@@ -286,13 +456,12 @@ void CollisionDetection::associateContactPairs() {
     ContactPair& contactPair = (*mCurrentContactPairs)[i];
     mBodyComponents.addContactPair(contactPair.firstBodyEntity, i);
     mBodyComponents.addContactPair(contactPair.secondBodyEntity, i);
-    ss << "Added contact pair " << i << " to bodies - First Index: " << contactPair.firstBodyEntity.getIndex() << ", Second Index: " << contactPair.secondBodyEntity.getIndex();
+    LOG(LogLevel::Debug, LogCategory::Collision, "Added contact pair " + std::to_string(i) + " to bodies - First Index: " + std::to_string(contactPair.firstBodyEntity.getIndex()) + ", Second Index: " + std::to_string(contactPair.secondBodyEntity.getIndex()));
   }
 }
 
 /* Prepare collision detection results for the contact solver */
 void CollisionDetection::prepareForContactSolver() {
-  std::stringstream ss;
   mCurrentManifolds->reserve(mCurrentContactPairs->size());
   const uint32 numContactPairs = static_cast<uint32>(mWorld->mIslandOrderedContactPairs.size());
 
@@ -304,7 +473,8 @@ void CollisionDetection::prepareForContactSolver() {
     mCurrentManifolds->add(mRawManifolds[contactPair.rawManifoldsIndex]);
   }
 
-  ss << "Current manifold count is " << mCurrentManifolds->size() << std::endl;
+  LOG(LogLevel::Debug, LogCategory::Collision, "Current manifold count is " + std::to_string(mCurrentManifolds->size()));
+  mWorld->mStepStatistics.numManifolds = static_cast<uint32>(mCurrentManifolds->size());
 
   /* Copy the impulses from the contact points of the manifolds in the previous frame */
   prepareForWarmStart();
@@ -312,6 +482,8 @@ void CollisionDetection::prepareForContactSolver() {
   mLastManifolds->clear(true);
   /* Map overlap pair to the contact pair index so that we can copy impulses for warm starting */
   populateLastContactPairMap();
+  /* Raw manifolds live in frame memory so they must not outlive the current frame */
+  mRawManifolds.clear(true);
   mNarrowPhase.clear();
 }
 
@@ -363,16 +535,27 @@ void CollisionDetection::populateLastContactPairMap() {
 /* Execute collision detection */
 void CollisionDetection::execute() {
   /* Execute broad phase collision detection */
-  runBroadPhase();
+  {
+    PROFILE_SCOPE(mWorld->mProfiler, "runBroadPhase");
+    runBroadPhase();
+  }
+
   /* Prepare for narrow phase collision detection */
-  prepareNarrowPhase(mNarrowPhase);
+  {
+    PROFILE_SCOPE(mWorld->mProfiler, "prepareNarrowPhase");
+    prepareNarrowPhase(mNarrowPhase);
+  }
+
   /* Execute narrow phase collision detection */
-  runNarrowPhase();
+  {
+    PROFILE_SCOPE(mWorld->mProfiler, "runNarrowPhase");
+    runNarrowPhase();
+  }
 }
 
 /* Add collider to the collision detection system */
 void CollisionDetection::addCollider(Collider* collider, const AABB& aabb) {
-  /* Insert the collider into the dynamic tree */
+  /* Insert the collider into broad phase */
   mBroadPhase.addCollider(collider, aabb);
   int32 broadPhaseIdentifier = mColliderComponents.getBroadPhaseIdentifier(collider->getEntity());
   assert(!mIdentifierEntityMap.contains(broadPhaseIdentifier));
@@ -393,7 +576,7 @@ void CollisionDetection::removeCollider(Collider* collider) {
   }
 
   mIdentifierEntityMap.remove(broadPhaseIdentifier);
-  /* Remove the collider from the dynamic tree */
+  /* Remove the collider from broad phase */
   mBroadPhase.removeCollider(collider);
 }
 
@@ -464,6 +647,21 @@ void CollisionDetection::notifyOverlapPairsToTest(Collider* collider) {
   }
 }
 
+/* Discard the results kept by the overlap pairs of a collider whose geometry relative to its body changed */
+void CollisionDetection::invalidateOverlapPairs(Entity colliderEntity) {
+  const DynamicArray<uint64>& overlapPairs = mColliderComponents.getOverlapPairs(colliderEntity);
+  const uint32 numOverlapPairs = static_cast<uint32>(overlapPairs.size());
+
+  for(uint32 i = 0; i < numOverlapPairs; i++) {
+    OverlapPairs::OverlapPair* overlapPair = mOverlapPairs.getOverlapPair(overlapPairs[i]);
+    assert(overlapPair);
+    /* The relative transform of the shapes may not have changed so the last manifold would otherwise be reused */
+    overlapPair->isLastManifoldValid = false;
+    /* The edges of a resized polygon may not match the kept axis anymore */
+    overlapPair->separatingAxis = SeparatingAxis();
+  }
+}
+
 /* Get collision algorithm dispatch */
 AlgorithmDispatch& CollisionDetection::getAlgorithmDispatch() {
   return mAlgorithmDispatch;
@@ -73,7 +73,7 @@ int32 DynamicTree::createNode() {
     mMemoryHandler.free(nodesPrev, static_cast<size_t>(numAllocatedNodesPrev) * sizeof(Node));
 
     /* Initialize newly allocated nodes */
-    for(int32 i = mNumNodes; i < mNumAllocatedNodes - 1; i++) {
+    for(int32 i = mNumNodes; i < mNumAllocatedNodes; i++) {
       new (mNodes + i) Node();
       
       if(i == mNumAllocatedNodes - 1) {
@@ -95,7 +95,7 @@ int32 DynamicTree::createNode() {
   mNodes[free].parent = NULL_NODE;
   mNodes[free].height = LEAF_HEIGHT;
   mNumNodes++;
-  LOG("The dynamic tree currently contains " + std::to_string(mNumNodes) + " node(s)");
+  LOG(LogLevel::Debug, LogCategory::Collision, "The dynamic tree currently contains " + std::to_string(mNumNodes) + " node(s)");
   return free;
 }
 
@@ -108,7 +108,7 @@ void DynamicTree::extractNode(int32 node) {
   mNodes[node].height = FREE_NODE_HEIGHT;
   mFree = node;
   mNumNodes--;
-  LOG("The dynamic tree currently contains " + std::to_string(mNumNodes) + " node(s)");
+  LOG(LogLevel::Debug, LogCategory::Collision, "The dynamic tree currently contains " + std::to_string(mNumNodes) + " node(s)");
 }
 
 /* Insert a node as a leaf in the tree */
@@ -518,14 +518,24 @@ bool DynamicTree::update(int32 node, const AABB& aabb, bool forceInsert) {
   return true;
 }
 
-/* Get all of the shapes that are overlapping with the provided test shapes */
-void DynamicTree::getShapeShapeOverlaps(const DynamicArray<int32>& testNodes, uint32 begin, uint32 end, DynamicArray<Pair<int32, int32>>& overlappingNodes) const {
-  /* Stack of nodes to visit in tree traversal */
-  Stack<int32> stack(mMemoryHandler);
+/* Get all of the shapes that are overlapping with the provided test shapes, the traversal stack being allocated from the provided memory handler */
+void DynamicTree::getShapeShapeOverlaps(MemoryHandler& memoryHandler, const DynamicArray<int32>& testNodes, uint32 begin, uint32 end, DynamicArray<Pair<int32, int32>>& overlappingNodes) const {
+  getShapeShapeOverlaps(memoryHandler, *this, testNodes, begin, end, overlappingNodes);
+}
+
+/* Get all of the shapes that are overlapping with the provided test shapes of another tree, the traversal stack being allocated from the provided memory handler */
+void DynamicTree::getShapeShapeOverlaps(MemoryHandler& memoryHandler, const DynamicTree& testTree, const DynamicArray<int32>& testNodes, uint32 begin, uint32 end, DynamicArray<Pair<int32, int32>>& overlappingNodes) const {
+  /* Nothing can overlap with the shapes of an empty tree */
+  if(mRoot == NULL_NODE) {
+    return;
+  }
+
+  /* Stack of nodes to visit in tree traversal, queries running in parallel must not share a memory handler which locks */
+  Stack<int32> stack(memoryHandler);
 
   for(uint32 i = begin; i < end; i++) {
     stack.push(mRoot);
-    const AABB& testAABB = getFatAABB(testNodes[i]);
+    const AABB& testAABB = testTree.getFatAABB(testNodes[i]);
 
     /* There are still nodes to be visited */
     while(!stack.empty()) {
@@ -559,8 +569,13 @@ void DynamicTree::getShapeShapeOverlaps(const DynamicArray<int32>& testNodes, ui
 
 /* Get all of the shapes that are overlapping with the provided AABB */
 void DynamicTree::getShapeAABBOverlap(const AABB& aabb, DynamicArray<int32>& overlappingNodes) const {
+  getShapeAABBOverlap(mMemoryHandler, aabb, overlappingNodes);
+}
+
+/* Get all of the shapes that are overlapping with the provided AABB, the traversal stack being allocated from the provided memory handler */
+void DynamicTree::getShapeAABBOverlap(MemoryHandler& memoryHandler, const AABB& aabb, DynamicArray<int32>& overlappingNodes) const {
   /* Stack of nodes to visit in tree traversal */
-  Stack<int32> stack(mMemoryHandler);
+  Stack<int32> stack(memoryHandler);
   stack.push(mRoot);
 
   /* There are still nodes to be visited */
@@ -1,46 +1,177 @@
 #include <physics/collision/NarrowPhase.h>
+#include <physics/collision/algorithms/AlgorithmDispatch.h>
 
 using namespace physics;
 
 /* Constructor */
-NarrowPhase::NarrowPhase(OverlapPairs& overlapPairs, MemoryHandler& memoryHandler) : mOverlapPairs(overlapPairs), mMemoryHandler(memoryHandler), entries(memoryHandler) {}
+NarrowPhase::NarrowPhaseBatch::NarrowPhaseBatch(MemoryHandler& memoryHandler) :
+                                                mCachedCapacity(0),
+                                                overlapPairIdentifiers(memoryHandler),
+                                                overlapPairIndices(memoryHandler),
+                                                firstColliderEntities(memoryHandler),
+                                                secondColliderEntities(memoryHandler),
+                                                firstShapes(memoryHandler),
+                                                secondShapes(memoryHandler),
+                                                firstShapeTransforms(memoryHandler),
+                                                secondShapeTransforms(memoryHandler),
+                                                manifolds(memoryHandler),
+                                                isColliding(memoryHandler),
+                                                separatingAxes(memoryHandler) {}
+
+/* Add an entry */
+void NarrowPhase::NarrowPhaseBatch::add(uint64 overlapPairIdentifier,
+                                        uint32 overlapPairIndex,
+                                        Entity firstColliderEntity,
+                                        Entity secondColliderEntity,
+                                        Shape* firstShape,
+                                        Shape* secondShape,
+                                        const Transform& firstShapeTransform,
+                                        const Transform& secondShapeTransform,
+                                        const SeparatingAxis& separatingAxis) {
+  overlapPairIdentifiers.add(overlapPairIdentifier);
+  overlapPairIndices.add(overlapPairIndex);
+  firstColliderEntities.add(firstColliderEntity);
+  secondColliderEntities.add(secondColliderEntity);
+  firstShapes.add(firstShape);
+  secondShapes.add(secondShape);
+  firstShapeTransforms.add(firstShapeTransform);
+  secondShapeTransforms.add(secondShapeTransform);
+  manifolds.add(LocalManifoldInfo());
+  isColliding.add(false);
+  separatingAxes.add(separatingAxis);
+}
+
+/* Initialize using cached capacity */
+void NarrowPhase::NarrowPhaseBatch::reserve() {
+  overlapPairIdentifiers.reserve(mCachedCapacity);
+  overlapPairIndices.reserve(mCachedCapacity);
+  firstColliderEntities.reserve(mCachedCapacity);
+  secondColliderEntities.reserve(mCachedCapacity);
+  firstShapes.reserve(mCachedCapacity);
+  secondShapes.reserve(mCachedCapacity);
+  firstShapeTransforms.reserve(mCachedCapacity);
+  secondShapeTransforms.reserve(mCachedCapacity);
+  manifolds.reserve(mCachedCapacity);
+  isColliding.reserve(mCachedCapacity);
+  separatingAxes.reserve(mCachedCapacity);
+}
+
+/* Clear all entries */
+void NarrowPhase::NarrowPhaseBatch::clear() {
+  /* Cached capacity to reserve memory for the next frame */
+  mCachedCapacity = static_cast<uint32>(overlapPairIdentifiers.capacity());
+  overlapPairIdentifiers.clear(true);
+  overlapPairIndices.clear(true);
+  firstColliderEntities.clear(true);
+  secondColliderEntities.clear(true);
+  firstShapes.clear(true);
+  secondShapes.clear(true);
+  firstShapeTransforms.clear(true);
+  secondShapeTransforms.clear(true);
+  manifolds.clear(true);
+  isColliding.clear(true);
+  separatingAxes.clear(true);
+}
+
+/* Constructor */
+NarrowPhase::NarrowPhase(OverlapPairs& overlapPairs, MemoryHandler& memoryHandler) :
+                         mMemoryHandler(memoryHandler),
+                         mOverlapPairs(overlapPairs),
+                         circleVCircleBatch(memoryHandler),
+                         circleVPolygonBatch(memoryHandler),
+                         polygonVPolygonBatch(memoryHandler),
+                         reusedBatch(memoryHandler) {}
 
 /* Destructor */
 NarrowPhase::~NarrowPhase() {
   clear();
 }
 
+/* Get the narrow phase entries of a collision algorithm */
+NarrowPhase::NarrowPhaseBatch& NarrowPhase::getBatch(CollisionAlgorithmType algorithmType) {
+  if(algorithmType == CollisionAlgorithmType::CircleVCircle) {
+    return circleVCircleBatch;
+  }
+
+  if(algorithmType == CollisionAlgorithmType::CircleVPolygon) {
+    return circleVPolygonBatch;
+  }
+
+  assert(algorithmType == CollisionAlgorithmType::PolygonVPolygon);
+  return polygonVPolygonBatch;
+}
+
+/* Add narrow phase entry to a batch */
+void NarrowPhase::addBatchEntry(NarrowPhaseBatch& batch,
+                                uint64 overlapPairIdentifier,
+                                uint32 overlapPairIndex,
+                                Entity firstColliderEntity,
+                                Entity secondColliderEntity,
+                                Shape* firstShape,
+                                Shape* secondShape,
+                                const Transform& firstShapeTransform,
+                                const Transform& secondShapeTransform,
+                                const SeparatingAxis& separatingAxis) {
+  ShapeType firstType = firstShape->getType();
+  ShapeType secondType = secondShape->getType();
+
+  /* Order entry such that the shapes are reversed relative to their order within the shape type enum */
+  /* The order only depends on the shape types so the separating axis and manifold of the pair keep referring to the same shapes across frames */
+  batch.add(overlapPairIdentifier,
+            overlapPairIndex,
+            firstType <= secondType ? secondColliderEntity : firstColliderEntity,
+            firstType <= secondType ? firstColliderEntity : secondColliderEntity,
+            firstType <= secondType ? secondShape : firstShape,
+            firstType <= secondType ? firstShape : secondShape,
+            firstType <= secondType ? secondShapeTransform : firstShapeTransform,
+            firstType <= secondType ? firstShapeTransform : secondShapeTransform,
+            separatingAxis);
+}
+
 /* Add narrow phase entry */
 void NarrowPhase::addEntry(uint64 overlapPairIdentifier,
+                           uint32 overlapPairIndex,
                            Entity firstColliderEntity,
                            Entity secondColliderEntity,
                            Shape* firstShape,
                            Shape* secondShape,
                            const Transform& firstShapeTransform,
                            const Transform& secondShapeTransform,
-                           CollisionAlgorithm* algorithm) {
-  ShapeType firstType = firstShape->getType();
-  ShapeType secondType = secondShape->getType();
+                           CollisionAlgorithmType algorithmType,
+                           const SeparatingAxis& separatingAxis) {
+  addBatchEntry(getBatch(algorithmType), overlapPairIdentifier, overlapPairIndex, firstColliderEntity, secondColliderEntity, firstShape, secondShape, firstShapeTransform, secondShapeTransform, separatingAxis);
+}
 
-  /* Order entry such that the shapes are reversed relative to their order within the shape type enum */
-  entries.emplace(overlapPairIdentifier,
-                  firstType <= secondType ? secondColliderEntity : firstColliderEntity,
-                  firstType <= secondType ? firstColliderEntity : secondColliderEntity,
-                  firstType <= secondType ? secondShape : firstShape,
-                  firstType <= secondType ? firstShape : secondShape,
-                  firstType <= secondType ? secondShapeTransform : firstShapeTransform,
-                  firstType <= secondType ? firstShapeTransform : secondShapeTransform,
-                  algorithm);
+/* Add narrow phase entry whose last manifold is reused */
+void NarrowPhase::addReusedEntry(uint64 overlapPairIdentifier,
+                                 uint32 overlapPairIndex,
+                                 Entity firstColliderEntity,
+                                 Entity secondColliderEntity,
+                                 Shape* firstShape,
+                                 Shape* secondShape,
+                                 const Transform& firstShapeTransform,
+                                 const Transform& secondShapeTransform,
+                                 const SeparatingAxis& separatingAxis,
+                                 const LocalManifoldInfo& manifold,
+                                 bool isColliding) {
+  addBatchEntry(reusedBatch, overlapPairIdentifier, overlapPairIndex, firstColliderEntity, secondColliderEntity, firstShape, secondShape, firstShapeTransform, secondShapeTransform, separatingAxis);
+  const uint32 entryIndex = reusedBatch.size() - 1;
+  reusedBatch.manifolds[entryIndex] = manifold;
+  reusedBatch.isColliding[entryIndex] = isColliding;
 }
 
 /* Initialize using cached capacity */
 void NarrowPhase::reserve() {
-  entries.reserve(mCachedCapacity);
+  circleVCircleBatch.reserve();
+  circleVPolygonBatch.reserve();
+  polygonVPolygonBatch.reserve();
+  reusedBatch.reserve();
 }
 
 /* Clear all entries */
 void NarrowPhase::clear() {
-  /* Cached capacity to reserve memory for the next frame */
-  mCachedCapacity = static_cast<uint32>(entries.capacity());
-  entries.clear(true);
-}
\ No newline at end of file
+  circleVCircleBatch.clear();
+  circleVPolygonBatch.clear();
+  polygonVPolygonBatch.clear();
+  reusedBatch.clear();
+}
@@ -8,15 +8,17 @@ OverlapPairs::OverlapPairs(MemoryStrategy& memoryStrategy,
                            BodyComponents& bodyComponents,
                            ColliderComponents& colliderComponents,
                            Set<Pair<Entity, Entity>>& incompatibleCollisionPairs,
-                           AlgorithmDispatch& algorithmDispatch) :
+                           AlgorithmDispatch& algorithmDispatch,
+                           DynamicArray<ContactEvent>& contactEvents) :
                            mPoolHandler(memoryStrategy.getObjectPoolMemoryHandler()),
-                           mFreeListHandler(memoryStrategy.getFreeListMemoryHandler()),
-                           mPairs(memoryStrategy.getFreeListMemoryHandler()),
-                           mPairIdentifierArrayIndexMap(memoryStrategy.getFreeListMemoryHandler()),
+                           mFreeListHandler(memoryStrategy.getGeneralMemoryHandler()),
+                           mPairs(memoryStrategy.getGeneralMemoryHandler()),
+                           mPairIdentifierArrayIndexMap(memoryStrategy.getGeneralMemoryHandler()),
                            mBodyComponents(bodyComponents),
                            mColliderComponents(colliderComponents),
                            mIncompatibleCollisionPairs(incompatibleCollisionPairs),
-                           mAlgorithmDispatch(algorithmDispatch) {}
+                           mAlgorithmDispatch(algorithmDispatch),
+                           mContactEvents(contactEvents) {}
 
 /* Destructor */
 OverlapPairs::~OverlapPairs() {
@@ -73,6 +75,11 @@ void OverlapPairs::removeOverlapPair(uint64 pairIndex) {
   assert(mColliderComponents.getOverlapPairs(mPairs[pairIndex].secondColliderEntity).find(mPairs[pairIndex].pairIdentifier) != mColliderComponents.getOverlapPairs(mPairs[pairIndex].secondColliderEntity).end());
   assert(mPairIdentifierArrayIndexMap[mPairs[pairIndex].pairIdentifier] == pairIndex);
 
+  /* A pair which is removed while its shapes touch ends its contact without the narrow phase seeing it */
+  if(mPairs[pairIndex].isTouching) {
+    mContactEvents.emplace(mColliderComponents.getBodyEntity(mPairs[pairIndex].firstColliderEntity), mColliderComponents.getBodyEntity(mPairs[pairIndex].secondColliderEntity), false);
+  }
+
   /* Remove index from overlap pairs arrays and map */
   mColliderComponents.getOverlapPairs(mPairs[pairIndex].firstColliderEntity).remove(mPairs[pairIndex].pairIdentifier);
   mColliderComponents.getOverlapPairs(mPairs[pairIndex].secondColliderEntity).remove(mPairs[pairIndex].pairIdentifier);
@@ -59,12 +59,26 @@ void PolygonShape::set(const Hull& hull) {
     mNormals[i].normalize();
   }
 
+  packVertices();
   /* Bulk compute the geometric properties of the shape */
   computeGeometricProperties();
   /* Alert broad phase that the geometry of the collision shape has changed */
   alertSizeChange();
 }
 
+/* Copy the vertices and normals into their padded per component layout */
+void PolygonShape::packVertices() {
+  assert(mNumVertices >= MIN_POLYGON_VERTICES && mNumVertices <= MAX_POLYGON_VERTICES);
+
+  for(uint32 i = 0; i < MAX_POLYGON_VERTICES; i++) {
+    uint32 index = i < mNumVertices ? i : 0;
+    mVerticesX[i] = mVertices[index].x;
+    mVerticesY[i] = mVertices[index].y;
+    mNormalsX[i] = mNormals[index].x;
+    mNormalsY[i] = mNormals[index].y;
+  }
+}
+
 /* https://www.youtube.com/watch?v=uFDTxRv7O8M */
 /* https://en.wikipedia.org/wiki/Moment_of_inertia#Calculating_moment_of_inertia_about_an_axis */
 /* https://www.youtube.com/watch?v=lCKxeRiBdjQ&t=496s */
@@ -3,16 +3,28 @@
 
 using namespace physics;
 
-/* Execute the collision algorithm */
-void CircleVCircleAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryIndex, LocalManifoldInfo& manifold) {
-  LOG("Executing Circle-Circle algorithm");
+/* Populate the manifold of a colliding entry of a narrow phase batch */
+void CircleVCircleAlgorithm::populateManifold(NarrowPhase::NarrowPhaseBatch& batch, uint32 entryIndex) {
+  LocalManifoldInfo& manifold = batch.manifolds[entryIndex];
+  /* Populate the local manifold with the relevant collision info for the contact solver */
+  manifold.type = LocalManifoldInfo::ManifoldType::Circles;
+  manifold.localPoint = batch.firstShapes[entryIndex]->getCentroid();
+  manifold.localNormal = Vector2::getZeroVector();
+  manifold.numPoints = 1;
+  manifold.points[0].localPoint = batch.secondShapes[entryIndex]->getCentroid();
+  manifold.points[0].info.key = 0;
+  batch.isColliding[entryIndex] = true;
+}
+
+/* Execute the collision algorithm on a single entry of a narrow phase batch */
+void CircleVCircleAlgorithm::execute(NarrowPhase::NarrowPhaseBatch& batch, uint32 entryIndex) {
   /* Extract prerequisite information from the narrow phase input */
-  assert(!narrowPhase.entries[entryIndex].isColliding);
-  const Transform& firstTransform = narrowPhase.entries[entryIndex].firstShapeTransform;
-  const Transform& secondTransform = narrowPhase.entries[entryIndex].secondShapeTransform;
-  const Shape* firstShape = narrowPhase.entries[entryIndex].firstShape;
-  const Shape* secondShape = narrowPhase.entries[entryIndex].secondShape;
-  manifold.numPoints = 0;
+  assert(!batch.isColliding[entryIndex]);
+  const Transform& firstTransform = batch.firstShapeTransforms[entryIndex];
+  const Transform& secondTransform = batch.secondShapeTransforms[entryIndex];
+  const Shape* firstShape = batch.firstShapes[entryIndex];
+  const Shape* secondShape = batch.secondShapes[entryIndex];
+  batch.manifolds[entryIndex].numPoints = 0;
 
   Vector2 pA = firstTransform * firstShape->getCentroid();
   Vector2 pB = secondTransform * secondShape->getCentroid();
@@ -27,12 +39,50 @@ void CircleVCircleAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryIndex
     return;
   }
 
-  /* Populate the local manifold with the relevant collision info for the contact solver */
-  manifold.type = LocalManifoldInfo::ManifoldType::Circles;
-  manifold.localPoint = firstShape->getCentroid();
-  manifold.localNormal = Vector2::getZeroVector();
-  manifold.numPoints = 1;
-  manifold.points[0].localPoint = secondShape->getCentroid();
-  manifold.points[0].info.key = 0;
-  narrowPhase.entries[entryIndex].isColliding = true;
-}
\ No newline at end of file
+  populateManifold(batch, entryIndex);
+}
+
+/* Execute the collision algorithm on the entries [begin, end) of a narrow phase batch */
+void CircleVCircleAlgorithm::executeBatch(NarrowPhase::NarrowPhaseBatch& batch, uint32 begin, uint32 end) {
+  /* World space centers and combined radii of SIMD_WIDTH entries packed lane by lane */
+  float firstCentersX[SIMD_WIDTH];
+  float firstCentersY[SIMD_WIDTH];
+  float secondCentersX[SIMD_WIDTH];
+  float secondCentersY[SIMD_WIDTH];
+  float radii[SIMD_WIDTH];
+
+  for(uint32 i = begin; i < end; i += SIMD_WIDTH) {
+    const uint32 numLanes = end - i < SIMD_WIDTH ? end - i : SIMD_WIDTH;
+
+    for(uint32 j = 0; j < SIMD_WIDTH; j++) {
+      /* Lanes past the end of the range are masked out below */
+      if(j >= numLanes) {
+        firstCentersX[j] = firstCentersY[j] = secondCentersX[j] = secondCentersY[j] = radii[j] = 0.0f;
+        continue;
+      }
+
+      const uint32 entryIndex = i + j;
+      assert(!batch.isColliding[entryIndex]);
+      const Vector2 pA = batch.firstShapeTransforms[entryIndex] * batch.firstShapes[entryIndex]->getCentroid();
+      const Vector2 pB = batch.secondShapeTransforms[entryIndex] * batch.secondShapes[entryIndex]->getCentroid();
+      firstCentersX[j] = pA.x;
+      firstCentersY[j] = pA.y;
+      secondCentersX[j] = pB.x;
+      secondCentersY[j] = pB.y;
+      radii[j] = batch.firstShapes[entryIndex]->getRadius() + batch.secondShapes[entryIndex]->getRadius();
+      batch.manifolds[entryIndex].numPoints = 0;
+    }
+
+    /* Same operations in the same order as the scalar test so that both agree on every pair */
+    const SimdVector2 displacement = {simdLoad(secondCentersX) - simdLoad(firstCentersX), simdLoad(secondCentersY) - simdLoad(firstCentersY)};
+    const SimdFloat radius = simdLoad(radii);
+    const uint32 collidingLanes = simdMask(simdGreaterEqual(radius * radius, dot(displacement, displacement))) & ((1u << numLanes) - 1);
+
+    /* Only the colliding pairs produce a manifold */
+    for(uint32 j = 0; j < numLanes; j++) {
+      if(collidingLanes & (1u << j)) {
+        populateManifold(batch, i + j);
+      }
+    }
+  }
+}
@@ -3,15 +3,15 @@
 
 using namespace physics;
 
-/* Execute the collision algorithm */
-void CircleVPolygonAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryIndex, LocalManifoldInfo& manifold) {
-  LOG("Executing Circle-Polygon algorithm");
+/* Execute the collision algorithm on a single entry of a narrow phase batch */
+void CircleVPolygonAlgorithm::execute(NarrowPhase::NarrowPhaseBatch& batch, uint32 entryIndex) {
   /* Extract prerequisite information from the narrow phase input */
-  assert(!narrowPhase.entries[entryIndex].isColliding);
-  const Transform& firstTransform = narrowPhase.entries[entryIndex].firstShapeTransform;
-  const Transform& secondTransform = narrowPhase.entries[entryIndex].secondShapeTransform;
-  const PolygonShape* firstShape = dynamic_cast<PolygonShape*>(narrowPhase.entries[entryIndex].firstShape);
-  const CircleShape* secondShape = dynamic_cast<CircleShape*>(narrowPhase.entries[entryIndex].secondShape);
+  assert(!batch.isColliding[entryIndex]);
+  LocalManifoldInfo& manifold = batch.manifolds[entryIndex];
+  const Transform& firstTransform = batch.firstShapeTransforms[entryIndex];
+  const Transform& secondTransform = batch.secondShapeTransforms[entryIndex];
+  const PolygonShape* firstShape = static_cast<const PolygonShape*>(batch.firstShapes[entryIndex]);
+  const CircleShape* secondShape = static_cast<const CircleShape*>(batch.secondShapes[entryIndex]);
   manifold.numPoints = 0;
 
   /* Transform the circle's position to the polygon's frame of reference */
@@ -55,7 +55,7 @@ void CircleVPolygonAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryInde
     manifold.localPoint = 0.5f * (firstVertex + secondVertex);
     manifold.points[0].localPoint = secondShape->getCentroid();
     manifold.points[0].info.key = 0;
-    narrowPhase.entries[entryIndex].isColliding = true;
+    batch.isColliding[entryIndex] = true;
     return;
   }
 
@@ -76,7 +76,7 @@ void CircleVPolygonAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryInde
     manifold.localPoint = firstVertex;
     manifold.points[0].localPoint = secondShape->getCentroid();
     manifold.points[0].info.key = 0;
-    narrowPhase.entries[entryIndex].isColliding = true;
+    batch.isColliding[entryIndex] = true;
   }
   else if(u2 <= 0.0f) {
     if(cLocal.distanceSquare(secondVertex) > square(radius)) {
@@ -91,7 +91,7 @@ void CircleVPolygonAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryInde
     manifold.localPoint = secondVertex;
     manifold.points[0].localPoint = secondShape->getCentroid();
     manifold.points[0].info.key = 0;
-    narrowPhase.entries[entryIndex].isColliding = true;
+    batch.isColliding[entryIndex] = true;
   }
   else {
     Vector2 faceCenter = 0.5f * (firstVertex + secondVertex);
@@ -108,6 +108,13 @@ void CircleVPolygonAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryInde
     manifold.localPoint = faceCenter;
     manifold.points[0].localPoint = secondShape->getCentroid();
     manifold.points[0].info.key = 0;
-    narrowPhase.entries[entryIndex].isColliding = true;
+    batch.isColliding[entryIndex] = true;
+  }
+}
+
+/* Execute the collision algorithm on the entries [begin, end) of a narrow phase batch */
+void CircleVPolygonAlgorithm::executeBatch(NarrowPhase::NarrowPhaseBatch& batch, uint32 begin, uint32 end) {
+  for(uint32 i = begin; i < end; i++) {
+    execute(batch, i);
   }
 }
\ No newline at end of file
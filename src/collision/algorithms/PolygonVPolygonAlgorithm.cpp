@@ -3,35 +3,77 @@
 
 using namespace physics;
 
+/* Get the separation between the two polygons along a single edge normal of the first polygon */
+float PolygonVPolygonAlgorithm::getEdgeSeparation(const PolygonShape* firstShape, const PolygonShape* secondShape, const Transform& firstTransform, const Transform& secondTransform, uint32 edgeIndex) {
+  assert(edgeIndex < firstShape->getNumVertices());
+  uint32 secondNumVertices = secondShape->getNumVertices();
+  const Vector2* secondVertices = secondShape->mVertices;
+  Transform transform = secondTransform ^ firstTransform;
+
+  /* Transform the normal of the first polygon to the frame of the second polygon */
+  Vector2 normal = transform.getOrientation() * firstShape->mNormals[edgeIndex];
+  Vector2 firstVertex = transform * firstShape->mVertices[edgeIndex];
+  float separation = FLOAT_LARGEST;
+
+  /* Find the deepest point for the normal */
+  for(uint32 i = 0; i < secondNumVertices; i++) {
+    float vertexSeparation = dot(normal, secondVertices[i] - firstVertex);
+
+    if(vertexSeparation < separation) {
+      separation = vertexSeparation;
+    }
+  }
+
+  return separation;
+}
+
 /* Get the maximum separation between the two polygons using the edge normals of the first polygon */
 float PolygonVPolygonAlgorithm::getMaxSeparation(const PolygonShape* firstShape, const PolygonShape* secondShape, const Transform& firstTransform, const Transform& secondTransform, uint32* edgeIndex) {
+  static_assert(MAX_POLYGON_VERTICES % SIMD_WIDTH == 0, "Padded polygon vertices must fill whole SIMD registers");
   uint32 firstNumVertices = firstShape->getNumVertices();
   uint32 secondNumVertices = secondShape->getNumVertices();
-  const Vector2* firstNormals = firstShape->mNormals;
-  const Vector2* firstVertices = firstShape->mVertices;
   const Vector2* secondVertices = secondShape->mVertices;
   Transform transform = secondTransform ^ firstTransform;
+  const SimdFloat s = simdSet(transform.getOrientation().s);
+  const SimdFloat c = simdSet(transform.getOrientation().c);
+  const SimdFloat positionX = simdSet(transform.getPosition().x);
+  const SimdFloat positionY = simdSet(transform.getPosition().y);
+  float separations[MAX_POLYGON_VERTICES];
+
+  /* Each lane holds one edge normal of the first polygon so that the support distances of all normals are found at once */
+  for(uint32 i = 0; i < firstNumVertices; i += SIMD_WIDTH) {
+    const SimdFloat firstNormalX = simdLoad(firstShape->mNormalsX + i);
+    const SimdFloat firstNormalY = simdLoad(firstShape->mNormalsY + i);
+    const SimdFloat firstVertexX = simdLoad(firstShape->mVerticesX + i);
+    const SimdFloat firstVertexY = simdLoad(firstShape->mVerticesY + i);
+
+    /* Transform the normals and vertices of the first polygon to the frame of the second polygon */
+    SimdVector2 normal;
+    normal.x = c * firstNormalX - s * firstNormalY;
+    normal.y = s * firstNormalX + c * firstNormalY;
+    SimdVector2 firstVertex;
+    firstVertex.x = (c * firstVertexX - s * firstVertexY) + positionX;
+    firstVertex.y = (s * firstVertexX + c * firstVertexY) + positionY;
+    SimdFloat separation = simdSet(FLOAT_LARGEST);
+
+    /* Find the deepest point for every normal among every vertex of the second polygon, whose count differs from the first one */
+    for(uint32 j = 0; j < secondNumVertices; j++) {
+      SimdVector2 difference;
+      difference.x = simdSet(secondVertices[j].x) - firstVertex.x;
+      difference.y = simdSet(secondVertices[j].y) - firstVertex.y;
+      separation = simdMin(dot(normal, difference), separation);
+    }
+
+    simdStore(separations + i, separation);
+  }
 
   uint32 bestIndex = 0;
   float maxSeparation = -FLOAT_LARGEST;
 
+  /* Scanning in edge order keeps the first of several equally separating edges */
   for(uint32 i = 0; i < firstNumVertices; i++) {
-    /* Transform the normal of the first polygon to the frame of the second polygon */
-    Vector2 normal = transform.getOrientation() * firstNormals[i];
-    Vector2 firstVertex = transform * firstVertices[i];
-    float firstSeparation = FLOAT_LARGEST;
-
-    /* Find the deepest point for the ith normal */
-    for(uint32 j = 0; i < secondNumVertices; j++) {
-      float secondSeparation = dot(normal, secondVertices[j] - firstVertex);
-
-      if(secondSeparation < firstSeparation) {
-        firstSeparation = secondSeparation;
-      }
-    }
-
-    if(firstSeparation > maxSeparation) {
-      maxSeparation = firstSeparation;
+    if(separations[i] > maxSeparation) {
+      maxSeparation = separations[i];
       bestIndex = i;
     }
   }
@@ -48,8 +90,8 @@ void PolygonVPolygonAlgorithm::getIncidentEdge(const PolygonShape* firstShape, c
   const Vector2* secondNormals = secondShape->mNormals;
   assert(0 <= firstEdge && firstEdge < firstShape->getNumVertices());
 
-  /* Transform the normal of the reference edge to the frame of the second polygon */
-  Vector2 firstNormal = secondTransform ^ (firstTransform.getOrientation() * firstNormals[firstEdge]);
+  /* Transform the normal of the reference edge to the frame of the second polygon, as a direction which only rotates */
+  Vector2 firstNormal = secondTransform.getOrientation() ^ (firstTransform.getOrientation() * firstNormals[firstEdge]);
 
   /* Find the incident edge on the second polygon */
   uint32 index = 0;
@@ -117,22 +159,37 @@ uint32 PolygonVPolygonAlgorithm::clipToLine(const ClipVertex verticesInput[MAX_M
   return numPoints;
 }
 
-/* Execute the collision algorithm */
-void PolygonVPolygonAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryIndex, LocalManifoldInfo& manifold) {
-  LOG("Executing Polygon-Polygon algorithm");
+/* Execute the collision algorithm on a single entry of a narrow phase batch */
+void PolygonVPolygonAlgorithm::execute(NarrowPhase::NarrowPhaseBatch& batch, uint32 entryIndex) {
   /* Extract prerequisite information from the narrow phase input */
-  assert(!narrowPhase.entries[entryIndex].isColliding);
-  const Transform& firstTransform = narrowPhase.entries[entryIndex].firstShapeTransform;
-  const Transform& secondTransform = narrowPhase.entries[entryIndex].secondShapeTransform;
-  const PolygonShape* firstShape = dynamic_cast<PolygonShape*>(narrowPhase.entries[entryIndex].firstShape);
-  const PolygonShape* secondShape = dynamic_cast<PolygonShape*>(narrowPhase.entries[entryIndex].secondShape);
+  assert(!batch.isColliding[entryIndex]);
+  LocalManifoldInfo& manifold = batch.manifolds[entryIndex];
+  const Transform& firstTransform = batch.firstShapeTransforms[entryIndex];
+  const Transform& secondTransform = batch.secondShapeTransforms[entryIndex];
+  const PolygonShape* firstShape = static_cast<const PolygonShape*>(batch.firstShapes[entryIndex]);
+  const PolygonShape* secondShape = static_cast<const PolygonShape*>(batch.secondShapes[entryIndex]);
+  SeparatingAxis& separatingAxis = batch.separatingAxes[entryIndex];
   manifold.numPoints = 0;
 
   float radius = firstShape->getRadius() + secondShape->getRadius();
+
+  /* Resting and near miss pairs tend to be separated by the same axis as during the last frame so that axis is tested before any search */
+  if(separatingAxis.owner == SeparatingAxis::Owner::FirstShape && separatingAxis.edge < firstShape->getNumVertices()) {
+    if(getEdgeSeparation(firstShape, secondShape, firstTransform, secondTransform, separatingAxis.edge) > radius) {
+      return;
+    }
+  }
+  else if(separatingAxis.owner == SeparatingAxis::Owner::SecondShape && separatingAxis.edge < secondShape->getNumVertices()) {
+    if(getEdgeSeparation(secondShape, firstShape, secondTransform, firstTransform, separatingAxis.edge) > radius) {
+      return;
+    }
+  }
+
   uint32 firstEdge = 0;
   float firstSeparation = getMaxSeparation(firstShape, secondShape, firstTransform, secondTransform, &firstEdge);
 
   if(firstSeparation > radius) {
+    separatingAxis = SeparatingAxis(SeparatingAxis::Owner::FirstShape, static_cast<uint8>(firstEdge));
     return;
   }
 
@@ -140,6 +197,7 @@ void PolygonVPolygonAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryInd
   float secondSeparation = getMaxSeparation(secondShape, firstShape, secondTransform, firstTransform, &secondEdge);
 
   if(secondSeparation > radius) {
+    separatingAxis = SeparatingAxis(SeparatingAxis::Owner::SecondShape, static_cast<uint8>(secondEdge));
     return;
   }
 
@@ -159,6 +217,7 @@ void PolygonVPolygonAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryInd
     referenceEdge = secondEdge;
     manifold.type = LocalManifoldInfo::ManifoldType::FaceB;
     flip = true;
+    separatingAxis = SeparatingAxis(SeparatingAxis::Owner::SecondShape, static_cast<uint8>(secondEdge));
   }
   else {
     referencePolygon = firstShape;
@@ -168,6 +227,7 @@ void PolygonVPolygonAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryInd
     referenceEdge = firstEdge;
     manifold.type = LocalManifoldInfo::ManifoldType::FaceA;
     flip = false;
+    separatingAxis = SeparatingAxis(SeparatingAxis::Owner::FirstShape, static_cast<uint8>(firstEdge));
   }
 
   ClipVertex incidentEdge[MAX_MANIFOLD_POINTS];
@@ -241,5 +301,12 @@ void PolygonVPolygonAlgorithm::execute(NarrowPhase& narrowPhase, uint32 entryInd
 
   manifold.numPoints = numPoints;
   /* Debug */
-  narrowPhase.entries[entryIndex].isColliding = numPoints > 0;
+  batch.isColliding[entryIndex] = numPoints > 0;
+}
+
+/* Execute the collision algorithm on the entries [begin, end) of a narrow phase batch */
+void PolygonVPolygonAlgorithm::executeBatch(NarrowPhase::NarrowPhaseBatch& batch, uint32 begin, uint32 end) {
+  for(uint32 i = begin; i < end; i++) {
+    execute(batch, i);
+  }
 }
\ No newline at end of file
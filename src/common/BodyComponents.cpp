@@ -35,7 +35,9 @@ BodyComponents::BodyComponents(MemoryHandler& memoryHandler) :
                                sizeof(Vector2) +
                                sizeof(bool) +
                                sizeof(bool) +
-                               sizeof(DynamicArray<uint32>)) {
+                               sizeof(DynamicArray<uint32>)),
+                    mNumSleepingBodies(0),
+                    mNumStaticBodies(0) {
   /* Allocate memory for component data */
   allocate(NUM_INIT);
 }
@@ -148,6 +150,14 @@ void BodyComponents::eraseComponent(uint32 index) {
   assert(mEntityComponentMap[mBodyEntities[index]] == index);
   mEntityComponentMap.remove(mBodyEntities[index]);
 
+  if(mIsSleeping[index]) {
+    mNumSleepingBodies--;
+  }
+
+  if(mTypes[index] == BodyType::Static) {
+    mNumStaticBodies--;
+  }
+
   /* Destroy individual components */
   mBodyEntities[index].~Entity();
   mBodies[index] = nullptr;
@@ -195,7 +205,9 @@ void BodyComponents::moveComponent(uint32 source, uint32 destination) {
   mIsInIsland[destination] = mIsInIsland[source];
   new (mContactPairs + destination) DynamicArray<uint32>(mContactPairs[source]);
 
-  /* Destroy source */
+  /* Destroy source, the body is still counted as sleeping and static at its destination */
+  mIsSleeping[source] = false;
+  mTypes[source] = BodyType::Dynamic;
   eraseComponent(source);
   assert(!mEntityComponentMap.contains(entity));
   /* Update entity-component map */
@@ -234,7 +246,9 @@ void BodyComponents::swapComponents(uint32 first, uint32 second) {
   bool firstIsInIsland = mIsInIsland[first];
   DynamicArray<uint32> firstContactPair(mContactPairs[first]);
 
-  /* Destroy first component */
+  /* Destroy first component, the body is still counted as sleeping and static once it is constructed at second */
+  mIsSleeping[first] = false;
+  mTypes[first] = BodyType::Dynamic;
   eraseComponent(first);
   /* Move second's component data to first's location */
   moveComponent(second, first);
@@ -287,6 +301,7 @@ void BodyComponents::insertComponent(Entity entity, bool isSleeping, const BodyC
   mIsSleeping[insertIndex] = false;
   mSleepTimes[insertIndex] = 0.0f;
   mTypes[insertIndex] = component.type;
+  mNumStaticBodies += component.type == BodyType::Static;
   new (mLinearVelocities + insertIndex) Vector2(0.0f, 0.0f);
   mAngularSpeeds[insertIndex] = 0.0f;
   new (mForces + insertIndex) Vector2(0.0f, 0.0f);
@@ -359,7 +374,24 @@ bool BodyComponents::getIsSleeping(Entity entity) const {
 /* Set sleep status */
 void BodyComponents::setIsSleeping(Entity entity, bool isSleeping) {
     assert(mEntityComponentMap.contains(entity));
-    mIsSleeping[mEntityComponentMap[entity]] = isSleeping;
+    bool& isBodySleeping = mIsSleeping[mEntityComponentMap[entity]];
+
+    /* Keep count of the sleeping bodies as their status changes so that it never needs to be recounted */
+    if(isBodySleeping != isSleeping) {
+        mNumSleepingBodies = isSleeping ? mNumSleepingBodies + 1 : mNumSleepingBodies - 1;
+    }
+
+    isBodySleeping = isSleeping;
+}
+
+/* Get the number of sleeping bodies */
+uint32 BodyComponents::getNumSleepingBodies() const {
+    return mNumSleepingBodies;
+}
+
+/* Get the number of static bodies */
+uint32 BodyComponents::getNumStaticBodies() const {
+    return mNumStaticBodies;
 }
 
 /* Get sleep time */
@@ -383,7 +415,14 @@ BodyType BodyComponents::getType(Entity entity) const {
 /* Set body type */
 void BodyComponents::setType(Entity entity, BodyType type) {
     assert(mEntityComponentMap.contains(entity));
-    mTypes[mEntityComponentMap[entity]] = type;
+    BodyType& bodyType = mTypes[mEntityComponentMap[entity]];
+
+    /* Keep count of the static bodies as their type changes */
+    if((bodyType == BodyType::Static) != (type == BodyType::Static)) {
+        mNumStaticBodies = type == BodyType::Static ? mNumStaticBodies + 1 : mNumStaticBodies - 1;
+    }
+
+    bodyType = type;
 }
 
 /* Get linear velocity */
@@ -5,12 +5,12 @@ using namespace physics;
 Logger* Factory::mLogger = nullptr;
 
 /* Constructor */
-Factory::Factory(MemoryHandler* primaryMemoryHandler) :
-                 mMemoryStrategy(primaryMemoryHandler),
-                 mWorlds(mMemoryStrategy.getFreeListMemoryHandler()),
-                 mPolygonShapes(mMemoryStrategy.getFreeListMemoryHandler()),
-                 mBoxShapes(mMemoryStrategy.getFreeListMemoryHandler()),
-                 mCircleShapes(mMemoryStrategy.getFreeListMemoryHandler()) {}
+Factory::Factory(MemoryHandler* primaryMemoryHandler, MemoryStrategy::HandlerType generalHandlerType) :
+                 mMemoryStrategy(primaryMemoryHandler, 0, generalHandlerType),
+                 mWorlds(mMemoryStrategy.getGeneralMemoryHandler()),
+                 mPolygonShapes(mMemoryStrategy.getGeneralMemoryHandler()),
+                 mBoxShapes(mMemoryStrategy.getGeneralMemoryHandler()),
+                 mCircleShapes(mMemoryStrategy.getGeneralMemoryHandler()) {}
 
 /* Destructor */
 Factory::~Factory() {
@@ -51,7 +51,7 @@ void Factory::destroy() {
 /* Delete world */
 void Factory::deleteWorld(World* world) {
   world->~World();
-  mMemoryStrategy.free(MemoryStrategy::HandlerType::FreeList, world, sizeof(World));
+  mMemoryStrategy.getGeneralMemoryHandler().free(world, sizeof(World));
 }
 
 /* Delete polygon shape */
@@ -74,7 +74,7 @@ void Factory::deleteCircle(CircleShape* circle) {
 
 /* Create world */
 World* Factory::createWorld(const World::Settings& settings) {
-  World* world = new (mMemoryStrategy.allocate(MemoryStrategy::HandlerType::FreeList, sizeof(World))) World(mMemoryStrategy, *this, settings);
+  World* world = new (mMemoryStrategy.getGeneralMemoryHandler().allocate(sizeof(World))) World(mMemoryStrategy, *this, settings);
   mWorlds.insert(world);
   return world;
 }
@@ -87,7 +87,7 @@ void Factory::destroyWorld(World* world) {
 
 /* Create polygon shape */
 PolygonShape* Factory::createPolygon(const Vector2* points, uint32 numPoints) {
-  PolygonShape* polygon = new (mMemoryStrategy.allocate(MemoryStrategy::HandlerType::ObjectPool, sizeof(PolygonShape))) PolygonShape(points, numPoints, mMemoryStrategy.getFreeListMemoryHandler());
+  PolygonShape* polygon = new (mMemoryStrategy.allocate(MemoryStrategy::HandlerType::ObjectPool, sizeof(PolygonShape))) PolygonShape(points, numPoints, mMemoryStrategy.getGeneralMemoryHandler());
   mPolygonShapes.insert(polygon);
   return polygon;
 }
@@ -100,7 +100,7 @@ void Factory::destroyPolygon(PolygonShape* polygon) {
 
 /* Create box shape */
 BoxShape* Factory::createBox(const float hx, const float hy) {
-  BoxShape* box = new (mMemoryStrategy.allocate(MemoryStrategy::HandlerType::ObjectPool, sizeof(BoxShape))) BoxShape(hx, hy, mMemoryStrategy.getFreeListMemoryHandler());
+  BoxShape* box = new (mMemoryStrategy.allocate(MemoryStrategy::HandlerType::ObjectPool, sizeof(BoxShape))) BoxShape(hx, hy, mMemoryStrategy.getGeneralMemoryHandler());
   mBoxShapes.insert(box);
   return box;
 }
@@ -113,7 +113,7 @@ void Factory::destroyBox(BoxShape* box) {
 
 /* Create circle shape */
 CircleShape* Factory::createCircle(const float radius) {
-  CircleShape* circle = new (mMemoryStrategy.allocate(MemoryStrategy::HandlerType::ObjectPool, sizeof(CircleShape))) CircleShape(radius, mMemoryStrategy.getFreeListMemoryHandler());
+  CircleShape* circle = new (mMemoryStrategy.allocate(MemoryStrategy::HandlerType::ObjectPool, sizeof(CircleShape))) CircleShape(radius, mMemoryStrategy.getGeneralMemoryHandler());
   mCircleShapes.insert(circle);
   return circle;
 }
@@ -124,6 +124,16 @@ void Factory::destroyCircle(CircleShape* circle) {
   mCircleShapes.remove(circle);
 }
 
+/* Release the object pool memory which holds no objects and return the number of bytes released */
+size_t Factory::trimMemory() {
+  return mMemoryStrategy.getObjectPoolMemoryHandler().trim();
+}
+
+/* Set the number of free object pool bytes above which the memory holding no objects is released automatically, zero to disable */
+void Factory::setMemoryTrimThreshold(size_t trimThreshold) {
+  mMemoryStrategy.getObjectPoolMemoryHandler().setTrimThreshold(trimThreshold);
+}
+
 /* Get logger */
 Logger* Factory::getLogger() {
   return mLogger;
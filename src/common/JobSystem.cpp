@@ -0,0 +1,236 @@
+#include <physics/common/JobSystem.h>
+
+using namespace physics;
+
+namespace {
+
+/* Job system owning the calling thread */
+thread_local const JobSystem* tOwner = nullptr;
+
+/* Index of the calling thread in the job system owning it */
+thread_local uint32 tThreadIndex = 0;
+
+}
+
+/* Constructor */
+JobSystem::JobSystem(MemoryHandler& memoryHandler, uint32 numWorkerThreads) :
+                     mMemoryHandler(memoryHandler),
+                     mNumWorkerThreads(numWorkerThreads),
+                     mNumQueuedJobs(0),
+                     mNumStolenJobs(0),
+                     mIsStopped(false) {
+  const uint32 numThreads = getNumThreads();
+  mWorkers = static_cast<Worker*>(mMemoryHandler.allocate(numThreads * sizeof(Worker)));
+  assert(mWorkers);
+  assert(reinterpret_cast<std::uintptr_t>(mWorkers) % alignof(Worker) == 0);
+
+  for(uint32 i = 0; i < numThreads; i++) {
+    new (mWorkers + i) Worker(mMemoryHandler);
+  }
+
+  mThreads = nullptr;
+
+  if(mNumWorkerThreads) {
+    mThreads = static_cast<std::thread*>(mMemoryHandler.allocate(mNumWorkerThreads * sizeof(std::thread)));
+    assert(mThreads);
+
+    /* The calling thread owns the first queue so worker threads start at index one */
+    for(uint32 i = 0; i < mNumWorkerThreads; i++) {
+      new (mThreads + i) std::thread(&JobSystem::run, this, i + 1);
+    }
+  }
+}
+
+/* Destructor */
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(mSleepMutex);
+    mIsStopped = true;
+  }
+
+  mSleepCondition.notify_all();
+
+  for(uint32 i = 0; i < mNumWorkerThreads; i++) {
+    mThreads[i].join();
+    mThreads[i].~thread();
+  }
+
+  if(mThreads) {
+    mMemoryHandler.free(mThreads, mNumWorkerThreads * sizeof(std::thread));
+  }
+
+  const uint32 numThreads = getNumThreads();
+
+  for(uint32 i = 0; i < numThreads; i++) {
+    mWorkers[i].~Worker();
+  }
+
+  mMemoryHandler.free(mWorkers, numThreads * sizeof(Worker));
+}
+
+/* Main loop of a worker thread */
+void JobSystem::run(uint32 threadIndex) {
+  tOwner = this;
+  tThreadIndex = threadIndex;
+
+  while(true) {
+    if(executeJob(threadIndex)) {
+      continue;
+    }
+
+    /* Sleep until new jobs are queued or the job system is stopped */
+    std::unique_lock<std::mutex> lock(mSleepMutex);
+    mSleepCondition.wait(lock, [this]() { return mNumQueuedJobs.load() > 0 || mIsStopped.load(); });
+
+    if(mIsStopped) {
+      return;
+    }
+  }
+}
+
+/* Pop a job from the back of the queue of the given thread */
+bool JobSystem::popJob(uint32 threadIndex, Job& job) {
+  Worker& worker = mWorkers[threadIndex];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+
+  if(worker.head == worker.jobs.size()) {
+    return false;
+  }
+
+  job = worker.jobs.back();
+  worker.jobs.erase(worker.jobs.size() - 1);
+
+  /* Rewind the queue once it has been drained */
+  if(worker.head == worker.jobs.size()) {
+    worker.jobs.clear();
+    worker.head = 0;
+  }
+
+  mNumQueuedJobs--;
+  return true;
+}
+
+/* Steal a job from the front of the queue of any other thread */
+bool JobSystem::stealJob(uint32 threadIndex, Job& job) {
+  const uint32 numThreads = getNumThreads();
+
+  for(uint32 i = 1; i < numThreads; i++) {
+    Worker& victim = mWorkers[(threadIndex + i) % numThreads];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+
+    if(victim.head == victim.jobs.size()) {
+      continue;
+    }
+
+    job = victim.jobs[victim.head];
+    victim.head++;
+
+    /* Rewind the queue once it has been drained */
+    if(victim.head == victim.jobs.size()) {
+      victim.jobs.clear();
+      victim.head = 0;
+    }
+
+    mNumQueuedJobs--;
+    mNumStolenJobs++;
+    return true;
+  }
+
+  return false;
+}
+
+/* Find and execute a single job, return false if no job was found */
+bool JobSystem::executeJob(uint32 threadIndex) {
+  Job job;
+
+  if(!popJob(threadIndex, job) && !stealJob(threadIndex, job)) {
+    return false;
+  }
+
+  (*job.task)(job.begin, job.end, threadIndex);
+  (*job.numPendingJobs)--;
+  return true;
+}
+
+/* Get the number of threads which may execute tasks including the calling thread */
+uint32 JobSystem::getNumThreads() const {
+  return mNumWorkerThreads + 1;
+}
+
+/* Get the number of jobs that were stolen from the queue of another thread */
+uint32 JobSystem::getNumStolenJobs() const {
+  return mNumStolenJobs.load();
+}
+
+/* Split the range into chunks which are executed by the worker threads and the calling thread */
+void JobSystem::parallelFor(uint32 count, uint32 grainSize, const Task& task) {
+  assert(grainSize > 0);
+
+  if(tOwner == this) {
+    distribute(count, grainSize, task, tThreadIndex);
+    return;
+  }
+
+  /* The first queue and the per-thread resources behind thread index zero are not shared between external threads so they wait for their turn */
+  std::lock_guard<std::mutex> lock(mExternalThreadMutex);
+
+  /* Adopt the calling thread as the owner of the first queue so that nested calls from its tasks reuse it */
+  const JobSystem* previousOwner = tOwner;
+  const uint32 previousThreadIndex = tThreadIndex;
+  tOwner = this;
+  tThreadIndex = 0;
+
+  distribute(count, grainSize, task, 0);
+
+  tOwner = previousOwner;
+  tThreadIndex = previousThreadIndex;
+}
+
+/* Split the range into chunks and help executing them from the queue of the given thread */
+void JobSystem::distribute(uint32 count, uint32 grainSize, const Task& task, uint32 threadIndex) {
+  const uint32 numChunks = getNumChunks(count, grainSize);
+
+  /* Not worth distributing */
+  if(numChunks < 2 || !mNumWorkerThreads) {
+    for(uint32 begin = 0; begin < count; begin += grainSize) {
+      task(begin, count - begin > grainSize ? begin + grainSize : count, threadIndex);
+    }
+
+    return;
+  }
+
+  std::atomic<uint32> numPendingJobs(numChunks);
+  const uint32 numThreads = getNumThreads();
+
+  /* Distribute the chunks over the queues in a round robin fashion, starting with the queue of the calling thread */
+  for(uint32 i = 0; i < numThreads && i < numChunks; i++) {
+    Worker& worker = mWorkers[(threadIndex + i) % numThreads];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+
+    /* Push in reverse so that the owner pops the chunks in ascending order */
+    for(uint32 chunk = numChunks - 1 - ((numChunks - 1 - i) % numThreads); chunk < numChunks; chunk -= numThreads) {
+      const uint32 begin = chunk * grainSize;
+      const Job job = {&task, begin, count - begin > grainSize ? begin + grainSize : count, &numPendingJobs};
+      worker.jobs.add(job);
+      mNumQueuedJobs++;
+
+      if(chunk < numThreads) {
+        break;
+      }
+    }
+  }
+
+  /* Wake up the idle worker threads */
+  {
+    std::lock_guard<std::mutex> lock(mSleepMutex);
+  }
+
+  mSleepCondition.notify_all();
+
+  /* Help out until every chunk of this loop has been executed */
+  while(numPendingJobs.load()) {
+    if(!executeJob(threadIndex)) {
+      std::this_thread::yield();
+    }
+  }
+}
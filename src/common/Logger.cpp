@@ -0,0 +1,230 @@
+#include <physics/common/Logger.h>
+#include <physics/mathematics/MathCommon.h>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace physics;
+
+/* Constructor */
+Logger::Logger(const std::string& file, uint32 capacity, LogLevel level) :
+               mFile(file),
+               mSlots(nullptr),
+               mCapacity(static_cast<uint32>(nextPowerOfTwo(std::max(capacity, 2u)))),
+               mEnqueuePosition(0),
+               mDequeuePosition(0),
+               mNumDroppedMessages(0),
+               mLevel(static_cast<int>(level)),
+               mCategories(~0u),
+               mIsRunning(true),
+               mIsWriterWaiting(false) {
+  /* The file is opened once for the lifetime of the logger */
+  if(!mFile.empty()) {
+    mStream.open(mFile, std::ios::app);
+  }
+
+  mSlots = new Slot[mCapacity];
+
+  /* Each slot is first written by the message whose position maps to it */
+  for(uint32 i = 0; i < mCapacity; i++) {
+    mSlots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  mWriter = std::thread(&Logger::run, this);
+}
+
+/* Destructor */
+Logger::~Logger() {
+  /* The writer thread writes every queued message before stopping */
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIsRunning.store(false, std::memory_order_release);
+  }
+
+  mWriterCondition.notify_one();
+  mWriter.join();
+  delete[] mSlots;
+}
+
+/* Retrieve a timestamp */
+std::string Logger::getTime(std::time_t time) {
+  std::tm timeInfo;
+
+  if(localtime_s(&timeInfo, &time) != 0) {
+    return "ERR";
+  }
+
+  std::stringstream ss;
+  ss << std::put_time(&timeInfo, "%Y-%m-%d %H:%M:%S");
+  return ss.str();
+}
+
+/* Retrieve the name of a severity */
+const char* Logger::getLevelName(LogLevel level) {
+  switch(level) {
+    case LogLevel::Debug:
+      return "Debug";
+    case LogLevel::Info:
+      return "Info";
+    case LogLevel::Warning:
+      return "Warning";
+    default:
+      return "Error";
+  }
+}
+
+/* Retrieve the name of a subsystem */
+const char* Logger::getCategoryName(LogCategory category) {
+  switch(category) {
+    case LogCategory::Common:
+      return "Common";
+    case LogCategory::Memory:
+      return "Memory";
+    case LogCategory::Collision:
+      return "Collision";
+    default:
+      return "Dynamics";
+  }
+}
+
+/* Set the lowest severity of the messages which are logged */
+void Logger::setLevel(LogLevel level) {
+  mLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+/* Enable/Disable logging the messages of a subsystem */
+void Logger::setIsCategoryEnabled(LogCategory category, bool isEnabled) {
+  const uint32 mask = 1u << static_cast<uint32>(category);
+
+  if(isEnabled) {
+    mCategories.fetch_or(mask, std::memory_order_relaxed);
+  }
+  else {
+    mCategories.fetch_and(~mask, std::memory_order_relaxed);
+  }
+}
+
+/* Queue a message to be written */
+void Logger::log(LogLevel level, LogCategory category, const std::string& message) {
+  if(!isEnabled(level, category)) {
+    return;
+  }
+
+  uint64 position = mEnqueuePosition.load(std::memory_order_relaxed);
+  Slot* slot;
+
+  /* Claim the slot of the next position, which is free once the writer has moved past the message a lap earlier */
+  while(true) {
+    slot = mSlots + (position & (mCapacity - 1));
+    const int64 difference = static_cast<int64>(slot->sequence.load(std::memory_order_acquire) - position);
+
+    if(difference == 0) {
+      if(mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    else if(difference < 0) {
+      /* Ring buffer is full */
+      mNumDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    else {
+      position = mEnqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+
+  const size_t length = std::min(message.size(), static_cast<size_t>(MAX_MESSAGE_LENGTH));
+  slot->time = std::time(nullptr);
+  slot->level = level;
+  slot->category = category;
+  std::memcpy(slot->message, message.data(), length);
+  slot->message[length] = '\0';
+  /* Publish the message to the writer */
+  slot->sequence.store(position + 1);
+
+  /* Either the writer sees the message before waiting or we see it waiting, in which case locking makes sure it is waiting before being notified */
+  if(mIsWriterWaiting.load()) {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+    }
+
+    mWriterCondition.notify_one();
+  }
+}
+
+/* Return whether a message is ready to be written */
+bool Logger::hasQueuedMessages() const {
+  const uint64 position = mDequeuePosition.load(std::memory_order_relaxed);
+  return mSlots[position & (mCapacity - 1)].sequence.load() == position + 1;
+}
+
+/* Write the queued messages until the ring buffer is empty and return the number of messages written */
+uint64 Logger::writeMessages() {
+  std::ostream& stream = mFile.empty() ? std::cout : mStream;
+  uint64 position = mDequeuePosition.load(std::memory_order_relaxed);
+  uint64 numWrittenMessages = 0;
+
+  /* Messages are written in the order their slots were claimed */
+  while(true) {
+    Slot& slot = mSlots[position & (mCapacity - 1)];
+
+    if(slot.sequence.load(std::memory_order_acquire) != position + 1) {
+      break;
+    }
+
+    stream << "[" << getTime(slot.time) << "] [" << getLevelName(slot.level) << "] [" << getCategoryName(slot.category) << "] " << slot.message << '\n';
+    /* Hand the slot over to the message a lap later */
+    slot.sequence.store(position + mCapacity, std::memory_order_release);
+    position++;
+    numWrittenMessages++;
+  }
+
+  if(numWrittenMessages) {
+    stream.flush();
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mDequeuePosition.store(position, std::memory_order_release);
+    }
+
+    mFlushCondition.notify_all();
+  }
+
+  return numWrittenMessages;
+}
+
+/* Run the writer thread */
+void Logger::run() {
+  while(true) {
+    const bool isRunning = mIsRunning.load(std::memory_order_acquire);
+
+    if(writeMessages()) {
+      continue;
+    }
+
+    /* The ring buffer was drained after the logger started stopping */
+    if(!isRunning) {
+      break;
+    }
+
+    /* Sleep until a message is queued or the logger starts stopping */
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIsWriterWaiting.store(true);
+    mWriterCondition.wait(lock, [this]() {
+      return hasQueuedMessages() || !mIsRunning.load(std::memory_order_acquire);
+    });
+    mIsWriterWaiting.store(false);
+  }
+}
+
+/* Block until every message queued before the call has been written */
+void Logger::flush() {
+  const uint64 position = mEnqueuePosition.load(std::memory_order_acquire);
+  std::unique_lock<std::mutex> lock(mMutex);
+  mWriterCondition.notify_one();
+  mFlushCondition.wait(lock, [this, position]() {
+    return mDequeuePosition.load(std::memory_order_acquire) >= position;
+  });
+}
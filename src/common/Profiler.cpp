@@ -0,0 +1,126 @@
+#include <physics/common/Profiler.h>
+#include <fstream>
+#include <cassert>
+
+using namespace physics;
+
+/* Constructor */
+Profiler::Profiler(MemoryHandler& memoryHandler, uint32 capacity, bool isEnabled) :
+                   mMemoryHandler(memoryHandler),
+                   mEvents(nullptr),
+                   mCapacity(capacity),
+                   mNumRecordedEvents(0),
+                   mIsEnabled(false),
+                   mFrame(0),
+                   mEpoch(std::chrono::steady_clock::now()) {
+  setIsEnabled(isEnabled);
+}
+
+/* Destructor */
+Profiler::~Profiler() {
+  if(mEvents) {
+    mMemoryHandler.free(mEvents, mCapacity * sizeof(Event));
+  }
+}
+
+/* Enable/Disable recording scopes, the ring buffer being allocated the first time it is enabled */
+void Profiler::setIsEnabled(bool isEnabled) {
+  /* Profilers without capacity never record */
+  if(isEnabled && !mCapacity) {
+    return;
+  }
+
+  if(isEnabled && !mEvents) {
+    mEvents = static_cast<Event*>(mMemoryHandler.allocate(mCapacity * sizeof(Event)));
+    assert(mEvents);
+  }
+
+  mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+/* Record a timed scope */
+void Profiler::record(const char* name, uint64 start, uint64 end, uint32 threadIndex) {
+  assert(mEvents);
+
+  /* Claiming a slot is the only synchronization between the recording threads */
+  const uint64 index = mNumRecordedEvents.fetch_add(1, std::memory_order_relaxed);
+  Event& event = mEvents[index % mCapacity];
+  event.name = name;
+  event.start = start;
+  event.duration = end - start;
+  event.frame = mFrame.load(std::memory_order_relaxed);
+  event.threadIndex = threadIndex;
+}
+
+/* Start a new frame */
+void Profiler::beginFrame() {
+  mFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* Get the number of events held by the ring buffer */
+uint32 Profiler::getNumEvents() const {
+  const uint64 numRecordedEvents = mNumRecordedEvents.load(std::memory_order_relaxed);
+  return numRecordedEvents < mCapacity ? static_cast<uint32>(numRecordedEvents) : mCapacity;
+}
+
+/* Get an event held by the ring buffer, the oldest one first */
+const Profiler::Event& Profiler::getEvent(uint32 index) const {
+  assert(index < getNumEvents());
+  const uint64 numRecordedEvents = mNumRecordedEvents.load(std::memory_order_relaxed);
+  return mEvents[(numRecordedEvents - getNumEvents() + index) % mCapacity];
+}
+
+/* Get the events of a frame which are still held by the ring buffer, in the order they ended */
+void Profiler::getFrameEvents(uint32 frame, DynamicArray<Event>& events) const {
+  const uint32 numEvents = getNumEvents();
+
+  for(uint32 i = 0; i < numEvents; i++) {
+    const Event& event = getEvent(i);
+
+    if(event.frame == frame) {
+      events.add(event);
+    }
+  }
+}
+
+/* Write the events held by the ring buffer as Chrome trace JSON */
+void Profiler::exportChromeTrace(std::ostream& stream) const {
+  const uint32 numEvents = getNumEvents();
+  const std::streamsize precision = stream.precision();
+  const std::ios_base::fmtflags flags = stream.flags();
+  stream.setf(std::ios_base::fixed, std::ios_base::floatfield);
+  stream.precision(3);
+  stream << "{\"traceEvents\":[";
+
+  /* Complete events with timestamps and durations in microseconds */
+  for(uint32 i = 0; i < numEvents; i++) {
+    const Event& event = getEvent(i);
+    stream << (i ? ",\n" : "\n");
+    stream << "{\"name\":\"" << event.name << "\",\"cat\":\"physics\",\"ph\":\"X\"";
+    stream << ",\"ts\":" << static_cast<double>(event.start) / 1000.0;
+    stream << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0;
+    stream << ",\"pid\":0,\"tid\":" << event.threadIndex;
+    stream << ",\"args\":{\"frame\":" << event.frame << "}}";
+  }
+
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  stream.precision(precision);
+  stream.flags(flags);
+}
+
+/* Write the events held by the ring buffer as Chrome trace JSON into a file */
+bool Profiler::exportChromeTrace(const std::string& file) const {
+  std::ofstream stream(file);
+
+  if(!stream) {
+    return false;
+  }
+
+  exportChromeTrace(stream);
+  return static_cast<bool>(stream);
+}
+
+/* Discard the recorded events */
+void Profiler::clear() {
+  mNumRecordedEvents.store(0, std::memory_order_relaxed);
+}
@@ -2,6 +2,7 @@
 #include <physics/common/World.h>
 #include <physics/collections/DynamicArray.h>
 #include <physics/collections/Stack.h>
+#include <physics/collections/DisjointSets.h>
 
 using namespace physics;
 
@@ -11,39 +12,53 @@ World::World(MemoryStrategy& memoryStrategy,
              const Settings& settings) :
              mMemoryStrategy(memoryStrategy),
              mSettings(settings),
-             mEntityHandler(mMemoryStrategy.getFreeListMemoryHandler()),
-             mBodyComponents(mMemoryStrategy.getFreeListMemoryHandler()),
-             mColliderComponents(mMemoryStrategy.getFreeListMemoryHandler()),
-             mTransformComponents(mMemoryStrategy.getFreeListMemoryHandler()),
+             mJobSystem(!settings.taskScheduler && settings.numWorkerThreads ? new (mMemoryStrategy.getGeneralMemoryHandler().allocate(sizeof(JobSystem))) JobSystem(mMemoryStrategy.getGeneralMemoryHandler(), settings.numWorkerThreads) : nullptr),
+             mTaskScheduler(settings.taskScheduler ? settings.taskScheduler : mJobSystem ? static_cast<TaskScheduler*>(mJobSystem) : &mSerialTaskScheduler),
+             mProfiler(mMemoryStrategy.getGeneralMemoryHandler(), settings.profilerCapacity, settings.isProfilingEnabled),
+             mStepStatistics(),
+             mEntityHandler(mMemoryStrategy.getGeneralMemoryHandler()),
+             mBodyComponents(mMemoryStrategy.getGeneralMemoryHandler()),
+             mColliderComponents(mMemoryStrategy.getGeneralMemoryHandler()),
+             mTransformComponents(mMemoryStrategy.getGeneralMemoryHandler()),
              mCollisionDetection(this,
                                  mMemoryStrategy, 
                                  mBodyComponents,
                                  mColliderComponents,
-                                 mTransformComponents),
-             mBodies(mMemoryStrategy.getFreeListMemoryHandler()),
+                                 mTransformComponents,
+                                 *mTaskScheduler),
+             mBodies(mMemoryStrategy.getGeneralMemoryHandler()),
              mIslands(mMemoryStrategy.getLinearMemoryHandler()),
              mIslandOrderedContactPairs(mMemoryStrategy.getLinearMemoryHandler()),
+             mPersistentIslands(mMemoryStrategy.getGeneralMemoryHandler()),
              mContactSolver(*this,
                             mMemoryStrategy,
                             mIslands,
                             mBodyComponents,
                             mColliderComponents,
                             mTransformComponents,
-                            mSettings.restitutionThreshold),
+                            *mTaskScheduler,
+                            mSettings.restitutionThreshold,
+                            mSettings.isGraphColoringEnabled,
+                            mSettings.graphColoringManifoldThreshold,
+                            mSettings.isSimdSolverEnabled),
             mIsGravityEnabled(true),
             mDynamics(*this,
                       mBodyComponents,
                       mColliderComponents,
                       mTransformComponents,
                       mIsGravityEnabled,
-                      mSettings.gravity),
+                      mSettings.gravity,
+                      *mTaskScheduler),
             mNumVelocitySolverIterations(mSettings.defaultVelocityConstraintSolverIterations),
             mNumPositionSolverIterations(mSettings.defaultPositionConstraintSolverIterations),
             mIsSleepingEnabled(mSettings.isSleepingEnabled),
             mSleepLinearVelocity(mSettings.defaultLinearVelocityForSleep),
             mSleepAngularSpeed(mSettings.defaultAngularSpeedForSleep),
             mSleepTime(mSettings.defaultSleepTime),
-            mLastInverseDelta(0.0f) {}
+            mLastInverseDelta(0.0f) {
+  /* Threads executing the tasks of a frame allocate their frame memory from their own handlers */
+  mMemoryStrategy.reserveThreadLinearMemoryHandlers(mTaskScheduler->getNumThreads());
+}
 
 /* Destructor */
 World::~World() {
@@ -59,6 +74,12 @@ World::~World() {
   assert(!mBodyComponents.getNumComponents());
   assert(!mColliderComponents.getNumComponents());
   assert(!mTransformComponents.getNumComponents());
+
+  /* Stop the worker threads of the built-in job system */
+  if(mJobSystem) {
+    mJobSystem->~JobSystem();
+    mMemoryStrategy.getGeneralMemoryHandler().free(mJobSystem, sizeof(JobSystem));
+  }
 }
 
 /* Set a body to be disabled */
@@ -84,6 +105,8 @@ void World::disableBody(Entity entity, bool isDisabled) {
 /* Generate the islands of the current frame */
 void World::generateIslands() {
   assert(mIslandOrderedContactPairs.size() == 0);
+  /* Link the contact pairs to their respective bodies */
+  mCollisionDetection.associateContactPairs();
   const uint32 numBodyComponents = mBodyComponents.getNumComponents();
 
   /* Reset island inclusion state */
@@ -133,7 +156,7 @@ void World::generateIslands() {
       }
 
       const uint32 numContactPairs = static_cast<uint32>(mBodyComponents.mContactPairs[visitedBodyIndex].size());
-      LOG("Island generation found " + std::to_string(numContactPairs) + " contact pair(s) for body index " + std::to_string(visitedBody.getIndex()));
+      LOG(LogLevel::Debug, LogCategory::Dynamics, "Island generation found " + std::to_string(numContactPairs) + " contact pair(s) for body index " + std::to_string(visitedBody.getIndex()));
 
       /* Check the other contact pairs that the current body is involved in */
       for(uint32 j = 0; j < numContactPairs; j++) {
@@ -146,7 +169,7 @@ void World::generateIslands() {
         }
 
         const Entity oppositeBody = contactPair.firstBodyEntity == visitedBody ? contactPair.secondBodyEntity : contactPair.firstBodyEntity;
-        LOG("Opposite body index " + std::to_string(oppositeBody.getIndex()) + " found for parent body index " + std::to_string(visitedBody.getIndex()));
+        LOG(LogLevel::Debug, LogCategory::Dynamics, "Opposite body index " + std::to_string(oppositeBody.getIndex()) + " found for parent body index " + std::to_string(visitedBody.getIndex()));
 
         if(mBodyComponents.containsComponent(oppositeBody)) {
           uint32 oppositeBodyIndex = mBodyComponents.getComponentEntityIndex(oppositeBody);
@@ -191,39 +214,380 @@ void World::generateIslands() {
   }
 }
 
+/* Update the persistent islands with the contacts which started and ended since the last frame and generate the islands of the current frame */
+void World::generatePersistentIslands() {
+  assert(mIslandOrderedContactPairs.size() == 0);
+  const DynamicArray<ContactPair>& contactPairs = *mCollisionDetection.mCurrentContactPairs;
+  DynamicArray<ContactEvent>& contactEvents = mCollisionDetection.mContactEvents;
+  const uint32 numContactPairs = static_cast<uint32>(contactPairs.size());
+  const uint32 numContactEvents = static_cast<uint32>(contactEvents.size());
+
+  /* Contacts which ended only mark their island since the bodies may still be linked through other contacts */
+  for(uint32 i = 0; i < numContactEvents; i++) {
+    const ContactEvent& contactEvent = contactEvents[i];
+
+    if(!contactEvent.isStarted && isPersistentIslandContact(contactEvent.firstBodyEntity, contactEvent.secondBodyEntity)) {
+      mPersistentIslands.markSplit(contactEvent.firstBodyEntity.getIndex());
+      mPersistentIslands.markSplit(contactEvent.secondBodyEntity.getIndex());
+    }
+  }
+
+  /* Split the island chosen in the last frame, its bodies are linked again below through their current contacts */
+  mPersistentIslands.split();
+
+  /* Merge the islands of contacts which started in this frame */
+  for(uint32 i = 0; i < numContactEvents; i++) {
+    const ContactEvent& contactEvent = contactEvents[i];
+
+    if(contactEvent.isStarted && isPersistentIslandContact(contactEvent.firstBodyEntity, contactEvent.secondBodyEntity)) {
+      /* A body hit by another one wakes up its whole island before the two islands become one */
+      mBodyComponents.getBody(contactEvent.firstBodyEntity)->setIsSleeping(false);
+      mBodyComponents.getBody(contactEvent.secondBodyEntity)->setIsSleeping(false);
+      mPersistentIslands.merge(contactEvent.firstBodyEntity.getIndex(), contactEvent.secondBodyEntity.getIndex());
+    }
+  }
+
+  contactEvents.clear();
+
+  /* Only islands which were dissolved since the last frame have to look through the current contacts to link their bodies again */
+  if(mPersistentIslands.hasLinkPending()) {
+    for(uint32 i = 0; i < numContactPairs; i++) {
+      const ContactPair& contactPair = contactPairs[i];
+
+      if(!isPersistentIslandContact(contactPair.firstBodyEntity, contactPair.secondBodyEntity)) {
+        continue;
+      }
+
+      const uint32 firstIndex = contactPair.firstBodyEntity.getIndex();
+      const uint32 secondIndex = contactPair.secondBodyEntity.getIndex();
+
+      if(mPersistentIslands.isLinkPending(firstIndex) || mPersistentIslands.isLinkPending(secondIndex)) {
+        mPersistentIslands.merge(firstIndex, secondIndex);
+      }
+    }
+
+    mPersistentIslands.clearLinkPending();
+  }
+
+  /* Reserve memory based on capacity from the previous frame */
+  mIslands.reserve();
+  const uint32 numIslands = mPersistentIslands.getNumAwakeIslands();
+  /* Island of each current contact pair, which is the awake island of its non-static body */
+  DynamicArray<uint32> contactPairIslands(mMemoryStrategy.getLinearMemoryHandler(), numContactPairs);
+
+  for(uint32 i = 0; i < numContactPairs; i++) {
+    const ContactPair& contactPair = contactPairs[i];
+    const uint32 firstIndex = contactPair.firstBodyEntity.getIndex();
+    const uint32 body = mPersistentIslands.isStatic(firstIndex) ? contactPair.secondBodyEntity.getIndex() : firstIndex;
+    contactPairIslands.add(mPersistentIslands.isStatic(body) ? INVALID_ISLAND_INDEX : mPersistentIslands.getAwakeIndex(mPersistentIslands.findRoot(body)));
+  }
+
+  /* Start of the contact pairs of each island in the island ordered contact pairs */
+  DynamicArray<uint32> islandOffsets(mMemoryStrategy.getLinearMemoryHandler(), numIslands + 1);
+  orderContactPairs(contactPairIslands, numIslands, islandOffsets);
+
+  /* Create the islands in the order of the awake islands, their bodies stay in the persistent islands */
+  for(uint32 i = 0; i < numIslands; i++) {
+    const uint32 root = mPersistentIslands.getAwakeIsland(i);
+    mIslands.addIsland(islandOffsets[i]);
+    mIslands.numManifolds[i] = islandOffsets[i + 1] - islandOffsets[i];
+    mIslands.numBodies[i] = mPersistentIslands.getNumBodies(root);
+    mPersistentIslands.considerSplit(root);
+  }
+}
+
+/* Query whether a contact links the persistent islands of its bodies */
+bool World::isPersistentIslandContact(Entity firstBodyEntity, Entity secondBodyEntity) const {
+  /* Contacts which ended may refer to bodies destroyed since and static bodies never link islands together */
+  return mPersistentIslands.containsBody(firstBodyEntity) && mPersistentIslands.containsBody(secondBodyEntity) &&
+         !mPersistentIslands.isStatic(firstBodyEntity.getIndex()) && !mPersistentIslands.isStatic(secondBodyEntity.getIndex());
+}
+
+/* Put the persistent island of a body to sleep or wake it up as a whole */
+void World::setIsPersistentIslandSleeping(Entity bodyEntity, bool isSleeping) {
+  if(mSettings.islandGeneration != IslandGeneration::Persistent || !mPersistentIslands.containsBody(bodyEntity) ||
+     mPersistentIslands.isStatic(bodyEntity.getIndex())) {
+    return;
+  }
+
+  const uint32 root = mPersistentIslands.findRoot(bodyEntity.getIndex());
+
+  if(mPersistentIslands.isAwake(root) != isSleeping) {
+    return;
+  }
+
+  /* The island changes state first so that its bodies do not recurse back into it */
+  mPersistentIslands.setIsAwake(root, !isSleeping);
+
+  for(uint32 body = mPersistentIslands.getFirstBody(root); body != PersistentIslands::INVALID_INDEX; body = mPersistentIslands.getNextBody(body)) {
+    mBodyComponents.getBody(mPersistentIslands.getBodyEntity(body))->setIsSleeping(isSleeping);
+  }
+}
+
+/* Generate the islands of the current frame by merging the bodies of the contact pairs from several threads */
+void World::generateParallelIslands() {
+  assert(mIslandOrderedContactPairs.size() == 0);
+  wakeContactBodies();
+  const DynamicArray<ContactPair>& contactPairs = *mCollisionDetection.mCurrentContactPairs;
+  const uint32 numContactPairs = static_cast<uint32>(contactPairs.size());
+  const uint32 numBodies = mBodyComponents.getNumEnabledComponents();
+  /* Sets over the indices of the enabled bodies */
+  DisjointSets bodySets(mMemoryStrategy.getLinearMemoryHandler(), numBodies);
+  /* Non-static body of each contact pair which decides its island, invalid if the pair has none */
+  DynamicArray<uint32> contactPairBodies(mMemoryStrategy.getLinearMemoryHandler(), numContactPairs);
+  contactPairBodies.fill(numContactPairs);
+
+  /* Merge the bodies of each contact pair, static bodies never link islands together */
+  mTaskScheduler->parallelFor(numContactPairs, ISLAND_TASK_GRAIN_SIZE, [this, &contactPairs, &bodySets, &contactPairBodies, numBodies](uint32 begin, uint32 end, uint32 threadIndex) {
+    NOT_USED(threadIndex);
+
+    for(uint32 i = begin; i < end; i++) {
+      const ContactPair& contactPair = contactPairs[i];
+      contactPairBodies[i] = INVALID_BODY_INDEX;
+
+      if(!mBodyComponents.containsComponent(contactPair.firstBodyEntity) || !mBodyComponents.containsComponent(contactPair.secondBodyEntity)) {
+        continue;
+      }
+
+      const uint32 firstIndex = mBodyComponents.getComponentEntityIndex(contactPair.firstBodyEntity);
+      const uint32 secondIndex = mBodyComponents.getComponentEntityIndex(contactPair.secondBodyEntity);
+
+      if(firstIndex >= numBodies || secondIndex >= numBodies) {
+        continue;
+      }
+
+      const bool isFirstBodyStatic = mBodyComponents.mTypes[firstIndex] == BodyType::Static;
+      const bool isSecondBodyStatic = mBodyComponents.mTypes[secondIndex] == BodyType::Static;
+
+      if(isFirstBodyStatic && isSecondBodyStatic) {
+        continue;
+      }
+
+      contactPairBodies[i] = isFirstBodyStatic ? secondIndex : firstIndex;
+
+      if(!isFirstBodyStatic && !isSecondBodyStatic) {
+        bodySets.merge(firstIndex, secondIndex);
+      }
+    }
+  });
+
+  /* Island of each body, holding the root of its set until the islands are numbered */
+  DynamicArray<uint32> bodyIslands(mMemoryStrategy.getLinearMemoryHandler(), numBodies);
+  bodyIslands.fill(numBodies);
+
+  mTaskScheduler->parallelFor(numBodies, BODY_TASK_GRAIN_SIZE, [this, &bodySets, &bodyIslands](uint32 begin, uint32 end, uint32 threadIndex) {
+    NOT_USED(threadIndex);
+
+    for(uint32 i = begin; i < end; i++) {
+      bodyIslands[i] = mBodyComponents.mTypes[i] == BodyType::Static ? INVALID_ISLAND_INDEX : bodySets.findRoot(i);
+    }
+  });
+
+  uint32 numIslands = 0;
+
+  /* The root of a set is its smallest body so islands are numbered in the order of their first body, as the depth first search does */
+  for(uint32 i = 0; i < numBodies; i++) {
+    if(bodyIslands[i] == INVALID_ISLAND_INDEX) {
+      continue;
+    }
+
+    bodyIslands[i] = bodyIslands[i] == i ? numIslands++ : bodyIslands[bodyIslands[i]];
+  }
+
+  /* Island of each contact pair */
+  DynamicArray<uint32> contactPairIslands(mMemoryStrategy.getLinearMemoryHandler(), numContactPairs);
+  contactPairIslands.fill(numContactPairs);
+
+  mTaskScheduler->parallelFor(numContactPairs, ISLAND_TASK_GRAIN_SIZE, [&contactPairBodies, &contactPairIslands, &bodyIslands](uint32 begin, uint32 end, uint32 threadIndex) {
+    NOT_USED(threadIndex);
+
+    for(uint32 i = begin; i < end; i++) {
+      contactPairIslands[i] = contactPairBodies[i] == INVALID_BODY_INDEX ? INVALID_ISLAND_INDEX : bodyIslands[contactPairBodies[i]];
+    }
+  });
+
+  /* Start of the contact pairs of each island in the island ordered contact pairs */
+  DynamicArray<uint32> islandOffsets(mMemoryStrategy.getLinearMemoryHandler(), numIslands + 1);
+  orderContactPairs(contactPairIslands, numIslands, islandOffsets);
+  /* Start of the bodies of each island */
+  DynamicArray<uint32> islandBodyOffsets(mMemoryStrategy.getLinearMemoryHandler(), numIslands + 1);
+
+  for(uint32 i = 0; i <= numIslands; i++) {
+    islandBodyOffsets.add(0);
+  }
+
+  for(uint32 i = 0; i < numBodies; i++) {
+    if(bodyIslands[i] != INVALID_ISLAND_INDEX) {
+      islandBodyOffsets[bodyIslands[i] + 1]++;
+    }
+  }
+
+  for(uint32 i = 0; i < numIslands; i++) {
+    islandBodyOffsets[i + 1] += islandBodyOffsets[i];
+  }
+
+  /* Bodies grouped by island in the order of their index */
+  DynamicArray<uint32> islandBodies(mMemoryStrategy.getLinearMemoryHandler(), islandBodyOffsets[numIslands]);
+  islandBodies.fill(islandBodyOffsets[numIslands]);
+
+  for(uint32 i = 0; i < numBodies; i++) {
+    if(bodyIslands[i] != INVALID_ISLAND_INDEX) {
+      islandBodies[islandBodyOffsets[bodyIslands[i]]++] = i;
+    }
+  }
+
+  /* Reserve memory based on capacity from the previous frame */
+  mIslands.reserve();
+  uint32 bodyIndex = 0;
+
+  /* Compact the islands into the islands of the current frame, the body offsets now point to the end of the bodies of each island */
+  for(uint32 i = 0; i < numIslands; i++) {
+    mIslands.addIsland(islandOffsets[i]);
+    mIslands.numManifolds[i] = islandOffsets[i + 1] - islandOffsets[i];
+
+    for(; bodyIndex < islandBodyOffsets[i]; bodyIndex++) {
+      mIslands.addBody(mBodyComponents.mBodyEntities[islandBodies[bodyIndex]]);
+    }
+  }
+
+  /* Wake up the bodies in the case that they are sleeping */
+  for(uint32 i = 0; i < numBodies; i++) {
+    if(bodyIslands[i] != INVALID_ISLAND_INDEX) {
+      mBodyComponents.mBodies[i]->setIsSleeping(false);
+    }
+  }
+}
+
+/* Wake up the sleeping bodies touched by the contact pairs of the current frame */
+void World::wakeContactBodies() {
+  const DynamicArray<ContactPair>& contactPairs = *mCollisionDetection.mCurrentContactPairs;
+  const uint32 numContactPairs = static_cast<uint32>(contactPairs.size());
+
+  /* Every contact pair has an awake body so a sleeping body in it has been hit and rejoins the enabled bodies before the islands index them */
+  for(uint32 i = 0; i < numContactPairs; i++) {
+    const Entity bodyEntities[2] = {contactPairs[i].firstBodyEntity, contactPairs[i].secondBodyEntity};
+
+    for(uint32 j = 0; j < 2; j++) {
+      if(mBodyComponents.containsComponent(bodyEntities[j]) && mBodyComponents.getIsEntityDisabled(bodyEntities[j])) {
+        mBodyComponents.getBody(bodyEntities[j])->setIsSleeping(false);
+      }
+    }
+  }
+}
+
+/* Bucket the contact pairs of the current frame by island while keeping their relative order */
+void World::orderContactPairs(const DynamicArray<uint32>& contactPairIslands, uint32 numIslands, DynamicArray<uint32>& islandOffsets) {
+  const uint32 numContactPairs = static_cast<uint32>(contactPairIslands.size());
+
+  for(uint32 i = 0; i <= numIslands; i++) {
+    islandOffsets.add(0);
+  }
+
+  /* Count the contact pairs of each island */
+  for(uint32 i = 0; i < numContactPairs; i++) {
+    if(contactPairIslands[i] != INVALID_ISLAND_INDEX) {
+      islandOffsets[contactPairIslands[i] + 1]++;
+    }
+  }
+
+  for(uint32 i = 0; i < numIslands; i++) {
+    islandOffsets[i + 1] += islandOffsets[i];
+  }
+
+  /* Cursor into the contact pairs of each island */
+  DynamicArray<uint32> islandCursors(islandOffsets);
+  mIslandOrderedContactPairs.fill(islandOffsets[numIslands]);
+
+  for(uint32 i = 0; i < numContactPairs; i++) {
+    if(contactPairIslands[i] != INVALID_ISLAND_INDEX) {
+      mIslandOrderedContactPairs[islandCursors[contactPairIslands[i]]++] = i;
+    }
+  }
+}
+
+/* Dissolve the persistent island of a body whose contacts no longer link it the same way */
+void World::resetPersistentIsland(Entity entity) {
+  if(mSettings.islandGeneration == IslandGeneration::Persistent) {
+    mPersistentIslands.setIsStatic(entity.getIndex(), mBodyComponents.getType(entity) == BodyType::Static);
+  }
+}
+
 /* Solve the physics simulation */
 void World::solve(TimeStep timeStep) {
   /* Initialize constrained positions and orientations */
   mDynamics.initializeStateConstraints();
 
   /* Integrate the linear and angular velocities using forces and torques */
-  mDynamics.integrateVelocities(timeStep);
-
-  /* Initialize the contact solver for each island */
-  mContactSolver.initialize(mCollisionDetection.mCurrentManifolds, timeStep);
+  {
+    PROFILE_SCOPE(mProfiler, "integrateVelocities");
+    mDynamics.integrateVelocities(timeStep);
+  }
 
-  /* Solve velocity constraints */
-  for(uint32 i = 0; i < mNumVelocitySolverIterations; i++) {
-    mContactSolver.solveVelocityConstraints();
+  /* Initialize the contact solver and group the islands into batches */
+  {
+    PROFILE_SCOPE(mProfiler, "initializeContactSolver");
+    mContactSolver.initialize(mCollisionDetection.mCurrentManifolds, timeStep);
+    mStepStatistics.numIslandBatches = mContactSolver.getNumIslandBatches();
+    mStepStatistics.numColoredIslands = mContactSolver.getNumColoredIslands();
+    mStepStatistics.numColors = mContactSolver.getNumColors();
+    mStepStatistics.numWideConstraints = mContactSolver.getNumWideConstraints();
   }
 
-  /* Store impulses for warm starting */
-  mContactSolver.storeImpulses();
+  /* Solve velocity constraints where each batch of islands runs its own iterations and stores its impulses for warm starting */
+  {
+    PROFILE_SCOPE(mProfiler, "solveVelocityConstraints");
+    mStepStatistics.numVelocitySolverIterations = mContactSolver.solveVelocityConstraints(mNumVelocitySolverIterations);
+  }
 
   /* Integrate positions using the constrained velocities */
-  mDynamics.integratePositions(timeStep);
+  {
+    PROFILE_SCOPE(mProfiler, "integratePositions");
+    mDynamics.integratePositions(timeStep);
+  }
 
   /* Solve position constraints */
-  for(uint32 i = 0; i < mNumPositionSolverIterations; i++) {
-    mContactSolver.solvePositionConstraints();
+  {
+    PROFILE_SCOPE(mProfiler, "solvePositionConstraints");
+    mStepStatistics.numPositionSolverIterations = mContactSolver.solvePositionConstraints(mNumPositionSolverIterations);
   }
 
   /* Reset the contact solver */
   mContactSolver.reset();
 }
 
+/* Update the sleep time of a body and get it, static bodies never keep an island awake */
+float World::updateSleepTime(Entity entity, TimeStep timeStep) {
+  const uint32 index = mBodyComponents.getComponentEntityIndex(entity);
+
+  /* Disregard static bodies */
+  if(mBodyComponents.mTypes[index] == BodyType::Static) {
+    return FLOAT_LARGEST;
+  }
+
+  /* Velocity is large enough to stay awake */
+  if(mBodyComponents.mLinearVelocities[index].lengthSquare() > square(mSleepLinearVelocity) ||
+     square(mBodyComponents.mAngularSpeeds[index]) > square(mSleepAngularSpeed) ||
+     !mBodyComponents.mIsAllowedToSleep[index]) {
+    /* Reset sleep time */
+    mBodyComponents.mSleepTimes[index] = 0.0f;
+  }
+  /* Velocity is below the threshold */
+  else {
+    /* Increase sleep time */
+    mBodyComponents.mSleepTimes[index] += timeStep.delta;
+  }
+
+  return mBodyComponents.mSleepTimes[index];
+}
+
 /* Set bodies to sleep as appropriate */
 void World::sleepBodies(TimeStep timeStep) {
+  /* The bodies of persistent islands are only kept in the persistent islands */
+  if(mSettings.islandGeneration == IslandGeneration::Persistent) {
+    sleepPersistentIslands(timeStep);
+    return;
+  }
+
   const uint32 numIslands = mIslands.getNumIslands();
 
   /* For each island */
@@ -231,69 +595,106 @@ void World::sleepBodies(TimeStep timeStep) {
     float minSleepTime = FLOAT_LARGEST;
 
     for(uint32 j = 0; j < mIslands.numBodies[i]; j++) {
-      const Entity entity = mIslands.bodies[mIslands.bodyIndices[i] + j];
-      const uint32 index = mBodyComponents.getComponentEntityIndex(entity);
-
-      /* Disregard static bodies */
-      if(mBodyComponents.mTypes[index] == BodyType::Static) {
-        continue;
-      }
-
-      /* Velocity is large enough to stay awake */
-      if(mBodyComponents.mLinearVelocities[index].lengthSquare() > square(mSleepLinearVelocity) ||
-         square(mBodyComponents.mAngularSpeeds[index]) > square(mSleepAngularSpeed) ||
-         !mBodyComponents.mIsAllowedToSleep[index]) {
-        /* Reset sleep time */
-        mBodyComponents.mSleepTimes[index] = 0.0f;
-        minSleepTime = 0.0f;   
-      }
-      /* Velocity is below the threshold */
-      else {
-        /* Increase sleep time */
-        mBodyComponents.mSleepTimes[index] += timeStep.delta;
-
-        if(mBodyComponents.mSleepTimes[index] < minSleepTime) {
-          minSleepTime = mBodyComponents.mSleepTimes[index];
-        }
-      }
+      minSleepTime = std::min(minSleepTime, updateSleepTime(mIslands.bodies[mIslands.bodyIndices[i] + j], timeStep));
     }
 
     /* Velocity of all bodies is under the threshold for longer than the sleep time */
     if(minSleepTime >= mSleepTime && mIslands.solved[i]) {
       for(uint32 j = 0; j < mIslands.numBodies[i]; j++) {
         const Entity entity = mIslands.bodies[mIslands.bodyIndices[i] + j];
-        Body* body = mBodyComponents.getBody(entity);
-        body->setIsSleeping(true);
+
+        /* Static bodies are shared between islands and stay enabled */
+        if(mBodyComponents.getType(entity) != BodyType::Static) {
+          mBodyComponents.getBody(entity)->setIsSleeping(true);
+        }
       }
     }
   }
 }
 
+/* Set the persistent islands to sleep as appropriate */
+void World::sleepPersistentIslands(TimeStep timeStep) {
+  /* The islands of the current frame are the awake islands which have not changed since */
+  assert(mIslands.getNumIslands() == mPersistentIslands.getNumAwakeIslands());
+
+  /* An island which falls asleep is replaced by the last awake island so the islands are visited from the last one */
+  for(uint32 i = mIslands.getNumIslands(); i-- > 0;) {
+    const uint32 root = mPersistentIslands.getAwakeIsland(i);
+    float minSleepTime = FLOAT_LARGEST;
+
+    for(uint32 body = mPersistentIslands.getFirstBody(root); body != PersistentIslands::INVALID_INDEX; body = mPersistentIslands.getNextBody(body)) {
+      minSleepTime = std::min(minSleepTime, updateSleepTime(mPersistentIslands.getBodyEntity(body), timeStep));
+    }
+
+    /* Velocity of all bodies is under the threshold for longer than the sleep time, the rest of the island follows its first body */
+    if(minSleepTime >= mSleepTime && mIslands.solved[i]) {
+      mBodyComponents.getBody(mPersistentIslands.getBodyEntity(root))->setIsSleeping(true);
+    }
+  }
+}
+
 /* Update the physics simulation */
 void World::step(float dt) {
   TimeStep timeStep;
   timeStep.delta = dt;
   timeStep.inverseDelta = dt > 0.0f ? 1.0f / dt : 0.0f;
   timeStep.deltaRatio = mLastInverseDelta * dt;
+  mProfiler.beginFrame();
+  PROFILE_SCOPE(mProfiler, "step");
   
   /* Execute collision detection */
   mCollisionDetection.execute();
+
   /* Create the islands */
-  generateIslands();
+  {
+    PROFILE_SCOPE(mProfiler, "generateIslands");
+
+    if(mSettings.islandGeneration == IslandGeneration::Persistent) {
+      generatePersistentIslands();
+    }
+    else if(mSettings.islandGeneration == IslandGeneration::Parallel) {
+      generateParallelIslands();
+    }
+    else {
+      generateIslands();
+    }
+
+    mStepStatistics.numIslands = mIslands.getNumIslands();
+    mStepStatistics.maxNumIslandBodies = mIslands.getMaxNumBodies();
+    mStepStatistics.numSolverBodies = mBodyComponents.getNumEnabledComponents();
+  }
+
   /* Prepare the collision detection results for the contact solver */
-  mCollisionDetection.prepareForContactSolver();
+  {
+    PROFILE_SCOPE(mProfiler, "prepareForContactSolver");
+    mCollisionDetection.prepareForContactSolver();
+  }
+
   /* Compute the parameters of the simulation  */
   solve(timeStep);
+
   /* Update the actual positions and velocities of the bodies */
-  mDynamics.updateBodyStates();
+  {
+    PROFILE_SCOPE(mProfiler, "updateBodyStates");
+    mDynamics.updateBodyStates();
+  }
+
   /* Update collider components */
-  mCollisionDetection.updateColliders();
+  {
+    PROFILE_SCOPE(mProfiler, "updateColliders");
+    mCollisionDetection.updateColliders();
+  }
 
   /* Update sleeping bodies */
   if(mIsSleepingEnabled) {
+    PROFILE_SCOPE(mProfiler, "sleepBodies");
     sleepBodies(timeStep);
   }
 
+  /* Sleeping bodies are counted as their status changes */
+  mStepStatistics.numSleepingBodies = mBodyComponents.getNumSleepingBodies();
+  mStepStatistics.numAwakeBodies = mBodyComponents.getNumComponents() - mBodyComponents.getNumStaticBodies() - mStepStatistics.numSleepingBodies;
+
   /* Reset external forces and torques */
   mDynamics.resetExternalStimuli();
   /* Reset islands */
@@ -318,19 +719,32 @@ Body* World::createBody(const Transform& transform) {
   mBodyComponents.insertComponent(entity, false, bodyComponent);
   /* Compute the inverse mass */
   mBodyComponents.setInverseMass(entity, 1.0f / mBodyComponents.getMass(entity));
+
+  /* The body starts in an island of its own */
+  if(mSettings.islandGeneration == IslandGeneration::Persistent) {
+    mPersistentIslands.addBody(entity);
+  }
+
   /* Add the body to the world */
   mBodies.add(body);
 
-  LOG("Created body with entity index " + std::to_string(body->getEntity().getIndex()));
+  LOG(LogLevel::Info, LogCategory::Common, "Created body with entity index " + std::to_string(body->getEntity().getIndex()));
 
   return body;
 }
 
 /* Destroy a body */
 void World::destroyBody(Body* body) {
-  LOG("Removing body with entity index " + std::to_string(body->getEntity().getIndex()));
+  LOG(LogLevel::Info, LogCategory::Common, "Removing body with entity index " + std::to_string(body->getEntity().getIndex()));
   /* Remove all colliders associated with the body */
   body->removeColliders();
+
+  /* The remaining bodies of the island are awake to be linked again through their own contacts */
+  if(mSettings.islandGeneration == IslandGeneration::Persistent) {
+    body->setIsSleeping(false);
+    mPersistentIslands.removeBody(body->getEntity());
+  }
+
   /* Remove the component for the body from the components array */
   mBodyComponents.removeComponent(body->getEntity());
   /* Remove the transform for the body */
@@ -345,3 +759,22 @@ void World::destroyBody(Body* body) {
   mMemoryStrategy.free(MemoryStrategy::HandlerType::ObjectPool, body, sizeof(Body));
 }
 
+/* Get the task scheduler used to distribute the work of a step */
+TaskScheduler& World::getTaskScheduler() {
+  return *mTaskScheduler;
+}
+
+/* Get the profiler recording the duration of the stages of a step */
+Profiler& World::getProfiler() {
+  return mProfiler;
+}
+
+/* Get the counters of the work done during the last step */
+const World::StepStatistics& World::getStepStatistics() const {
+  return mStepStatistics;
+}
+
+/* Get the live statistics of a memory handler of the memory strategy, which is shared by the worlds of a factory */
+MemoryStatistics World::getMemoryStatistics(MemoryStrategy::HandlerType handlerType) {
+  return mMemoryStrategy.getStatistics(handlerType);
+}
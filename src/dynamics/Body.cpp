@@ -28,6 +28,28 @@ void Body::resetOverlapPairs() {
   checkBroadPhaseCollision();
 }
 
+/* Move the collision shapes of the body into the broad phase tree matching its type */
+void Body::resetBroadPhaseTree() {
+  const DynamicArray<Entity>& colliderEntities = mWorld.mBodyComponents.getColliders(mEntity);
+  const uint32 numColliderEntities = static_cast<uint32>(colliderEntities.size());
+  const Transform& transform = mWorld.mTransformComponents.getTransform(mEntity);
+
+  for(uint32 i = 0; i < numColliderEntities; i++) {
+    Collider* collider = mWorld.mColliderComponents.getCollider(colliderEntities[i]);
+
+    /* Colliders of disabled bodies are not in broad phase */
+    if(collider->getBroadPhaseIdentifier() == -1) {
+      continue;
+    }
+
+    AABB aabb;
+    collider->getShape()->computeAABB(aabb, transform * collider->getTransformLocalBody());
+    /* Removing the collider erases its overlap pairs and adding it back marks it as having moved */
+    mWorld.mCollisionDetection.removeCollider(collider);
+    mWorld.mCollisionDetection.addCollider(collider, aabb);
+  }
+}
+
 /* Remove all collision shapes */
 void Body::removeColliders() {
   const DynamicArray<Entity> colliderEntities = mWorld.mBodyComponents.getColliders(mEntity);
@@ -90,13 +112,13 @@ Collider* Body::addCollider(Shape* shape, const Transform& transform) {
   shape->computeAABB(aabb, mWorld.mTransformComponents.getTransform(mEntity) * transform);
   /* Add the collider into broad phase */
   mWorld.mCollisionDetection.addCollider(collider, aabb);
-  LOG("Added collider index " + std::to_string(colliderEntity.getIndex()) + " to body index " + std::to_string(mEntity.getIndex()));
+  LOG(LogLevel::Info, LogCategory::Dynamics, "Added collider index " + std::to_string(colliderEntity.getIndex()) + " to body index " + std::to_string(mEntity.getIndex()));
   return collider;
 }
 
 /* Remove a collider from the body */
 void Body::removeCollider(Collider* collider) {
-  LOG("Removing collider index " + std::to_string(collider->getEntity().getIndex()) + " from body index " + std::to_string(mEntity.getIndex()));
+  LOG(LogLevel::Info, LogCategory::Dynamics, "Removing collider index " + std::to_string(collider->getEntity().getIndex()) + " from body index " + std::to_string(mEntity.getIndex()));
   /* Remove the collider from broad phase */
   if(collider->getBroadPhaseIdentifier() != -1) {
     mWorld.mCollisionDetection.removeCollider(collider);
@@ -431,12 +453,19 @@ BodyType Body::getType() const {
 
 /* Set type of the body */
 void Body::setType(BodyType type) {
-  if(mWorld.mBodyComponents.getType(mEntity) == type) {
+  const BodyType previousType = mWorld.mBodyComponents.getType(mEntity);
+
+  if(previousType == type) {
     return;
   }
 
   mWorld.mBodyComponents.setType(mEntity, type);
 
+  /* Static bodies keep their collision shapes in a broad phase tree of their own */
+  if((previousType == BodyType::Static) != (type == BodyType::Static)) {
+    resetBroadPhaseTree();
+  }
+
   if(type == BodyType::Static) {
     /* Static bodies have no velocity */
     mWorld.mBodyComponents.setLinearVelocity(mEntity, Vector2::getZeroVector());
@@ -461,6 +490,8 @@ void Body::setType(BodyType type) {
   mWorld.mBodyComponents.setTorque(mEntity, 0.0f);
   setIsSleeping(false);
   resetOverlapPairs();
+  /* Contacts of a static body no longer link islands */
+  mWorld.resetPersistentIsland(mEntity);
 }
 
 /* Query whether gravity is enabled for this body */
@@ -490,7 +521,16 @@ bool Body::isSleeping() const {
 
 /* Set whether the body is sleeping */
 void Body::setIsSleeping(bool isSleeping) {
+  /* A body which wakes up has to stay still for the whole sleep time again before it falls asleep */
+  if(!isSleeping && mWorld.mBodyComponents.getIsSleeping(mEntity)) {
+    mWorld.mBodyComponents.setSleepTime(mEntity, 0.0f);
+  }
+
   mWorld.mBodyComponents.setIsSleeping(mEntity, isSleeping);
+  /* Sleeping bodies leave the enabled components so that only awake bodies are simulated */
+  mWorld.disableBody(mEntity, isSleeping);
+  /* Persistent islands fall asleep and wake up as a whole */
+  mWorld.setIsPersistentIslandSleeping(mEntity, isSleeping);
 }
 
 /* Apply world force to body at world point */
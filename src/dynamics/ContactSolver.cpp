@@ -4,6 +4,7 @@
 #include <physics/collision/Collider.h>
 #include <physics/dynamics/Islands.h>
 #include <physics/common/Factory.h>
+#include <cstring>
 
 using namespace physics;
 
@@ -14,7 +15,11 @@ ContactSolver::ContactSolver(World& world,
                              BodyComponents& bodyComponents,
                              ColliderComponents& colliderComponents,
                              TransformComponents& transformComponents,
-                             float& restitutionThreshold) :
+                             TaskScheduler& taskScheduler,
+                             float& restitutionThreshold,
+                             bool& isGraphColoringEnabled,
+                             uint32& graphColoringManifoldThreshold,
+                             bool& isSimdSolverEnabled) :
                              mWorld(world),
                              mMemoryStrategy(memoryStrategy),
                              mIslands(islands),
@@ -22,7 +27,20 @@ ContactSolver::ContactSolver(World& world,
                              mBodyComponents(bodyComponents),
                              mColliderComponents(colliderComponents),
                              mTransformComponents(transformComponents),
-                             mRestitutionThreshold(restitutionThreshold) {}
+                             mTaskScheduler(taskScheduler),
+                             mIslandBatches(memoryStrategy.getLinearMemoryHandler()),
+                             mColoredIslands(memoryStrategy.getLinearMemoryHandler()),
+                             mIslandColors(memoryStrategy.getLinearMemoryHandler()),
+                             mColorOffsets(memoryStrategy.getLinearMemoryHandler()),
+                             mColorManifolds(memoryStrategy.getLinearMemoryHandler()),
+                             mColorWideConstraints(memoryStrategy.getLinearMemoryHandler()),
+                             mWideVelocityConstraints(nullptr),
+                             mWidePositionConstraints(nullptr),
+                             mNumWideConstraints(0),
+                             mRestitutionThreshold(restitutionThreshold),
+                             mIsGraphColoringEnabled(isGraphColoringEnabled),
+                             mGraphColoringManifoldThreshold(graphColoringManifoldThreshold),
+                             mIsSimdSolverEnabled(isSimdSolverEnabled) {}
 
 /* Compute the collision restituion factor */
 float ContactSolver::computeMixedRestitution(const Material& firstMaterial, const Material& secondMaterial) const {
@@ -36,24 +54,38 @@ float ContactSolver::computeMixedFriction(const Material& firstMaterial, const M
   return std::sqrt(firstMaterial.getFriction() * secondMaterial.getFriction());
 }
 
-/* Initialize contact solver for a given island */
-void ContactSolver::initializeIsland(uint32 islandIndex) {
-  assert(mIslands.numBodies[islandIndex]);
-  assert(mIslands.numManifolds[islandIndex]);
-  const uint32 manifoldIndex = mIslands.manifoldIndices[islandIndex];
-  const uint32 numManifolds = mIslands.numManifolds[islandIndex];
-
-  for (uint32 i = manifoldIndex; i < manifoldIndex + numManifolds; i++) {
+/* Resolve the body indices of the constraints in the range [begin, end) */
+void ContactSolver::resolveBodyIndices(uint32 begin, uint32 end) {
+  for(uint32 i = begin; i < end; i++) {
     LocalManifold& manifold = (*mManifolds)[i];
     assert(manifold.info.numPoints);
-    const uint32 firstBodyIndex = mBodyComponents.getComponentEntityIndex(manifold.firstBodyEntity);
-    const uint32 secondBodyIndex = mBodyComponents.getComponentEntityIndex(manifold.secondBodyEntity);
     assert(!mBodyComponents.getIsEntityDisabled(manifold.firstBodyEntity));
     assert(!mBodyComponents.getIsEntityDisabled(manifold.secondBodyEntity));
+    const uint32 firstBodyIndex = mBodyComponents.getComponentEntityIndex(manifold.firstBodyEntity);
+    const uint32 secondBodyIndex = mBodyComponents.getComponentEntityIndex(manifold.secondBodyEntity);
+
+    /* Awake bodies form the prefix of the body components so the constrained arrays are indexed densely */
+    assert(firstBodyIndex < mBodyComponents.getNumEnabledComponents());
+    assert(secondBodyIndex < mBodyComponents.getNumEnabledComponents());
+
+    mVelocityConstraints[i].indexA = firstBodyIndex;
+    mVelocityConstraints[i].indexB = secondBodyIndex;
+    mPositionConstraints[i].indexA = firstBodyIndex;
+    mPositionConstraints[i].indexB = secondBodyIndex;
+  }
+}
+
+/* Initialize the constraints in the range [begin, end) from their manifolds */
+void ContactSolver::initializeConstraints(uint32 begin, uint32 end) {
+  for(uint32 i = begin; i < end; i++) {
+    LocalManifold& manifold = (*mManifolds)[i];
+    assert(manifold.info.numPoints);
     const uint32 firstColliderIndex = mColliderComponents.getComponentEntityIndex(manifold.firstColliderEntity);
     const uint32 secondColliderIndex = mColliderComponents.getComponentEntityIndex(manifold.secondColliderEntity);
 
     VelocityConstraint* velocityConstraint = mVelocityConstraints + i;
+    const uint32 firstBodyIndex = velocityConstraint->indexA;
+    const uint32 secondBodyIndex = velocityConstraint->indexB;
     velocityConstraint->friction = computeMixedFriction(mColliderComponents.mMaterials[firstColliderIndex], mColliderComponents.mMaterials[secondColliderIndex]);
     velocityConstraint->restitution = computeMixedRestitution(mColliderComponents.mMaterials[firstColliderIndex], mColliderComponents.mMaterials[secondColliderIndex]);
     velocityConstraint->inverseMassA = mBodyComponents.mInverseMasses[firstBodyIndex];
@@ -92,22 +124,19 @@ void ContactSolver::initializeIsland(uint32 islandIndex) {
       constraintPoint->velocityBias = 0.0f;
       positionConstraint->points[j] = contactPoint->localPoint;
     }
-
-    mNumManifolds++;
   }
 }
 
-/* Initialize velocity constraints */
-void ContactSolver::initializeVelocityConstraints() {
-  for (uint32 i = 0; i < mNumManifolds; i++) {
+/* Initialize the velocity constraints in the range [begin, end) */
+void ContactSolver::initializeVelocityConstraints(uint32 begin, uint32 end) {
+  for(uint32 i = begin; i < end; i++) {
     LocalManifold& localManifold = (*mManifolds)[i];
     assert(localManifold.info.numPoints);
 
-    const uint32 firstBodyIndex = mBodyComponents.getComponentEntityIndex(localManifold.firstBodyEntity);
-    const uint32 secondBodyIndex = mBodyComponents.getComponentEntityIndex(localManifold.secondBodyEntity);
-
     VelocityConstraint* velocityConstraint = mVelocityConstraints + i;
     PositionConstraint* positionConstraint = mPositionConstraints + i;
+    const uint32 firstBodyIndex = velocityConstraint->indexA;
+    const uint32 secondBodyIndex = velocityConstraint->indexB;
 
     float radiusA = positionConstraint->radiusA;
     float radiusB = positionConstraint->radiusB;
@@ -186,41 +215,41 @@ void ContactSolver::initializeVelocityConstraints() {
   }
 }
 
-/* Warm start the solver */
-void ContactSolver::warmStart() {
-  for (uint32 i = 0; i < mNumManifolds; i++) {
-    LocalManifold& localManifold = (*mManifolds)[i];
-    assert(localManifold.info.numPoints);
-
-    const uint32 firstBodyIndex = mBodyComponents.getComponentEntityIndex(localManifold.firstBodyEntity);
-    const uint32 secondBodyIndex = mBodyComponents.getComponentEntityIndex(localManifold.secondBodyEntity);
-
-    VelocityConstraint* velocityConstraint = mVelocityConstraints + i;
-    float inverseMassA = velocityConstraint->inverseMassA;
-    float inverseInertiaA = velocityConstraint->inverseInertiaA;
-    float inverseMassB = velocityConstraint->inverseMassB;
-    float inverseInertiaB = velocityConstraint->inverseInertiaB;
-    uint32 numPoints = velocityConstraint->numPoints;
-
-    Vector2 linearVelocityA = mBodyComponents.mLinearVelocitiesConstrained[firstBodyIndex];
-    float angularSpeedA = mBodyComponents.mAngularSpeedsConstrained[firstBodyIndex];
-    Vector2 linearVelocityB = mBodyComponents.mLinearVelocitiesConstrained[secondBodyIndex];
-    float angularSpeedB = mBodyComponents.mAngularSpeedsConstrained[secondBodyIndex];
-    
-    Vector2 normal = velocityConstraint->normal;
-    Vector2 tangent = cross(normal, 1.0f);
-
-    for(uint32 j = 0; j < numPoints; j++) {
-      VelocityConstraint::VelocityConstraintPoint* constraintPoint = velocityConstraint->points + j;
-      Vector2 P = constraintPoint->normalImpulse * normal + constraintPoint->tangentImpulse * tangent;
-      angularSpeedA -= inverseInertiaA * cross(constraintPoint->rA, P);
-      linearVelocityA -= inverseMassA * P;
-      angularSpeedB += inverseInertiaB * cross(constraintPoint->rB, P);
-      linearVelocityB += inverseMassB * P;
-    }
+/* Warm start a single velocity constraint */
+void ContactSolver::warmStartConstraint(uint32 i) {
+  VelocityConstraint* velocityConstraint = mVelocityConstraints + i;
+  const uint32 firstBodyIndex = velocityConstraint->indexA;
+  const uint32 secondBodyIndex = velocityConstraint->indexB;
+  float inverseMassA = velocityConstraint->inverseMassA;
+  float inverseInertiaA = velocityConstraint->inverseInertiaA;
+  float inverseMassB = velocityConstraint->inverseMassB;
+  float inverseInertiaB = velocityConstraint->inverseInertiaB;
+  uint32 numPoints = velocityConstraint->numPoints;
+
+  Vector2 linearVelocityA = mBodyComponents.mLinearVelocitiesConstrained[firstBodyIndex];
+  float angularSpeedA = mBodyComponents.mAngularSpeedsConstrained[firstBodyIndex];
+  Vector2 linearVelocityB = mBodyComponents.mLinearVelocitiesConstrained[secondBodyIndex];
+  float angularSpeedB = mBodyComponents.mAngularSpeedsConstrained[secondBodyIndex];
+  
+  Vector2 normal = velocityConstraint->normal;
+  Vector2 tangent = cross(normal, 1.0f);
+
+  for(uint32 j = 0; j < numPoints; j++) {
+    VelocityConstraint::VelocityConstraintPoint* constraintPoint = velocityConstraint->points + j;
+    Vector2 P = constraintPoint->normalImpulse * normal + constraintPoint->tangentImpulse * tangent;
+    angularSpeedA -= inverseInertiaA * cross(constraintPoint->rA, P);
+    linearVelocityA -= inverseMassA * P;
+    angularSpeedB += inverseInertiaB * cross(constraintPoint->rB, P);
+    linearVelocityB += inverseMassB * P;
+  }
 
+  /* Static bodies may be shared by islands that are solved concurrently so only write back bodies that can move */
+  if(inverseMassA > 0.0f || inverseInertiaA > 0.0f) {
     mBodyComponents.mLinearVelocitiesConstrained[firstBodyIndex] = linearVelocityA;
     mBodyComponents.mAngularSpeedsConstrained[firstBodyIndex] = angularSpeedA;
+  }
+
+  if(inverseMassB > 0.0f || inverseInertiaB > 0.0f) {
     mBodyComponents.mLinearVelocitiesConstrained[secondBodyIndex] = linearVelocityB;
     mBodyComponents.mAngularSpeedsConstrained[secondBodyIndex] = angularSpeedB;
   }
@@ -232,282 +261,1081 @@ void ContactSolver::initialize(DynamicArray<LocalManifold>* manifolds, TimeStep
   mTimeStep = timeStep;
   mVelocityConstraints = nullptr;
   mPositionConstraints =  nullptr;
-  mNumManifolds = 0;
-  const uint32 numManifolds = static_cast<uint32>(mManifolds->size());
+  mWideVelocityConstraints = nullptr;
+  mWidePositionConstraints = nullptr;
+  mNumWideConstraints = 0;
+  mNumManifolds = static_cast<uint32>(mManifolds->size());
 
-  if(!numManifolds) {
+  if(!mNumManifolds) {
     return;
   }
 
-  mVelocityConstraints = static_cast<VelocityConstraint*>(mMemoryStrategy.allocate(MemoryStrategy::HandlerType::Linear, sizeof(VelocityConstraint) * numManifolds));
-  mPositionConstraints = static_cast<PositionConstraint*>(mMemoryStrategy.allocate(MemoryStrategy::HandlerType::Linear, sizeof(PositionConstraint) * numManifolds));
+  mVelocityConstraints = static_cast<VelocityConstraint*>(mMemoryStrategy.allocate(MemoryStrategy::HandlerType::Linear, sizeof(VelocityConstraint) * mNumManifolds));
+  mPositionConstraints = static_cast<PositionConstraint*>(mMemoryStrategy.allocate(MemoryStrategy::HandlerType::Linear, sizeof(PositionConstraint) * mNumManifolds));
   assert(mVelocityConstraints);
   assert(mPositionConstraints);
+
+  /* Body indices are looked up once per frame, every later pass of the solver only works on these indices */
+  mTaskScheduler.parallelFor(mNumManifolds, CONTACT_SOLVER_TASK_GRAIN_SIZE, [this](uint32 begin, uint32 end, uint32 threadIndex) {
+    NOT_USED(threadIndex);
+    resolveBodyIndices(begin, end);
+  });
+
   const uint32 numIslands = mIslands.getNumIslands();
+  const uint32 numBodyComponents = mBodyComponents.getNumComponents();
+  uint64* bodyColors = nullptr;
+  uint32 numBatchManifolds = 0;
 
+  /* Group consecutive islands into batches which are large enough to be worth solving as a separate task */
   for(uint32 i = 0; i < numIslands; i++) {
-    if(mIslands.numManifolds[i] > 0) {
-      initializeIsland(i);
+    const uint32 numIslandManifolds = mIslands.numManifolds[i];
+
+    if(!numIslandManifolds) {
+      continue;
+    }
+
+    /* Islands which are too large to be balanced across tasks are colored instead */
+    if(mIsGraphColoringEnabled && numIslandManifolds >= mGraphColoringManifoldThreshold) {
+      if(!bodyColors) {
+        bodyColors = static_cast<uint64*>(mMemoryStrategy.allocate(MemoryStrategy::HandlerType::Linear, sizeof(uint64) * numBodyComponents));
+        std::memset(bodyColors, 0, sizeof(uint64) * numBodyComponents);
+      }
+
+      colorIsland(i, bodyColors);
+      numBatchManifolds = 0;
+      continue;
+    }
+
+    if(!numBatchManifolds) {
+      mIslandBatches.add(Pair<uint32, uint32>(i, i + 1));
+    }
+    else {
+      mIslandBatches[mIslandBatches.size() - 1].second = i + 1;
+    }
+
+    numBatchManifolds += numIslandManifolds;
+
+    if(numBatchManifolds >= CONTACT_SOLVER_TASK_GRAIN_SIZE) {
+      numBatchManifolds = 0;
     }
   }
 
-  LOG("Contact solver found " + std::to_string(mNumManifolds) + " manifold(s)");
+  if(bodyColors) {
+    mMemoryStrategy.free(MemoryStrategy::HandlerType::Linear, bodyColors, sizeof(uint64) * numBodyComponents);
+  }
 
-  initializeVelocityConstraints();
-  warmStart();
+  /* The ends of the last colored island and of its last color */
+  mIslandColors.add(static_cast<uint32>(mColorOffsets.size()));
+  mColorOffsets.add(static_cast<uint32>(mColorManifolds.size()));
+  mColorWideConstraints.add(mNumWideConstraints);
+
+  if(mIsSimdSolverEnabled && mNumWideConstraints) {
+    mWideVelocityConstraints = static_cast<WideVelocityConstraint*>(mMemoryStrategy.allocate(MemoryStrategy::HandlerType::Linear, sizeof(WideVelocityConstraint) * mNumWideConstraints));
+    mWidePositionConstraints = static_cast<WidePositionConstraint*>(mMemoryStrategy.allocate(MemoryStrategy::HandlerType::Linear, sizeof(WidePositionConstraint) * mNumWideConstraints));
+    assert(mWideVelocityConstraints);
+    assert(mWidePositionConstraints);
+  }
+
+  LOG(LogLevel::Debug, LogCategory::Dynamics, "Contact solver found " + std::to_string(mNumManifolds) + " manifold(s) in " + std::to_string(mIslandBatches.size()) + " island batch(es) and " + std::to_string(mColoredIslands.size()) + " colored island(s)");
 }
 
-/* Solve velocity constraints */
-void ContactSolver::solveVelocityConstraints() {
-  for(uint32 i = 0; i < mNumManifolds; i++) {
-    LocalManifold& localManifold = (*mManifolds)[i];
-    assert(localManifold.info.numPoints);
+/* Partition the constraints of an island into colors where no two constraints of the same color share a body that can move */
+void ContactSolver::colorIsland(uint32 islandIndex, uint64* bodyColors) {
+  const uint32 begin = mIslands.manifoldIndices[islandIndex];
+  const uint32 end = begin + mIslands.numManifolds[islandIndex];
+  uint32 numColorManifolds[GRAPH_COLORING_MAX_COLORS] = {};
+  uint32 colorStarts[GRAPH_COLORING_MAX_COLORS];
+  DynamicArray<uint8> manifoldColors(mMemoryStrategy.getLinearMemoryHandler(), end - begin);
+  uint32 numColors = 0;
+
+  /* Greedily assign each constraint the lowest color which is not used by either of its bodies yet */
+  for(uint32 i = begin; i < end; i++) {
+    const uint32 firstBodyIndex = mVelocityConstraints[i].indexA;
+    const uint32 secondBodyIndex = mVelocityConstraints[i].indexB;
+    /* Static bodies are never written by the solver so they do not constrain the coloring */
+    const bool isFirstBodyMovable = mBodyComponents.mInverseMasses[firstBodyIndex] > 0.0f || mBodyComponents.mInverseInertias[firstBodyIndex] > 0.0f;
+    const bool isSecondBodyMovable = mBodyComponents.mInverseMasses[secondBodyIndex] > 0.0f || mBodyComponents.mInverseInertias[secondBodyIndex] > 0.0f;
+    const uint64 usedColors = (isFirstBodyMovable ? bodyColors[firstBodyIndex] : 0) | (isSecondBodyMovable ? bodyColors[secondBodyIndex] : 0);
+    uint8 color = 0;
+
+    /* The last color takes every constraint that did not fit anywhere else and is solved sequentially */
+    while(color < GRAPH_COLORING_MAX_COLORS - 1 && (usedColors & (static_cast<uint64>(1) << color))) {
+      color++;
+    }
 
-    const uint32 firstBodyIndex = mBodyComponents.getComponentEntityIndex(localManifold.firstBodyEntity);
-    const uint32 secondBodyIndex = mBodyComponents.getComponentEntityIndex(localManifold.secondBodyEntity);
+    if(isFirstBodyMovable) {
+      bodyColors[firstBodyIndex] |= static_cast<uint64>(1) << color;
+    }
 
-    VelocityConstraint* velocityConstraint =  mVelocityConstraints + i;
-    float inverseMassA = velocityConstraint->inverseMassA;
-    float inverseInertiaA = velocityConstraint->inverseInertiaA;
-    float inverseMassB = velocityConstraint->inverseMassB;
-    float inverseInertiaB = velocityConstraint->inverseInertiaB;
+    if(isSecondBodyMovable) {
+      bodyColors[secondBodyIndex] |= static_cast<uint64>(1) << color;
+    }
 
-    Vector2 linearVelocityA = mBodyComponents.mLinearVelocitiesConstrained[firstBodyIndex];
-    float angularSpeedA = mBodyComponents.mAngularSpeedsConstrained[firstBodyIndex];
-    Vector2 linearVelocityB = mBodyComponents.mLinearVelocitiesConstrained[secondBodyIndex];
-    float angularSpeedB = mBodyComponents.mAngularSpeedsConstrained[secondBodyIndex];
+    manifoldColors.add(color);
+    numColorManifolds[color]++;
+    numColors = std::max(numColors, static_cast<uint32>(color) + 1);
+  }
 
-    Vector2 normal = velocityConstraint->normal;
-    Vector2 tangent = cross(normal, 1.0f);
-    float friction = velocityConstraint->friction;
-    uint32 numPoints = velocityConstraint->numPoints;
+  mColoredIslands.add(islandIndex);
+  mIslandColors.add(static_cast<uint32>(mColorOffsets.size()));
+  uint32 offset = static_cast<uint32>(mColorManifolds.size());
+
+  for(uint32 i = 0; i < numColors; i++) {
+    mColorOffsets.add(offset);
+    mColorWideConstraints.add(mNumWideConstraints);
+    colorStarts[i] = offset;
+    offset += numColorManifolds[i];
+
+    /* Every color but the last one is packed SIMD_WIDTH constraints at a time when the SIMD solver is enabled */
+    if(mIsSimdSolverEnabled && i != GRAPH_COLORING_MAX_COLORS - 1u) {
+      mNumWideConstraints += (numColorManifolds[i] + SIMD_WIDTH - 1) / SIMD_WIDTH;
+    }
+  }
+
+  /* Bucket the manifolds by color while keeping their island order within a color */
+  mColorManifolds.fill(end - begin);
+
+  for(uint32 i = begin; i < end; i++) {
+    mColorManifolds[colorStarts[manifoldColors[i - begin]]++] = i;
+  }
+}
+
+/* Get the range of manifolds [begin, end) of the given batch of islands */
+void ContactSolver::getIslandBatchManifolds(uint32 batchIndex, uint32& begin, uint32& end) const {
+  const uint32 firstIsland = mIslandBatches[batchIndex].first;
+  const uint32 lastIsland = mIslandBatches[batchIndex].second - 1;
+  begin = mIslands.manifoldIndices[firstIsland];
+  end = mIslands.manifoldIndices[lastIsland] + mIslands.numManifolds[lastIsland];
+}
+
+/* Get the range [begin, end) of a color in the array of colored manifolds and the number of its manifolds solved by a single task */
+void ContactSolver::getColorManifolds(uint32 coloredIslandIndex, uint32 color, uint32& begin, uint32& end, uint32& grainSize) const {
+  begin = mColorOffsets[color];
+  end = mColorOffsets[color + 1];
+  /* The constraints of the last color may share bodies so they are solved by a single task */
+  const bool isSequential = color - mIslandColors[coloredIslandIndex] == GRAPH_COLORING_MAX_COLORS - 1u;
+  grainSize = isSequential ? std::max(end - begin, 1u) : GRAPH_COLOR_TASK_GRAIN_SIZE;
+}
+
+/* Initialize, warm start and solve the velocity constraints of each batch of islands and each colored island in parallel, then store the impulses for warm starting */
+uint32 ContactSolver::solveVelocityConstraints(uint16 numIterations) {
+  if(!mNumManifolds) {
+    return 0;
+  }
 
-    assert(numPoints > 0 && numPoints <= MAX_MANIFOLD_POINTS);
+  const uint32 numBatches = static_cast<uint32>(mIslandBatches.size());
 
-    /* Tangent constraints */
+  mTaskScheduler.parallelFor(numBatches, 1, [this, numIterations](uint32 batchBegin, uint32 batchEnd, uint32 threadIndex) {
+    NOT_USED(threadIndex);
+
+    for(uint32 batch = batchBegin; batch < batchEnd; batch++) {
+      uint32 begin;
+      uint32 end;
+      getIslandBatchManifolds(batch, begin, end);
+      initializeConstraints(begin, end);
+      initializeVelocityConstraints(begin, end);
+
+      for(uint32 i = begin; i < end; i++) {
+        warmStartConstraint(i);
+      }
+
+      /* Islands of a batch share no bodies that can move so their constraints can be iterated together */
+      for(uint16 i = 0; i < numIterations; i++) {
+        for(uint32 j = begin; j < end; j++) {
+          solveVelocityConstraint(j);
+        }
+      }
+
+      storeImpulses(begin, end);
+    }
+  });
+
+  const uint32 numColoredIslands = static_cast<uint32>(mColoredIslands.size());
+
+  for(uint32 i = 0; i < numColoredIslands; i++) {
+    solveColoredIslandVelocityConstraints(i, numIterations);
+  }
+
+  return numIterations;
+}
+
+/* Solve the velocity constraints of a colored island where the constraints of each color are solved in parallel */
+void ContactSolver::solveColoredIslandVelocityConstraints(uint32 coloredIslandIndex, uint16 numIterations) {
+  const uint32 islandIndex = mColoredIslands[coloredIslandIndex];
+  const uint32 islandBegin = mIslands.manifoldIndices[islandIndex];
+  const uint32 firstColor = mIslandColors[coloredIslandIndex];
+  const uint32 lastColor = mIslandColors[coloredIslandIndex + 1];
+
+  /* Constraints are initialized independently of each other */
+  mTaskScheduler.parallelFor(mIslands.numManifolds[islandIndex], GRAPH_COLOR_TASK_GRAIN_SIZE, [this, islandBegin](uint32 begin, uint32 end, uint32 threadIndex) {
+    NOT_USED(threadIndex);
+    initializeConstraints(islandBegin + begin, islandBegin + end);
+    initializeVelocityConstraints(islandBegin + begin, islandBegin + end);
+  });
+
+  for(uint32 color = firstColor; color < lastColor; color++) {
+    uint32 colorBegin;
+    uint32 colorEnd;
+    uint32 grainSize;
+    getColorManifolds(coloredIslandIndex, color, colorBegin, colorEnd, grainSize);
+
+    if(isColorWide(coloredIslandIndex, color)) {
+      const uint32 wideBegin = mColorWideConstraints[color];
+
+      /* Constraints are packed once they are initialized since the number of points used by the block solver is only known then */
+      mTaskScheduler.parallelFor(mColorWideConstraints[color + 1] - wideBegin, GRAPH_COLOR_WIDE_TASK_GRAIN_SIZE, [this, color, wideBegin](uint32 begin, uint32 end, uint32 threadIndex) {
+        NOT_USED(threadIndex);
+
+        for(uint32 i = wideBegin + begin; i < wideBegin + end; i++) {
+          packWideConstraint(color, i);
+          warmStartWideConstraint(i);
+        }
+      });
+
+      continue;
+    }
+
+    mTaskScheduler.parallelFor(colorEnd - colorBegin, grainSize, [this, colorBegin](uint32 begin, uint32 end, uint32 threadIndex) {
+      NOT_USED(threadIndex);
+
+      for(uint32 i = colorBegin + begin; i < colorBegin + end; i++) {
+        warmStartConstraint(mColorManifolds[i]);
+      }
+    });
+  }
+
+  for(uint16 i = 0; i < numIterations; i++) {
+    for(uint32 color = firstColor; color < lastColor; color++) {
+      uint32 colorBegin;
+      uint32 colorEnd;
+      uint32 grainSize;
+      getColorManifolds(coloredIslandIndex, color, colorBegin, colorEnd, grainSize);
+
+      if(isColorWide(coloredIslandIndex, color)) {
+        const uint32 wideBegin = mColorWideConstraints[color];
+
+        mTaskScheduler.parallelFor(mColorWideConstraints[color + 1] - wideBegin, GRAPH_COLOR_WIDE_TASK_GRAIN_SIZE, [this, wideBegin](uint32 begin, uint32 end, uint32 threadIndex) {
+          NOT_USED(threadIndex);
+
+          for(uint32 j = wideBegin + begin; j < wideBegin + end; j++) {
+            solveWideVelocityConstraint(j);
+          }
+        });
+
+        continue;
+      }
+
+      mTaskScheduler.parallelFor(colorEnd - colorBegin, grainSize, [this, colorBegin](uint32 begin, uint32 end, uint32 threadIndex) {
+        NOT_USED(threadIndex);
+
+        for(uint32 j = colorBegin + begin; j < colorBegin + end; j++) {
+          solveVelocityConstraint(mColorManifolds[j]);
+        }
+      });
+    }
+  }
+
+  for(uint32 color = firstColor; color < lastColor; color++) {
+    if(isColorWide(coloredIslandIndex, color)) {
+      const uint32 wideBegin = mColorWideConstraints[color];
+
+      mTaskScheduler.parallelFor(mColorWideConstraints[color + 1] - wideBegin, GRAPH_COLOR_WIDE_TASK_GRAIN_SIZE, [this, color, wideBegin](uint32 begin, uint32 end, uint32 threadIndex) {
+        NOT_USED(threadIndex);
+
+        for(uint32 i = wideBegin + begin; i < wideBegin + end; i++) {
+          unpackWideConstraint(color, i);
+        }
+      });
+    }
+  }
+
+  mTaskScheduler.parallelFor(mIslands.numManifolds[islandIndex], GRAPH_COLOR_TASK_GRAIN_SIZE, [this, islandBegin](uint32 begin, uint32 end, uint32 threadIndex) {
+    NOT_USED(threadIndex);
+    storeImpulses(islandBegin + begin, islandBegin + end);
+  });
+}
+
+/* Solve the position constraints of each batch of islands and each colored island in parallel */
+uint32 ContactSolver::solvePositionConstraints(uint16 numIterations) {
+  if(!mNumManifolds) {
+    return 0;
+  }
+
+  const uint32 numBatches = static_cast<uint32>(mIslandBatches.size());
+
+  mTaskScheduler.parallelFor(numBatches, 1, [this, numIterations](uint32 batchBegin, uint32 batchEnd, uint32 threadIndex) {
+    NOT_USED(threadIndex);
+
+    for(uint32 batch = batchBegin; batch < batchEnd; batch++) {
+      for(uint16 i = 0; i < numIterations; i++) {
+        for(uint32 j = mIslandBatches[batch].first; j < mIslandBatches[batch].second; j++) {
+          const uint32 islandBegin = mIslands.manifoldIndices[j];
+          const uint32 islandEnd = islandBegin + mIslands.numManifolds[j];
+
+          if(islandBegin == islandEnd) {
+            continue;
+          }
+
+          float minSeparation = 0.0f;
+
+          for(uint32 k = islandBegin; k < islandEnd; k++) {
+            minSeparation = std::min(minSeparation, solvePositionConstraint(k));
+          }
+
+          /* The island is considered solved only if its penetration stays small enough in every iteration */
+          mIslands.solved[j] = mIslands.solved[j] && (minSeparation >= -3.0f * LINEAR_SLOP);
+        }
+      }
+    }
+  });
+
+  const uint32 numColoredIslands = static_cast<uint32>(mColoredIslands.size());
+
+  for(uint32 i = 0; i < numColoredIslands; i++) {
+    solveColoredIslandPositionConstraints(i, numIterations);
+  }
+
+  return numIterations;
+}
+
+/* Solve the position constraints of a colored island where the constraints of each color are solved in parallel */
+void ContactSolver::solveColoredIslandPositionConstraints(uint32 coloredIslandIndex, uint16 numIterations) {
+  const uint32 islandIndex = mColoredIslands[coloredIslandIndex];
+  const uint32 firstColor = mIslandColors[coloredIslandIndex];
+  const uint32 lastColor = mIslandColors[coloredIslandIndex + 1];
+  const uint32 numThreads = mTaskScheduler.getNumThreads();
+  /* Minimum separation found by each thread */
+  DynamicArray<float> threadMinSeparations(mMemoryStrategy.getLinearMemoryHandler(), numThreads);
+  threadMinSeparations.fill(numThreads);
+
+  for(uint16 i = 0; i < numIterations; i++) {
+    for(uint32 j = 0; j < numThreads; j++) {
+      threadMinSeparations[j] = 0.0f;
+    }
+
+    for(uint32 color = firstColor; color < lastColor; color++) {
+      uint32 colorBegin;
+      uint32 colorEnd;
+      uint32 grainSize;
+      getColorManifolds(coloredIslandIndex, color, colorBegin, colorEnd, grainSize);
+
+      if(isColorWide(coloredIslandIndex, color)) {
+        const uint32 wideBegin = mColorWideConstraints[color];
+
+        mTaskScheduler.parallelFor(mColorWideConstraints[color + 1] - wideBegin, GRAPH_COLOR_WIDE_TASK_GRAIN_SIZE, [this, wideBegin, &threadMinSeparations](uint32 begin, uint32 end, uint32 threadIndex) {
+          float minSeparation = threadMinSeparations[threadIndex];
+
+          for(uint32 j = wideBegin + begin; j < wideBegin + end; j++) {
+            minSeparation = std::min(minSeparation, solveWidePositionConstraint(j));
+          }
+
+          threadMinSeparations[threadIndex] = minSeparation;
+        });
+
+        continue;
+      }
+
+      mTaskScheduler.parallelFor(colorEnd - colorBegin, grainSize, [this, colorBegin, &threadMinSeparations](uint32 begin, uint32 end, uint32 threadIndex) {
+        float minSeparation = threadMinSeparations[threadIndex];
+
+        for(uint32 j = colorBegin + begin; j < colorBegin + end; j++) {
+          minSeparation = std::min(minSeparation, solvePositionConstraint(mColorManifolds[j]));
+        }
+
+        threadMinSeparations[threadIndex] = minSeparation;
+      });
+    }
+
+    float minSeparation = 0.0f;
+
+    for(uint32 j = 0; j < numThreads; j++) {
+      minSeparation = std::min(minSeparation, threadMinSeparations[j]);
+    }
+
+    mIslands.solved[islandIndex] = mIslands.solved[islandIndex] && (minSeparation >= -3.0f * LINEAR_SLOP);
+  }
+}
+
+/* Solve a single velocity constraint */
+void ContactSolver::solveVelocityConstraint(uint32 i) {
+  VelocityConstraint* velocityConstraint =  mVelocityConstraints + i;
+  const uint32 firstBodyIndex = velocityConstraint->indexA;
+  const uint32 secondBodyIndex = velocityConstraint->indexB;
+  float inverseMassA = velocityConstraint->inverseMassA;
+  float inverseInertiaA = velocityConstraint->inverseInertiaA;
+  float inverseMassB = velocityConstraint->inverseMassB;
+  float inverseInertiaB = velocityConstraint->inverseInertiaB;
+
+  Vector2 linearVelocityA = mBodyComponents.mLinearVelocitiesConstrained[firstBodyIndex];
+  float angularSpeedA = mBodyComponents.mAngularSpeedsConstrained[firstBodyIndex];
+  Vector2 linearVelocityB = mBodyComponents.mLinearVelocitiesConstrained[secondBodyIndex];
+  float angularSpeedB = mBodyComponents.mAngularSpeedsConstrained[secondBodyIndex];
+
+  Vector2 normal = velocityConstraint->normal;
+  Vector2 tangent = cross(normal, 1.0f);
+  float friction = velocityConstraint->friction;
+  uint32 numPoints = velocityConstraint->numPoints;
+
+  assert(numPoints > 0 && numPoints <= MAX_MANIFOLD_POINTS);
+
+  /* Tangent constraints */
+  for(uint32 j = 0; j < numPoints; j++) {
+    VelocityConstraint::VelocityConstraintPoint* constraintPoint = velocityConstraint->points + j;
+    Vector2 dv = linearVelocityB + cross(angularSpeedB, constraintPoint->rB) - linearVelocityA - cross(angularSpeedA, constraintPoint->rA);
+    float vt = dot(dv, tangent);
+    float lambda = constraintPoint->tangentMass * (-vt);
+    float maxFriction = friction * constraintPoint->normalImpulse;
+    float newImpulse = clamp(constraintPoint->tangentImpulse + lambda, -maxFriction, maxFriction);
+    lambda = newImpulse - constraintPoint->tangentImpulse;
+    constraintPoint->tangentImpulse = newImpulse;
+
+    Vector2 P = lambda * tangent;
+    linearVelocityA -= inverseMassA * P;
+    angularSpeedA -= inverseInertiaA * cross(constraintPoint->rA, P);
+    linearVelocityB += inverseMassB * P;
+    angularSpeedB += inverseInertiaB * cross(constraintPoint->rB, P);
+  }
+
+  /* Normal constraints */
+  if(numPoints < MAX_MANIFOLD_POINTS) {
     for(uint32 j = 0; j < numPoints; j++) {
       VelocityConstraint::VelocityConstraintPoint* constraintPoint = velocityConstraint->points + j;
       Vector2 dv = linearVelocityB + cross(angularSpeedB, constraintPoint->rB) - linearVelocityA - cross(angularSpeedA, constraintPoint->rA);
-      float vt = dot(dv, tangent);
-      float lambda = constraintPoint->tangentMass * (-vt);
-      float maxFriction = friction * constraintPoint->normalImpulse;
-      float newImpulse = clamp(constraintPoint->tangentImpulse + lambda, -maxFriction, maxFriction);
-      lambda = newImpulse - constraintPoint->tangentImpulse;
-      constraintPoint->tangentImpulse = newImpulse;
-
-      Vector2 P = lambda * tangent;
+      float vn = dot(dv, normal);
+      float lambda = -constraintPoint->normalMass * (vn - constraintPoint->velocityBias);
+      float newImpulse = std::max(constraintPoint->normalImpulse + lambda, 0.0f);
+      lambda = newImpulse - constraintPoint->normalImpulse;
+      constraintPoint->normalImpulse = newImpulse;
+
+      Vector2 P = lambda * normal;
       linearVelocityA -= inverseMassA * P;
       angularSpeedA -= inverseInertiaA * cross(constraintPoint->rA, P);
       linearVelocityB += inverseMassB * P;
       angularSpeedB += inverseInertiaB * cross(constraintPoint->rB, P);
     }
+  }
+  else {
+    VelocityConstraint::VelocityConstraintPoint* constraintPointA = velocityConstraint->points + 0;
+    VelocityConstraint::VelocityConstraintPoint* constraintPointB = velocityConstraint->points + 1;
 
-    /* Normal constraints */
-    if(numPoints < MAX_MANIFOLD_POINTS) {
-      for(uint32 j = 0; j < numPoints; j++) {
-        VelocityConstraint::VelocityConstraintPoint* constraintPoint = velocityConstraint->points + j;
-        Vector2 dv = linearVelocityB + cross(angularSpeedB, constraintPoint->rB) - linearVelocityA - cross(angularSpeedA, constraintPoint->rA);
-        float vn = dot(dv, normal);
-        float lambda = -constraintPoint->normalMass * (vn - constraintPoint->velocityBias);
-        float newImpulse = std::max(constraintPoint->normalImpulse + lambda, 0.0f);
-        lambda = newImpulse - constraintPoint->normalImpulse;
-        constraintPoint->normalImpulse = newImpulse;
-
-        Vector2 P = lambda * normal;
-        linearVelocityA -= inverseMassA * P;
-        angularSpeedA -= inverseInertiaA * cross(constraintPoint->rA, P);
-        linearVelocityB += inverseMassB * P;
-        angularSpeedB += inverseInertiaB * cross(constraintPoint->rB, P);
-      }
-    }
-    else {
-      VelocityConstraint::VelocityConstraintPoint* constraintPointA = velocityConstraint->points + 0;
-      VelocityConstraint::VelocityConstraintPoint* constraintPointB = velocityConstraint->points + 1;
+    Vector2 a(constraintPointA->normalImpulse, constraintPointB->normalImpulse);
+    assert(a.x >= 0.0f && a.y >= 0.0f);
 
-      Vector2 a(constraintPointA->normalImpulse, constraintPointB->normalImpulse);
-      assert(a.x >= 0.0f && a.y >= 0.0f);
+    Vector2 dv1 = linearVelocityB + cross(angularSpeedB, constraintPointA->rB) - linearVelocityA - cross(angularSpeedA, constraintPointA->rA);
+    Vector2 dv2 = linearVelocityB + cross(angularSpeedB, constraintPointB->rB) - linearVelocityA - cross(angularSpeedA, constraintPointB->rA);
+    
+    float vn1 = dot(dv1, normal);
+    float vn2 = dot(dv2, normal);
 
-      Vector2 dv1 = linearVelocityB + cross(angularSpeedB, constraintPointA->rB) - linearVelocityA - cross(angularSpeedA, constraintPointA->rA);
-      Vector2 dv2 = linearVelocityB + cross(angularSpeedB, constraintPointB->rB) - linearVelocityA - cross(angularSpeedA, constraintPointB->rA);
-      
-      float vn1 = dot(dv1, normal);
-      float vn2 = dot(dv2, normal);
+    Vector2 b;
+    b.x = vn1 - constraintPointA->velocityBias;
+    b.y = vn2 - constraintPointB->velocityBias;
+    b -= velocityConstraint->K * a;
 
-      Vector2 b;
-      b.x = vn1 - constraintPointA->velocityBias;
-      b.y = vn2 - constraintPointB->velocityBias;
-      b -= velocityConstraint->K * a;
+    while(true) {
+      Vector2 x = -velocityConstraint->normalMass * b;
 
-      while(true) {
-        Vector2 x = -velocityConstraint->normalMass * b;
+      if(x.x >= 0.0f && x.y >= 0.0f) {
+        Vector2 d = x - a;
+        Vector2 PA = d.x * normal;
+        Vector2 PB = d.y * normal;
 
-        if(x.x >= 0.0f && x.y >= 0.0f) {
-          Vector2 d = x - a;
-          Vector2 PA = d.x * normal;
-          Vector2 PB = d.y * normal;
+        linearVelocityA -= inverseMassA * (PA + PB);
+        angularSpeedA -= inverseInertiaA * (cross(constraintPointA->rA, PA) + cross(constraintPointB->rA, PB));
+        linearVelocityB += inverseMassB * (PA + PB);
+        angularSpeedB += inverseInertiaB * (cross(constraintPointA->rB, PA) + cross(constraintPointB->rB, PB));
 
-          linearVelocityA -= inverseMassA * (PA + PB);
-          angularSpeedA -= inverseInertiaA * (cross(constraintPointA->rA, PA) + cross(constraintPointB->rA, PB));
-          linearVelocityB += inverseMassB * (PA + PB);
-          angularSpeedB += inverseInertiaB * (cross(constraintPointA->rB, PA) + cross(constraintPointB->rB, PB));
+        constraintPointA->normalImpulse = x.x;
+        constraintPointB->normalImpulse = x.y;
+        break;
+      }
 
-          constraintPointA->normalImpulse = x.x;
-          constraintPointB->normalImpulse = x.y;
-          break;
-        }
+      x.x = -constraintPointA->normalMass * b.x;
+      x.y = 0.0f;
+      vn1 = 0.0f;
+      Vector2 columnA = velocityConstraint->K.getColumn(0);
+      vn2 = columnA.y * x.x + b.y;
 
-        x.x = -constraintPointA->normalMass * b.x;
-        x.y = 0.0f;
-        vn1 = 0.0f;
-        Vector2 columnA = velocityConstraint->K.getColumn(0);
-        vn2 = columnA.y * x.x + b.y;
-
-        if(x.x >= 0.0f && vn2 >= 0.0f) {
-          Vector2 d = x - a;
-          Vector2 PA = d.x * normal;
-          Vector2 PB = d.y * normal;
-
-          linearVelocityA -= inverseMassA * (PA + PB);
-          angularSpeedA -= inverseInertiaA * (cross(constraintPointA->rA, PA) + cross(constraintPointB->rA, PB));
-          linearVelocityB += inverseMassB * (PA + PB);
-          angularSpeedB += inverseInertiaB * (cross(constraintPointA->rB, PA) + cross(constraintPointB->rB, PB));
-
-          constraintPointA->normalImpulse = x.x;
-          constraintPointB->normalImpulse = x.y;
-          break;
-        }
+      if(x.x >= 0.0f && vn2 >= 0.0f) {
+        Vector2 d = x - a;
+        Vector2 PA = d.x * normal;
+        Vector2 PB = d.y * normal;
 
-        x.x = 0.0f;
-        x.y = -constraintPointB->normalMass * b.y;
-        Vector2 columnB = velocityConstraint->K.getColumn(1);
-        vn1 = columnB.x * x.y + b.x;
-        vn2 = 0.0f;
-
-        if(x.y >= 0.0f && vn1 >= 0.0f) {
-          Vector2 d = x - a;
-          Vector2 PA = d.x * normal;
-          Vector2 PB = d.y * normal;
-
-          linearVelocityA -= inverseMassA * (PA + PB);
-          angularSpeedA -= inverseInertiaA * (cross(constraintPointA->rA, PA) + cross(constraintPointB->rA, PB));
-          linearVelocityB += inverseMassB * (PA + PB);
-          angularSpeedB += inverseInertiaB * (cross(constraintPointA->rB, PA) + cross(constraintPointB->rB, PB));
-
-          constraintPointA->normalImpulse = x.x;
-          constraintPointB->normalImpulse = x.y;
-          break;
-        }
+        linearVelocityA -= inverseMassA * (PA + PB);
+        angularSpeedA -= inverseInertiaA * (cross(constraintPointA->rA, PA) + cross(constraintPointB->rA, PB));
+        linearVelocityB += inverseMassB * (PA + PB);
+        angularSpeedB += inverseInertiaB * (cross(constraintPointA->rB, PA) + cross(constraintPointB->rB, PB));
 
-        x.x = 0.0f;
-        x.y = 0.0f;
-        vn1 = b.x;
-        vn2 = b.y;
+        constraintPointA->normalImpulse = x.x;
+        constraintPointB->normalImpulse = x.y;
+        break;
+      }
 
-        if(vn1 >= 0.0f && vn2 >= 0.0f) {
-          Vector2 d = x - a;
-          Vector2 PA = d.x * normal;
-          Vector2 PB = d.y * normal;
+      x.x = 0.0f;
+      x.y = -constraintPointB->normalMass * b.y;
+      Vector2 columnB = velocityConstraint->K.getColumn(1);
+      vn1 = columnB.x * x.y + b.x;
+      vn2 = 0.0f;
 
-          linearVelocityA -= inverseMassA * (PA + PB);
-          angularSpeedA -= inverseInertiaA * (cross(constraintPointA->rA, PA) + cross(constraintPointB->rA, PB));
-          linearVelocityB += inverseMassB * (PA + PB);
-          angularSpeedB += inverseInertiaB * (cross(constraintPointA->rB, PA) + cross(constraintPointB->rB, PB));
+      if(x.y >= 0.0f && vn1 >= 0.0f) {
+        Vector2 d = x - a;
+        Vector2 PA = d.x * normal;
+        Vector2 PB = d.y * normal;
 
-          constraintPointA->normalImpulse = x.x;
-          constraintPointB->normalImpulse = x.y;
-          break;
-        }
+        linearVelocityA -= inverseMassA * (PA + PB);
+        angularSpeedA -= inverseInertiaA * (cross(constraintPointA->rA, PA) + cross(constraintPointB->rA, PB));
+        linearVelocityB += inverseMassB * (PA + PB);
+        angularSpeedB += inverseInertiaB * (cross(constraintPointA->rB, PA) + cross(constraintPointB->rB, PB));
+
+        constraintPointA->normalImpulse = x.x;
+        constraintPointB->normalImpulse = x.y;
+        break;
+      }
+
+      x.x = 0.0f;
+      x.y = 0.0f;
+      vn1 = b.x;
+      vn2 = b.y;
+
+      if(vn1 >= 0.0f && vn2 >= 0.0f) {
+        Vector2 d = x - a;
+        Vector2 PA = d.x * normal;
+        Vector2 PB = d.y * normal;
+
+        linearVelocityA -= inverseMassA * (PA + PB);
+        angularSpeedA -= inverseInertiaA * (cross(constraintPointA->rA, PA) + cross(constraintPointB->rA, PB));
+        linearVelocityB += inverseMassB * (PA + PB);
+        angularSpeedB += inverseInertiaB * (cross(constraintPointA->rB, PA) + cross(constraintPointB->rB, PB));
 
-        /* No solution */
+        constraintPointA->normalImpulse = x.x;
+        constraintPointB->normalImpulse = x.y;
         break;
       }
+
+      /* No solution */
+      break;
     }
+  }
 
+  /* Static bodies may be shared by islands that are solved concurrently so only write back bodies that can move */
+  if(inverseMassA > 0.0f || inverseInertiaA > 0.0f) {
     mBodyComponents.mLinearVelocitiesConstrained[firstBodyIndex] = linearVelocityA;
     mBodyComponents.mAngularSpeedsConstrained[firstBodyIndex] = angularSpeedA;
+  }
+
+  if(inverseMassB > 0.0f || inverseInertiaB > 0.0f) {
     mBodyComponents.mLinearVelocitiesConstrained[secondBodyIndex] = linearVelocityB;
     mBodyComponents.mAngularSpeedsConstrained[secondBodyIndex] = angularSpeedB;
   }
 }
 
-/* Solve position constraints */
-void ContactSolver::solvePositionConstraints() {
+/* Solve a single position constraint and return its minimum separation */
+float ContactSolver::solvePositionConstraint(uint32 i) {
   float minSeparation = 0.0f;
-  uint32 islandStartManifoldIndex = 0;
-  uint32 islandIndex = mIslands.getIslandIndex(islandStartManifoldIndex);
-  uint32 totalIslandManifolds = mIslands.numManifolds[islandIndex];
-  uint32 accountedIslandManifolds = 0;
-
-  for(uint32 i = 0; i < mNumManifolds; i++) {
-    if(accountedIslandManifolds == totalIslandManifolds) {
-      islandStartManifoldIndex += totalIslandManifolds;
-      islandIndex = mIslands.getIslandIndex(islandStartManifoldIndex);
-      totalIslandManifolds = mIslands.numManifolds[islandIndex];
-      accountedIslandManifolds = 0;
+
+  PositionConstraint* positionConstraint = mPositionConstraints + i;
+  const uint32 firstBodyIndex = positionConstraint->indexA;
+  const uint32 secondBodyIndex = positionConstraint->indexB;
+  Vector2 localCenterA = positionConstraint->localCenterA;
+  float inverseMassA = positionConstraint->inverseMassA;
+  float inverseInertiaA = positionConstraint->inverseInertiaA;
+  Vector2 localCenterB = positionConstraint->localCenterB;
+  float inverseMassB = positionConstraint->inverseMassB;
+  float inverseInertiaB = positionConstraint->inverseInertiaB;
+  uint32 numPoints = positionConstraint->numPoints;
+
+  Vector2 positionA = mBodyComponents.mPositionsConstrained[firstBodyIndex];
+  float angleA = mBodyComponents.mOrientationsConstrained[firstBodyIndex].getAngle();
+  Vector2 positionB = mBodyComponents.mPositionsConstrained[secondBodyIndex];
+  float angleB = mBodyComponents.mOrientationsConstrained[secondBodyIndex].getAngle();
+
+  for(uint32 j = 0; j < numPoints; j++) {
+    Transform transformA;
+    Transform transformB;
+    transformA.setOrientation(Rotation(angleA));
+    transformB.setOrientation(Rotation(angleB));
+    transformA.setPosition(positionA - (transformA.getOrientation() * localCenterA));
+    transformB.setPosition(positionB - (transformB.getOrientation() * localCenterB));
+
+    PositionSolverInfo solverInfo(positionConstraint, transformA, transformB, j);
+    Vector2 normal = solverInfo.normal;
+    Vector2 point = solverInfo.point;
+    float separation = solverInfo.separation;
+    Vector2 rA = point - positionA;
+    Vector2 rB = point - positionB;
+    minSeparation = std::min(minSeparation, separation);
+
+    float C = clamp(BAUMGARTE * (separation + LINEAR_SLOP), -MAX_LINEAR_CORRECTION, 0.0f);
+    float rnA = cross(rA, normal);
+    float rnB = cross(rB, normal);
+    float K = inverseMassA + inverseMassB + inverseInertiaA * rnA * rnA + inverseInertiaB * rnB * rnB;
+    float impulse = K > 0.0f ? -C / K: 0.0f;
+
+    Vector2 P = impulse * normal;
+    positionA -= inverseMassA * P;
+    angleA -= inverseInertiaA * cross(rA, P);
+    positionB += inverseMassB * P;
+    angleB += inverseInertiaB * cross(rB, P);
+  }
+
+  /* Static bodies may be shared by islands that are solved concurrently so only write back bodies that can move */
+  if(inverseMassA > 0.0f || inverseInertiaA > 0.0f) {
+    mBodyComponents.mPositionsConstrained[firstBodyIndex] = positionA;
+    mBodyComponents.mOrientationsConstrained[firstBodyIndex] = Rotation(angleA);
+  }
+
+  if(inverseMassB > 0.0f || inverseInertiaB > 0.0f) {
+    mBodyComponents.mPositionsConstrained[secondBodyIndex] = positionB;
+    mBodyComponents.mOrientationsConstrained[secondBodyIndex] = Rotation(angleB);
+  }
+
+  return minSeparation;
+}
+
+/* Query whether the constraints of the given color are packed into wide constraints */
+bool ContactSolver::isColorWide(uint32 coloredIslandIndex, uint32 color) const {
+  /* The constraints of the last color may share bodies so they cannot be packed into lanes */
+  return mIsSimdSolverEnabled && color - mIslandColors[coloredIslandIndex] != GRAPH_COLORING_MAX_COLORS - 1u;
+}
+
+/* Pack the constraints of the given wide constraint into lanes */
+void ContactSolver::packWideConstraint(uint32 color, uint32 wideIndex) {
+  const uint32 begin = mColorOffsets[color] + (wideIndex - mColorWideConstraints[color]) * SIMD_WIDTH;
+  const uint32 numLanes = std::min(mColorOffsets[color + 1] - begin, SIMD_WIDTH);
+  WideVelocityConstraint* wideVelocityConstraint = mWideVelocityConstraints + wideIndex;
+  WidePositionConstraint* widePositionConstraint = mWidePositionConstraints + wideIndex;
+
+  /* Unused lanes and points have no mass and no impulse so solving them has no effect */
+  std::memset(wideVelocityConstraint, 0, sizeof(WideVelocityConstraint));
+  std::memset(widePositionConstraint, 0, sizeof(WidePositionConstraint));
+  wideVelocityConstraint->numLanes = numLanes;
+  widePositionConstraint->numLanes = numLanes;
+
+  for(uint32 i = 0; i < numLanes; i++) {
+    const uint32 manifoldIndex = mColorManifolds[begin + i];
+    const VelocityConstraint* velocityConstraint = mVelocityConstraints + manifoldIndex;
+    const PositionConstraint* positionConstraint = mPositionConstraints + manifoldIndex;
+    const uint32 firstBodyIndex = velocityConstraint->indexA;
+    const uint32 secondBodyIndex = velocityConstraint->indexB;
+
+    wideVelocityConstraint->indicesA[i] = firstBodyIndex;
+    wideVelocityConstraint->indicesB[i] = secondBodyIndex;
+    wideVelocityConstraint->normalX[i] = velocityConstraint->normal.x;
+    wideVelocityConstraint->normalY[i] = velocityConstraint->normal.y;
+    wideVelocityConstraint->inverseMassA[i] = velocityConstraint->inverseMassA;
+    wideVelocityConstraint->inverseMassB[i] = velocityConstraint->inverseMassB;
+    wideVelocityConstraint->inverseInertiaA[i] = velocityConstraint->inverseInertiaA;
+    wideVelocityConstraint->inverseInertiaB[i] = velocityConstraint->inverseInertiaB;
+    wideVelocityConstraint->friction[i] = velocityConstraint->friction;
+    wideVelocityConstraint->isBlockSolved[i] = velocityConstraint->numPoints == MAX_MANIFOLD_POINTS ? 1.0f : 0.0f;
+
+    for(uint32 j = 0; j < 2; j++) {
+      for(uint32 k = 0; k < 2; k++) {
+        wideVelocityConstraint->K[j][k][i] = velocityConstraint->K[j][k];
+        wideVelocityConstraint->normalMass[j][k][i] = velocityConstraint->normalMass[j][k];
+      }
     }
 
-    LocalManifold& localManifold = (*mManifolds)[i];
-    assert(localManifold.info.numPoints);
+    for(uint32 j = 0; j < velocityConstraint->numPoints; j++) {
+      const VelocityConstraint::VelocityConstraintPoint* constraintPoint = velocityConstraint->points + j;
+      WideVelocityConstraint::WideVelocityConstraintPoint* wideConstraintPoint = wideVelocityConstraint->points + j;
+      wideConstraintPoint->rAX[i] = constraintPoint->rA.x;
+      wideConstraintPoint->rAY[i] = constraintPoint->rA.y;
+      wideConstraintPoint->rBX[i] = constraintPoint->rB.x;
+      wideConstraintPoint->rBY[i] = constraintPoint->rB.y;
+      wideConstraintPoint->normalMass[i] = constraintPoint->normalMass;
+      wideConstraintPoint->tangentMass[i] = constraintPoint->tangentMass;
+      wideConstraintPoint->normalImpulse[i] = constraintPoint->normalImpulse;
+      wideConstraintPoint->tangentImpulse[i] = constraintPoint->tangentImpulse;
+      wideConstraintPoint->velocityBias[i] = constraintPoint->velocityBias;
+    }
 
-    const uint32 firstBodyIndex = mBodyComponents.getComponentEntityIndex(localManifold.firstBodyEntity);
-    const uint32 secondBodyIndex = mBodyComponents.getComponentEntityIndex(localManifold.secondBodyEntity);
+    widePositionConstraint->indicesA[i] = firstBodyIndex;
+    widePositionConstraint->indicesB[i] = secondBodyIndex;
+    widePositionConstraint->localNormalX[i] = positionConstraint->localNormal.x;
+    widePositionConstraint->localNormalY[i] = positionConstraint->localNormal.y;
+    widePositionConstraint->localPointX[i] = positionConstraint->localPoint.x;
+    widePositionConstraint->localPointY[i] = positionConstraint->localPoint.y;
+    widePositionConstraint->localCenterAX[i] = positionConstraint->localCenterA.x;
+    widePositionConstraint->localCenterAY[i] = positionConstraint->localCenterA.y;
+    widePositionConstraint->localCenterBX[i] = positionConstraint->localCenterB.x;
+    widePositionConstraint->localCenterBY[i] = positionConstraint->localCenterB.y;
+    widePositionConstraint->inverseMassA[i] = positionConstraint->inverseMassA;
+    widePositionConstraint->inverseMassB[i] = positionConstraint->inverseMassB;
+    widePositionConstraint->inverseInertiaA[i] = positionConstraint->inverseInertiaA;
+    widePositionConstraint->inverseInertiaB[i] = positionConstraint->inverseInertiaB;
+    widePositionConstraint->radiusA[i] = positionConstraint->radiusA;
+    widePositionConstraint->radiusB[i] = positionConstraint->radiusB;
+    widePositionConstraint->type[i] = static_cast<float>(positionConstraint->type);
+    widePositionConstraint->numPoints[i] = static_cast<float>(positionConstraint->numPoints);
+
+    for(uint32 j = 0; j < positionConstraint->numPoints; j++) {
+      widePositionConstraint->pointX[j][i] = positionConstraint->points[j].x;
+      widePositionConstraint->pointY[j][i] = positionConstraint->points[j].y;
+    }
+  }
+}
 
-    PositionConstraint* positionConstraint = mPositionConstraints + i;
-    Vector2 localCenterA = positionConstraint->localCenterA;
-    float inverseMassA = positionConstraint->inverseMassA;
-    float inverseInertiaA = positionConstraint->inverseInertiaA;
-    Vector2 localCenterB = positionConstraint->localCenterB;
-    float inverseMassB = positionConstraint->inverseMassB;
-    float inverseInertiaB = positionConstraint->inverseInertiaB;
-    uint32 numPoints = positionConstraint->numPoints;
+/* Copy the impulses of the given wide constraint back to the constraints of its lanes */
+void ContactSolver::unpackWideConstraint(uint32 color, uint32 wideIndex) {
+  const uint32 begin = mColorOffsets[color] + (wideIndex - mColorWideConstraints[color]) * SIMD_WIDTH;
+  const WideVelocityConstraint* wideVelocityConstraint = mWideVelocityConstraints + wideIndex;
 
-    Vector2 positionA = mBodyComponents.mPositionsConstrained[firstBodyIndex];
-    float angleA = mBodyComponents.mOrientationsConstrained[firstBodyIndex].getAngle();
-    Vector2 positionB = mBodyComponents.mPositionsConstrained[secondBodyIndex];
-    float angleB = mBodyComponents.mOrientationsConstrained[secondBodyIndex].getAngle();
+  for(uint32 i = 0; i < wideVelocityConstraint->numLanes; i++) {
+    VelocityConstraint* velocityConstraint = mVelocityConstraints + mColorManifolds[begin + i];
 
-    for(uint32 j = 0; j < numPoints; j++) {
-      Transform transformA;
-      Transform transformB;
-      transformA.setOrientation(Rotation(angleA));
-      transformB.setOrientation(Rotation(angleB));
-      transformA.setPosition(positionA - (transformA.getOrientation() * localCenterA));
-      transformB.setPosition(positionB - (transformB.getOrientation() * localCenterB));
-
-      PositionSolverInfo solverInfo(positionConstraint, transformA, transformB, j);
-      Vector2 normal = solverInfo.normal;
-      Vector2 point = solverInfo.point;
-      float separation = solverInfo.separation;
-      Vector2 rA = point - positionA;
-      Vector2 rB = point - positionB;
-      minSeparation = std::min(minSeparation, separation);
-
-      float C = clamp(BAUMGARTE * (separation + LINEAR_SLOP), -MAX_LINEAR_CORRECTION, 0.0f);
-      float rnA = cross(rA, normal);
-      float rnB = cross(rB, normal);
-      float K = inverseMassA + inverseMassB + inverseInertiaA * rnA * rnA + inverseInertiaB * rnB * rnB;
-      float impulse = K > 0.0f ? -C / K: 0.0f;
-
-      Vector2 P = impulse * normal;
-      positionA -= inverseMassA * P;
-      angleA -= inverseInertiaA * cross(rA, P);
-      positionB += inverseMassB * P;
-      angleB += inverseInertiaB * cross(rB, P);
+    for(uint32 j = 0; j < velocityConstraint->numPoints; j++) {
+      velocityConstraint->points[j].normalImpulse = wideVelocityConstraint->points[j].normalImpulse[i];
+      velocityConstraint->points[j].tangentImpulse = wideVelocityConstraint->points[j].tangentImpulse[i];
     }
+  }
+}
 
-    mBodyComponents.mPositionsConstrained[firstBodyIndex] = positionA;
-    mBodyComponents.mOrientationsConstrained[firstBodyIndex] = Rotation(angleA);
-    mBodyComponents.mPositionsConstrained[secondBodyIndex] = positionB;
-    mBodyComponents.mOrientationsConstrained[secondBodyIndex] = Rotation(angleB);
+/* Load the velocities of the bodies with the given indices */
+void ContactSolver::loadVelocities(const uint32* indices, uint32 numLanes, SimdVector2& linearVelocity, SimdFloat& angularSpeed) const {
+  float linearVelocitiesX[SIMD_WIDTH] = {};
+  float linearVelocitiesY[SIMD_WIDTH] = {};
+  float angularSpeeds[SIMD_WIDTH] = {};
+
+  for(uint32 i = 0; i < numLanes; i++) {
+    const Vector2& bodyLinearVelocity = mBodyComponents.mLinearVelocitiesConstrained[indices[i]];
+    linearVelocitiesX[i] = bodyLinearVelocity.x;
+    linearVelocitiesY[i] = bodyLinearVelocity.y;
+    angularSpeeds[i] = mBodyComponents.mAngularSpeedsConstrained[indices[i]];
+  }
 
-    mIslands.solved[islandIndex] = mIslands.solved[islandIndex] && (minSeparation >= -3.0f * LINEAR_SLOP);
-    accountedIslandManifolds++;
+  linearVelocity.x = simdLoad(linearVelocitiesX);
+  linearVelocity.y = simdLoad(linearVelocitiesY);
+  angularSpeed = simdLoad(angularSpeeds);
+}
+
+/* Store the velocities of the bodies with the given indices which can move */
+void ContactSolver::storeVelocities(const uint32* indices, const float* inverseMasses, const float* inverseInertias, uint32 numLanes, const SimdVector2& linearVelocity, const SimdFloat& angularSpeed) {
+  float linearVelocitiesX[SIMD_WIDTH];
+  float linearVelocitiesY[SIMD_WIDTH];
+  float angularSpeeds[SIMD_WIDTH];
+  simdStore(linearVelocitiesX, linearVelocity.x);
+  simdStore(linearVelocitiesY, linearVelocity.y);
+  simdStore(angularSpeeds, angularSpeed);
+
+  /* Static bodies may be shared by lanes and by islands that are solved concurrently so only write back bodies that can move */
+  for(uint32 i = 0; i < numLanes; i++) {
+    if(inverseMasses[i] > 0.0f || inverseInertias[i] > 0.0f) {
+      mBodyComponents.mLinearVelocitiesConstrained[indices[i]] = Vector2(linearVelocitiesX[i], linearVelocitiesY[i]);
+      mBodyComponents.mAngularSpeedsConstrained[indices[i]] = angularSpeeds[i];
+    }
+  }
+}
+
+/* Load the positions and angles of the bodies with the given indices */
+void ContactSolver::loadPositions(const uint32* indices, uint32 numLanes, SimdVector2& position, SimdFloat& angle) const {
+  float positionsX[SIMD_WIDTH] = {};
+  float positionsY[SIMD_WIDTH] = {};
+  float angles[SIMD_WIDTH] = {};
+
+  for(uint32 i = 0; i < numLanes; i++) {
+    const Vector2& bodyPosition = mBodyComponents.mPositionsConstrained[indices[i]];
+    positionsX[i] = bodyPosition.x;
+    positionsY[i] = bodyPosition.y;
+    angles[i] = mBodyComponents.mOrientationsConstrained[indices[i]].getAngle();
+  }
+
+  position.x = simdLoad(positionsX);
+  position.y = simdLoad(positionsY);
+  angle = simdLoad(angles);
+}
+
+/* Store the positions and angles of the bodies with the given indices which can move */
+void ContactSolver::storePositions(const uint32* indices, const float* inverseMasses, const float* inverseInertias, uint32 numLanes, const SimdVector2& position, const SimdFloat& angle) {
+  float positionsX[SIMD_WIDTH];
+  float positionsY[SIMD_WIDTH];
+  float angles[SIMD_WIDTH];
+  simdStore(positionsX, position.x);
+  simdStore(positionsY, position.y);
+  simdStore(angles, angle);
+
+  /* Static bodies may be shared by lanes and by islands that are solved concurrently so only write back bodies that can move */
+  for(uint32 i = 0; i < numLanes; i++) {
+    if(inverseMasses[i] > 0.0f || inverseInertias[i] > 0.0f) {
+      mBodyComponents.mPositionsConstrained[indices[i]] = Vector2(positionsX[i], positionsY[i]);
+      mBodyComponents.mOrientationsConstrained[indices[i]] = Rotation(angles[i]);
+    }
+  }
+}
+
+/* Warm start a wide velocity constraint */
+void ContactSolver::warmStartWideConstraint(uint32 wideIndex) {
+  WideVelocityConstraint* velocityConstraint = mWideVelocityConstraints + wideIndex;
+  const SimdFloat inverseMassA = simdLoad(velocityConstraint->inverseMassA);
+  const SimdFloat inverseInertiaA = simdLoad(velocityConstraint->inverseInertiaA);
+  const SimdFloat inverseMassB = simdLoad(velocityConstraint->inverseMassB);
+  const SimdFloat inverseInertiaB = simdLoad(velocityConstraint->inverseInertiaB);
+
+  SimdVector2 linearVelocityA;
+  SimdFloat angularSpeedA;
+  SimdVector2 linearVelocityB;
+  SimdFloat angularSpeedB;
+  loadVelocities(velocityConstraint->indicesA, velocityConstraint->numLanes, linearVelocityA, angularSpeedA);
+  loadVelocities(velocityConstraint->indicesB, velocityConstraint->numLanes, linearVelocityB, angularSpeedB);
+
+  const SimdVector2 normal = {simdLoad(velocityConstraint->normalX), simdLoad(velocityConstraint->normalY)};
+  const SimdVector2 tangent = {normal.y, -normal.x};
+
+  for(uint32 j = 0; j < MAX_MANIFOLD_POINTS; j++) {
+    const WideVelocityConstraint::WideVelocityConstraintPoint* constraintPoint = velocityConstraint->points + j;
+    const SimdVector2 rA = {simdLoad(constraintPoint->rAX), simdLoad(constraintPoint->rAY)};
+    const SimdVector2 rB = {simdLoad(constraintPoint->rBX), simdLoad(constraintPoint->rBY)};
+    const SimdVector2 P = simdLoad(constraintPoint->normalImpulse) * normal + simdLoad(constraintPoint->tangentImpulse) * tangent;
+    angularSpeedA = angularSpeedA - inverseInertiaA * cross(rA, P);
+    linearVelocityA = linearVelocityA - inverseMassA * P;
+    angularSpeedB = angularSpeedB + inverseInertiaB * cross(rB, P);
+    linearVelocityB = linearVelocityB + inverseMassB * P;
+  }
+
+  storeVelocities(velocityConstraint->indicesA, velocityConstraint->inverseMassA, velocityConstraint->inverseInertiaA, velocityConstraint->numLanes, linearVelocityA, angularSpeedA);
+  storeVelocities(velocityConstraint->indicesB, velocityConstraint->inverseMassB, velocityConstraint->inverseInertiaB, velocityConstraint->numLanes, linearVelocityB, angularSpeedB);
+}
+
+/* Solve a wide velocity constraint */
+void ContactSolver::solveWideVelocityConstraint(uint32 wideIndex) {
+  WideVelocityConstraint* velocityConstraint = mWideVelocityConstraints + wideIndex;
+  const SimdFloat zero = simdZero();
+  const SimdFloat inverseMassA = simdLoad(velocityConstraint->inverseMassA);
+  const SimdFloat inverseInertiaA = simdLoad(velocityConstraint->inverseInertiaA);
+  const SimdFloat inverseMassB = simdLoad(velocityConstraint->inverseMassB);
+  const SimdFloat inverseInertiaB = simdLoad(velocityConstraint->inverseInertiaB);
+
+  SimdVector2 linearVelocityA;
+  SimdFloat angularSpeedA;
+  SimdVector2 linearVelocityB;
+  SimdFloat angularSpeedB;
+  loadVelocities(velocityConstraint->indicesA, velocityConstraint->numLanes, linearVelocityA, angularSpeedA);
+  loadVelocities(velocityConstraint->indicesB, velocityConstraint->numLanes, linearVelocityB, angularSpeedB);
+
+  const SimdVector2 normal = {simdLoad(velocityConstraint->normalX), simdLoad(velocityConstraint->normalY)};
+  const SimdVector2 tangent = {normal.y, -normal.x};
+  const SimdFloat friction = simdLoad(velocityConstraint->friction);
+
+  SimdVector2 rA[MAX_MANIFOLD_POINTS];
+  SimdVector2 rB[MAX_MANIFOLD_POINTS];
+
+  for(uint32 j = 0; j < MAX_MANIFOLD_POINTS; j++) {
+    rA[j] = {simdLoad(velocityConstraint->points[j].rAX), simdLoad(velocityConstraint->points[j].rAY)};
+    rB[j] = {simdLoad(velocityConstraint->points[j].rBX), simdLoad(velocityConstraint->points[j].rBY)};
   }
+
+  /* Tangent constraints */
+  for(uint32 j = 0; j < MAX_MANIFOLD_POINTS; j++) {
+    WideVelocityConstraint::WideVelocityConstraintPoint* constraintPoint = velocityConstraint->points + j;
+    const SimdVector2 dv = linearVelocityB + cross(angularSpeedB, rB[j]) - linearVelocityA - cross(angularSpeedA, rA[j]);
+    const SimdFloat vt = dot(dv, tangent);
+    const SimdFloat tangentImpulse = simdLoad(constraintPoint->tangentImpulse);
+    const SimdFloat maxFriction = friction * simdLoad(constraintPoint->normalImpulse);
+    const SimdFloat newImpulse = simdClamp(tangentImpulse + simdLoad(constraintPoint->tangentMass) * (-vt), -maxFriction, maxFriction);
+    const SimdFloat lambda = newImpulse - tangentImpulse;
+    simdStore(constraintPoint->tangentImpulse, newImpulse);
+
+    const SimdVector2 P = lambda * tangent;
+    linearVelocityA = linearVelocityA - inverseMassA * P;
+    angularSpeedA = angularSpeedA - inverseInertiaA * cross(rA[j], P);
+    linearVelocityB = linearVelocityB + inverseMassB * P;
+    angularSpeedB = angularSpeedB + inverseInertiaB * cross(rB[j], P);
+  }
+
+  /* Normal constraints of lanes with a single point, the second point of such lanes has no mass so it is left untouched */
+  SimdVector2 sequentialLinearVelocityA = linearVelocityA;
+  SimdFloat sequentialAngularSpeedA = angularSpeedA;
+  SimdVector2 sequentialLinearVelocityB = linearVelocityB;
+  SimdFloat sequentialAngularSpeedB = angularSpeedB;
+  SimdFloat sequentialNormalImpulses[MAX_MANIFOLD_POINTS];
+
+  for(uint32 j = 0; j < MAX_MANIFOLD_POINTS; j++) {
+    const WideVelocityConstraint::WideVelocityConstraintPoint* constraintPoint = velocityConstraint->points + j;
+    const SimdVector2 dv = sequentialLinearVelocityB + cross(sequentialAngularSpeedB, rB[j]) - sequentialLinearVelocityA - cross(sequentialAngularSpeedA, rA[j]);
+    const SimdFloat vn = dot(dv, normal);
+    const SimdFloat normalImpulse = simdLoad(constraintPoint->normalImpulse);
+    const SimdFloat newImpulse = simdMax(normalImpulse + (-simdLoad(constraintPoint->normalMass)) * (vn - simdLoad(constraintPoint->velocityBias)), zero);
+    const SimdFloat lambda = newImpulse - normalImpulse;
+    sequentialNormalImpulses[j] = newImpulse;
+
+    const SimdVector2 P = lambda * normal;
+    sequentialLinearVelocityA = sequentialLinearVelocityA - inverseMassA * P;
+    sequentialAngularSpeedA = sequentialAngularSpeedA - inverseInertiaA * cross(rA[j], P);
+    sequentialLinearVelocityB = sequentialLinearVelocityB + inverseMassB * P;
+    sequentialAngularSpeedB = sequentialAngularSpeedB + inverseInertiaB * cross(rB[j], P);
+  }
+
+  /* Normal constraints of lanes using the block solver where the first case of the linear complementarity problem that holds is picked */
+  const SimdVector2 a = {simdLoad(velocityConstraint->points[0].normalImpulse), simdLoad(velocityConstraint->points[1].normalImpulse)};
+  const SimdVector2 dv1 = linearVelocityB + cross(angularSpeedB, rB[0]) - linearVelocityA - cross(angularSpeedA, rA[0]);
+  const SimdVector2 dv2 = linearVelocityB + cross(angularSpeedB, rB[1]) - linearVelocityA - cross(angularSpeedA, rA[1]);
+  const SimdFloat K00 = simdLoad(velocityConstraint->K[0][0]);
+  const SimdFloat K01 = simdLoad(velocityConstraint->K[0][1]);
+  const SimdFloat K10 = simdLoad(velocityConstraint->K[1][0]);
+  const SimdFloat K11 = simdLoad(velocityConstraint->K[1][1]);
+
+  SimdVector2 b;
+  b.x = dot(dv1, normal) - simdLoad(velocityConstraint->points[0].velocityBias);
+  b.y = dot(dv2, normal) - simdLoad(velocityConstraint->points[1].velocityBias);
+  b.x = b.x - (K00 * a.x + K01 * a.y);
+  b.y = b.y - (K10 * a.x + K11 * a.y);
+
+  /* Both points are active */
+  const SimdVector2 x1 = {(-simdLoad(velocityConstraint->normalMass[0][0])) * b.x + (-simdLoad(velocityConstraint->normalMass[0][1])) * b.y,
+                          (-simdLoad(velocityConstraint->normalMass[1][0])) * b.x + (-simdLoad(velocityConstraint->normalMass[1][1])) * b.y};
+  const SimdFloat isCase1 = simdAnd(simdGreaterEqual(x1.x, zero), simdGreaterEqual(x1.y, zero));
+
+  /* Only the first point is active */
+  const SimdVector2 x2 = {(-simdLoad(velocityConstraint->points[0].normalMass)) * b.x, zero};
+  const SimdFloat isCase2 = simdAnd(simdGreaterEqual(x2.x, zero), simdGreaterEqual(K10 * x2.x + b.y, zero));
+
+  /* Only the second point is active */
+  const SimdVector2 x3 = {zero, (-simdLoad(velocityConstraint->points[1].normalMass)) * b.y};
+  const SimdFloat isCase3 = simdAnd(simdGreaterEqual(x3.y, zero), simdGreaterEqual(K01 * x3.y + b.x, zero));
+
+  /* No point is active */
+  const SimdVector2 x4 = {zero, zero};
+  const SimdFloat isCase4 = simdAnd(simdGreaterEqual(b.x, zero), simdGreaterEqual(b.y, zero));
+
+  /* Lanes without a solution keep their impulses */
+  const SimdVector2 x = simdSelect(isCase1, x1, simdSelect(isCase2, x2, simdSelect(isCase3, x3, simdSelect(isCase4, x4, a))));
+  const SimdVector2 d = x - a;
+  const SimdVector2 PA = d.x * normal;
+  const SimdVector2 PB = d.y * normal;
+  const SimdVector2 blockLinearVelocityA = linearVelocityA - inverseMassA * (PA + PB);
+  const SimdFloat blockAngularSpeedA = angularSpeedA - inverseInertiaA * (cross(rA[0], PA) + cross(rA[1], PB));
+  const SimdVector2 blockLinearVelocityB = linearVelocityB + inverseMassB * (PA + PB);
+  const SimdFloat blockAngularSpeedB = angularSpeedB + inverseInertiaB * (cross(rB[0], PA) + cross(rB[1], PB));
+
+  const SimdFloat isBlockSolved = simdGreater(simdLoad(velocityConstraint->isBlockSolved), zero);
+  simdStore(velocityConstraint->points[0].normalImpulse, simdSelect(isBlockSolved, x.x, sequentialNormalImpulses[0]));
+  simdStore(velocityConstraint->points[1].normalImpulse, simdSelect(isBlockSolved, x.y, sequentialNormalImpulses[1]));
+  linearVelocityA = simdSelect(isBlockSolved, blockLinearVelocityA, sequentialLinearVelocityA);
+  angularSpeedA = simdSelect(isBlockSolved, blockAngularSpeedA, sequentialAngularSpeedA);
+  linearVelocityB = simdSelect(isBlockSolved, blockLinearVelocityB, sequentialLinearVelocityB);
+  angularSpeedB = simdSelect(isBlockSolved, blockAngularSpeedB, sequentialAngularSpeedB);
+
+  storeVelocities(velocityConstraint->indicesA, velocityConstraint->inverseMassA, velocityConstraint->inverseInertiaA, velocityConstraint->numLanes, linearVelocityA, angularSpeedA);
+  storeVelocities(velocityConstraint->indicesB, velocityConstraint->inverseMassB, velocityConstraint->inverseInertiaB, velocityConstraint->numLanes, linearVelocityB, angularSpeedB);
 }
 
-/* Store impulses for warm starting in the next frame */
-void ContactSolver::storeImpulses() {
-  for(uint32 i = 0; i < mNumManifolds; i++) {
+/* Solve a wide position constraint and return its minimum separation */
+float ContactSolver::solveWidePositionConstraint(uint32 wideIndex) {
+  WidePositionConstraint* positionConstraint = mWidePositionConstraints + wideIndex;
+  const SimdFloat zero = simdZero();
+  const SimdFloat one = simdSet(1.0f);
+  const SimdVector2 localCenterA = {simdLoad(positionConstraint->localCenterAX), simdLoad(positionConstraint->localCenterAY)};
+  const SimdVector2 localCenterB = {simdLoad(positionConstraint->localCenterBX), simdLoad(positionConstraint->localCenterBY)};
+  const SimdVector2 localNormal = {simdLoad(positionConstraint->localNormalX), simdLoad(positionConstraint->localNormalY)};
+  const SimdVector2 localPoint = {simdLoad(positionConstraint->localPointX), simdLoad(positionConstraint->localPointY)};
+  const SimdFloat inverseMassA = simdLoad(positionConstraint->inverseMassA);
+  const SimdFloat inverseInertiaA = simdLoad(positionConstraint->inverseInertiaA);
+  const SimdFloat inverseMassB = simdLoad(positionConstraint->inverseMassB);
+  const SimdFloat inverseInertiaB = simdLoad(positionConstraint->inverseInertiaB);
+  const SimdFloat radiusA = simdLoad(positionConstraint->radiusA);
+  const SimdFloat radiusB = simdLoad(positionConstraint->radiusB);
+  const SimdFloat numPoints = simdLoad(positionConstraint->numPoints);
+  const SimdFloat type = simdLoad(positionConstraint->type);
+  const SimdFloat isCircles = simdEqual(type, simdSet(static_cast<float>(LocalManifoldInfo::ManifoldType::Circles)));
+  const SimdFloat isFaceA = simdEqual(type, simdSet(static_cast<float>(LocalManifoldInfo::ManifoldType::FaceA)));
+
+  SimdVector2 positionA;
+  SimdFloat angleA;
+  SimdVector2 positionB;
+  SimdFloat angleB;
+  loadPositions(positionConstraint->indicesA, positionConstraint->numLanes, positionA, angleA);
+  loadPositions(positionConstraint->indicesB, positionConstraint->numLanes, positionB, angleB);
+  SimdFloat minSeparation = zero;
+
+  for(uint32 j = 0; j < MAX_MANIFOLD_POINTS; j++) {
+    const SimdFloat isPoint = simdGreater(numPoints, simdSet(static_cast<float>(j)));
+
+    /* Trigonometric functions have no vector counterpart so the rotations are computed per lane */
+    float angles[2][SIMD_WIDTH];
+    float sines[2][SIMD_WIDTH];
+    float cosines[2][SIMD_WIDTH];
+    simdStore(angles[0], angleA);
+    simdStore(angles[1], angleB);
+
+    for(uint32 k = 0; k < SIMD_WIDTH; k++) {
+      const Rotation rotationA(angles[0][k]);
+      const Rotation rotationB(angles[1][k]);
+      sines[0][k] = rotationA.s;
+      cosines[0][k] = rotationA.c;
+      sines[1][k] = rotationB.s;
+      cosines[1][k] = rotationB.c;
+    }
+
+    const SimdFloat sA = simdLoad(sines[0]);
+    const SimdFloat cA = simdLoad(cosines[0]);
+    const SimdFloat sB = simdLoad(sines[1]);
+    const SimdFloat cB = simdLoad(cosines[1]);
+    const SimdVector2 translationA = {positionA.x - (cA * localCenterA.x - sA * localCenterA.y), positionA.y - (sA * localCenterA.x + cA * localCenterA.y)};
+    const SimdVector2 translationB = {positionB.x - (cB * localCenterB.x - sB * localCenterB.y), positionB.y - (sB * localCenterB.x + cB * localCenterB.y)};
+    const SimdVector2 clipPoint = {simdLoad(positionConstraint->pointX[j]), simdLoad(positionConstraint->pointY[j])};
+    const SimdVector2 firstPoint = {simdLoad(positionConstraint->pointX[0]), simdLoad(positionConstraint->pointY[0])};
+
+    /* Circles */
+    const SimdVector2 circlePointA = {(cA * localPoint.x - sA * localPoint.y) + translationA.x, (sA * localPoint.x + cA * localPoint.y) + translationA.y};
+    const SimdVector2 circlePointB = {(cB * firstPoint.x - sB * firstPoint.y) + translationB.x, (sB * firstPoint.x + cB * firstPoint.y) + translationB.y};
+    SimdVector2 circleNormal = circlePointB - circlePointA;
+    const SimdFloat length = simdSqrt(circleNormal.x * circleNormal.x + circleNormal.y * circleNormal.y);
+    const SimdFloat isNormalizable = simdGreaterEqual(length, simdSet(FLOAT_EPSILON));
+    const SimdFloat safeLength = simdSelect(isNormalizable, length, one);
+    circleNormal = simdSelect(isNormalizable, SimdVector2{circleNormal.x / safeLength, circleNormal.y / safeLength}, circleNormal);
+    const SimdVector2 circlePoint = simdSet(0.5f) * (circlePointA + circlePointB);
+    const SimdFloat circleSeparation = dot(circlePointB - circlePointA, circleNormal) - radiusA - radiusB;
+
+    /* Face of the first body */
+    const SimdVector2 faceANormal = {cA * localNormal.x - sA * localNormal.y, sA * localNormal.x + cA * localNormal.y};
+    const SimdVector2 faceAPlanePoint = {(cA * localPoint.x - sA * localPoint.y) + translationA.x, (sA * localPoint.x + cA * localPoint.y) + translationA.y};
+    const SimdVector2 faceAClipPoint = {(cB * clipPoint.x - sB * clipPoint.y) + translationB.x, (sB * clipPoint.x + cB * clipPoint.y) + translationB.y};
+    const SimdFloat faceASeparation = dot(faceAClipPoint - faceAPlanePoint, faceANormal) - radiusA - radiusB;
+
+    /* Face of the second body */
+    const SimdVector2 faceBNormal = {cB * localNormal.x - sB * localNormal.y, sB * localNormal.x + cB * localNormal.y};
+    const SimdVector2 faceBPlanePoint = {(cB * localPoint.x - sB * localPoint.y) + translationB.x, (sB * localPoint.x + cB * localPoint.y) + translationB.y};
+    const SimdVector2 faceBClipPoint = {(cA * clipPoint.x - sA * clipPoint.y) + translationA.x, (sA * clipPoint.x + cA * clipPoint.y) + translationA.y};
+    const SimdFloat faceBSeparation = dot(faceBClipPoint - faceBPlanePoint, faceBNormal) - radiusA - radiusB;
+
+    const SimdVector2 normal = simdSelect(isCircles, circleNormal, simdSelect(isFaceA, faceANormal, SimdVector2{-faceBNormal.x, -faceBNormal.y}));
+    const SimdVector2 point = simdSelect(isCircles, circlePoint, simdSelect(isFaceA, faceAClipPoint, faceBClipPoint));
+    const SimdFloat separation = simdSelect(isCircles, circleSeparation, simdSelect(isFaceA, faceASeparation, faceBSeparation));
+    const SimdVector2 rA = point - positionA;
+    const SimdVector2 rB = point - positionB;
+    minSeparation = simdSelect(isPoint, simdMin(minSeparation, separation), minSeparation);
+
+    const SimdFloat C = simdClamp(simdSet(BAUMGARTE) * (separation + simdSet(LINEAR_SLOP)), simdSet(-MAX_LINEAR_CORRECTION), zero);
+    const SimdFloat rnA = cross(rA, normal);
+    const SimdFloat rnB = cross(rB, normal);
+    const SimdFloat K = inverseMassA + inverseMassB + inverseInertiaA * rnA * rnA + inverseInertiaB * rnB * rnB;
+    const SimdFloat hasImpulse = simdAnd(isPoint, simdGreater(K, zero));
+    const SimdFloat impulse = simdSelect(hasImpulse, -C / simdSelect(hasImpulse, K, one), zero);
+
+    const SimdVector2 P = impulse * normal;
+    positionA = positionA - inverseMassA * P;
+    angleA = angleA - inverseInertiaA * cross(rA, P);
+    positionB = positionB + inverseMassB * P;
+    angleB = angleB + inverseInertiaB * cross(rB, P);
+  }
+
+  storePositions(positionConstraint->indicesA, positionConstraint->inverseMassA, positionConstraint->inverseInertiaA, positionConstraint->numLanes, positionA, angleA);
+  storePositions(positionConstraint->indicesB, positionConstraint->inverseMassB, positionConstraint->inverseInertiaB, positionConstraint->numLanes, positionB, angleB);
+
+  float separations[SIMD_WIDTH];
+  simdStore(separations, minSeparation);
+  float result = 0.0f;
+
+  for(uint32 i = 0; i < positionConstraint->numLanes; i++) {
+    result = std::min(result, separations[i]);
+  }
+
+  return result;
+}
+
+/* Store the impulses of the constraints in the range [begin, end) for warm starting in the next frame */
+void ContactSolver::storeImpulses(uint32 begin, uint32 end) {
+  for(uint32 i = begin; i < end; i++) {
     VelocityConstraint* velocityConstraint = mVelocityConstraints + i;
 
     for(uint32 j = 0; j < velocityConstraint->numPoints; j++) {
@@ -523,4 +1351,18 @@ void ContactSolver::reset() {
     mMemoryStrategy.free(MemoryStrategy::HandlerType::Linear, mVelocityConstraints, sizeof(VelocityConstraint) * mManifolds->size());
     mMemoryStrategy.free(MemoryStrategy::HandlerType::Linear, mPositionConstraints, sizeof(PositionConstraint) * mManifolds->size());
   }
+
+  mIslandBatches.clear(true);
+  mColoredIslands.clear(true);
+  mIslandColors.clear(true);
+  mColorOffsets.clear(true);
+  mColorManifolds.clear(true);
+  mColorWideConstraints.clear(true);
+
+  if(mWideVelocityConstraints) {
+    mMemoryStrategy.free(MemoryStrategy::HandlerType::Linear, mWideVelocityConstraints, sizeof(WideVelocityConstraint) * mNumWideConstraints);
+    mMemoryStrategy.free(MemoryStrategy::HandlerType::Linear, mWidePositionConstraints, sizeof(WidePositionConstraint) * mNumWideConstraints);
+    mWideVelocityConstraints = nullptr;
+    mWidePositionConstraints = nullptr;
+  }
 }
@@ -21,6 +21,18 @@ uint32 Islands::getNumIslands() const {
   return static_cast<uint32>(manifoldIndices.size());
 }
 
+/* Get the maximum number of bodies in a particular island of the current frame */
+uint32 Islands::getMaxNumBodies() const {
+  const uint32 numIslands = static_cast<uint32>(numBodies.size());
+
+  /* The last island is only accounted for once the next one is added */
+  if(numIslands > 0 && numBodies[numIslands - 1] > mMaxNumBodiesCurrentFrame) {
+    return numBodies[numIslands - 1];
+  }
+
+  return mMaxNumBodiesCurrentFrame;
+}
+
 /* Get the island index from the given manifold start index */
 uint32 Islands::getIslandIndex(uint32 manifoldStartIndex) const {
   assert(mManifoldIslandMap.contains(manifoldStartIndex));
@@ -0,0 +1,236 @@
+#include <physics/dynamics/PersistentIslands.h>
+
+using namespace physics;
+
+constexpr uint32 PersistentIslands::INVALID_INDEX;
+
+/* Constructor */
+PersistentIslands::PersistentIslands(MemoryHandler& memoryHandler) :
+                                     mBodyEntities(memoryHandler),
+                                     mParents(memoryHandler),
+                                     mNextBodies(memoryHandler),
+                                     mFirstBodies(memoryHandler),
+                                     mLastBodies(memoryHandler),
+                                     mNumBodies(memoryHandler),
+                                     mAwakeIndices(memoryHandler),
+                                     mIsStatic(memoryHandler),
+                                     mIsSplitPending(memoryHandler),
+                                     mIsLinkPending(memoryHandler),
+                                     mLinkPendingBodies(memoryHandler),
+                                     mAwakeIslands(memoryHandler),
+                                     mSplitCandidate(INVALID_INDEX) {}
+
+/* Reset a body into an island of its own */
+void PersistentIslands::resetBody(uint32 index) {
+  mParents[index] = index;
+  mNextBodies[index] = INVALID_INDEX;
+  mFirstBodies[index] = index;
+  mLastBodies[index] = index;
+  mNumBodies[index] = 1;
+  mAwakeIndices[index] = INVALID_INDEX;
+  mIsSplitPending[index] = false;
+}
+
+/* Append the island of a root body to the awake islands */
+void PersistentIslands::addAwakeIsland(uint32 root) {
+  assert(mParents[root] == root && mAwakeIndices[root] == INVALID_INDEX && !mIsStatic[root]);
+  mAwakeIndices[root] = static_cast<uint32>(mAwakeIslands.size());
+  mAwakeIslands.add(root);
+}
+
+/* Remove the island of a root body from the awake islands */
+void PersistentIslands::removeAwakeIsland(uint32 root) {
+  assert(mParents[root] == root && mAwakeIndices[root] != INVALID_INDEX);
+  const uint32 awakeIndex = mAwakeIndices[root];
+  const uint32 lastRoot = mAwakeIslands[mAwakeIslands.size() - 1];
+
+  /* The last awake island takes the place of the removed one */
+  mAwakeIslands[awakeIndex] = lastRoot;
+  mAwakeIndices[lastRoot] = awakeIndex;
+  mAwakeIslands.erase(mAwakeIslands.size() - 1);
+  mAwakeIndices[root] = INVALID_INDEX;
+}
+
+/* Add a body into an awake island of its own */
+void PersistentIslands::addBody(Entity bodyEntity) {
+  const uint32 index = bodyEntity.getIndex();
+
+  /* Entity indices are shared with colliders so the arrays may have to grow past indices which never hold a body */
+  while(mParents.size() <= index) {
+    mBodyEntities.add(bodyEntity);
+    mParents.add(INVALID_INDEX);
+    mNextBodies.add(INVALID_INDEX);
+    mFirstBodies.add(INVALID_INDEX);
+    mLastBodies.add(INVALID_INDEX);
+    mNumBodies.add(0);
+    mAwakeIndices.add(INVALID_INDEX);
+    mIsStatic.add(false);
+    mIsSplitPending.add(false);
+    mIsLinkPending.add(false);
+  }
+
+  assert(mParents[index] == INVALID_INDEX);
+  mBodyEntities[index] = bodyEntity;
+  mIsStatic[index] = false;
+  resetBody(index);
+  addAwakeIsland(index);
+  /* A body created in place of a destroyed one must not inherit its pending links */
+  mIsLinkPending[index] = false;
+}
+
+/* Remove a body by dissolving its island */
+void PersistentIslands::removeBody(Entity bodyEntity) {
+  assert(containsBody(bodyEntity));
+  const uint32 index = bodyEntity.getIndex();
+  dissolve(index);
+
+  if(mAwakeIndices[index] != INVALID_INDEX) {
+    removeAwakeIsland(index);
+  }
+
+  mParents[index] = INVALID_INDEX;
+  mIsLinkPending[index] = false;
+}
+
+/* Set whether a body is static, which dissolves its island */
+void PersistentIslands::setIsStatic(uint32 index, bool isStatic) {
+  dissolve(index);
+  mIsStatic[index] = isStatic;
+
+  /* A static body is never simulated while a body which stops being static is woken up by its type change */
+  if(isStatic && mAwakeIndices[index] != INVALID_INDEX) {
+    removeAwakeIsland(index);
+  }
+  else if(!isStatic && mAwakeIndices[index] == INVALID_INDEX) {
+    addAwakeIsland(index);
+  }
+}
+
+/* Get the root body of the island of a body */
+uint32 PersistentIslands::findRoot(uint32 index) {
+  assert(index < mParents.size() && mParents[index] != INVALID_INDEX);
+
+  /* Path halving keeps the trees flat without a second pass */
+  while(mParents[index] != index) {
+    mParents[index] = mParents[mParents[index]];
+    index = mParents[index];
+  }
+
+  return index;
+}
+
+/* Merge the islands of two bodies */
+void PersistentIslands::merge(uint32 firstIndex, uint32 secondIndex) {
+  assert(!mIsStatic[firstIndex] && !mIsStatic[secondIndex]);
+  uint32 firstRoot = findRoot(firstIndex);
+  uint32 secondRoot = findRoot(secondIndex);
+
+  if(firstRoot == secondRoot) {
+    return;
+  }
+
+  /* The smaller island joins the larger one */
+  if(mNumBodies[firstRoot] < mNumBodies[secondRoot]) {
+    const uint32 root = firstRoot;
+    firstRoot = secondRoot;
+    secondRoot = root;
+  }
+
+  /* The merged island is awake if either island was */
+  if(mAwakeIndices[secondRoot] != INVALID_INDEX) {
+    if(mAwakeIndices[firstRoot] == INVALID_INDEX) {
+      const uint32 awakeIndex = mAwakeIndices[secondRoot];
+      mAwakeIslands[awakeIndex] = firstRoot;
+      mAwakeIndices[firstRoot] = awakeIndex;
+      mAwakeIndices[secondRoot] = INVALID_INDEX;
+    }
+    else {
+      removeAwakeIsland(secondRoot);
+    }
+  }
+
+  mParents[secondRoot] = firstRoot;
+  /* Append the bodies of the smaller island to those of the larger one */
+  mNextBodies[mLastBodies[firstRoot]] = mFirstBodies[secondRoot];
+  mLastBodies[firstRoot] = mLastBodies[secondRoot];
+  mNumBodies[firstRoot] += mNumBodies[secondRoot];
+  mIsSplitPending[firstRoot] = mIsSplitPending[firstRoot] || mIsSplitPending[secondRoot];
+}
+
+/* Dissolve the island of a body into islands of their own whose contacts have to be linked again */
+void PersistentIslands::dissolve(uint32 index) {
+  const uint32 root = findRoot(index);
+  const bool isAwake = mAwakeIndices[root] != INVALID_INDEX;
+  uint32 body = mFirstBodies[root];
+
+  if(isAwake) {
+    removeAwakeIsland(root);
+  }
+
+  while(body != INVALID_INDEX) {
+    const uint32 nextBody = mNextBodies[body];
+    resetBody(body);
+
+    /* Bodies of an awake island stay awake on their own until they are linked again */
+    if(isAwake) {
+      addAwakeIsland(body);
+    }
+
+    if(!mIsLinkPending[body]) {
+      mIsLinkPending[body] = true;
+      mLinkPendingBodies.add(body);
+    }
+
+    body = nextBody;
+  }
+}
+
+/* Mark the island of a body as having lost a contact */
+void PersistentIslands::markSplit(uint32 index) {
+  mIsSplitPending[findRoot(index)] = true;
+}
+
+/* Consider the island of a root body for the next split */
+void PersistentIslands::considerSplit(uint32 root) {
+  assert(mParents[root] == root);
+
+  /* Splitting the largest island first frees the most bodies to go to sleep */
+  if(mIsSplitPending[root] && (mSplitCandidate == INVALID_INDEX || mNumBodies[root] > mNumBodies[mSplitCandidate])) {
+    mSplitCandidate = root;
+  }
+}
+
+/* Split the island chosen during the last frame */
+void PersistentIslands::split() {
+  /* At most one island is split per frame and the candidate may have been dissolved, merged or put to sleep since it was chosen */
+  /* A sleeping island has no contacts to link its bodies again so it stays whole until it wakes up */
+  if(mSplitCandidate != INVALID_INDEX && mParents[mSplitCandidate] == mSplitCandidate && mIsSplitPending[mSplitCandidate] &&
+     mAwakeIndices[mSplitCandidate] != INVALID_INDEX) {
+    dissolve(mSplitCandidate);
+  }
+
+  mSplitCandidate = INVALID_INDEX;
+}
+
+/* Clear the bodies whose contacts have to be linked again */
+void PersistentIslands::clearLinkPending() {
+  const uint32 numLinkPendingBodies = static_cast<uint32>(mLinkPendingBodies.size());
+
+  for(uint32 i = 0; i < numLinkPendingBodies; i++) {
+    mIsLinkPending[mLinkPendingBodies[i]] = false;
+  }
+
+  mLinkPendingBodies.clear();
+}
+
+/* Set whether the island of a root body is awake */
+void PersistentIslands::setIsAwake(uint32 root, bool isAwake) {
+  assert(mParents[root] == root);
+
+  if(isAwake && mAwakeIndices[root] == INVALID_INDEX && !mIsStatic[root]) {
+    addAwakeIsland(root);
+  }
+  else if(!isAwake && mAwakeIndices[root] != INVALID_INDEX) {
+    removeAwakeIsland(root);
+  }
+}
@@ -8,7 +8,7 @@ using namespace physics;
 size_t FreeListMemoryHandler::INIT_SIZE = 5242880;
 
 /* Constructor */
-FreeListMemoryHandler::FreeListMemoryHandler(MemoryHandler& primaryMemoryHandler, size_t initSize) : mPrimaryMemoryHandler(primaryMemoryHandler), mAllocated(0), mHead(nullptr), mFree(nullptr) {
+FreeListMemoryHandler::FreeListMemoryHandler(MemoryHandler& primaryMemoryHandler, size_t initSize) : mPrimaryMemoryHandler(primaryMemoryHandler), mAllocated(0), mHead(nullptr), mFree(nullptr), mNumUsedBytes(0), mNumPeakUsedBytes(0), mNumAllocations(0), mNumFrees(0) {
   apportion(initSize == 0 ? INIT_SIZE : initSize);
 }
 
@@ -23,7 +23,7 @@ FreeListMemoryHandler::~FreeListMemoryHandler() {
 
     /* Release the memory allocated for each memory block */
     block->~AllocationHeader();
-    mPrimaryMemoryHandler.free(static_cast<void*>(block), size + sizeof(AllocationHeader));
+    mPrimaryMemoryHandler.free(static_cast<void*>(block), size + HEADER_SIZE);
     block = next;
   }
 }
@@ -38,6 +38,8 @@ void* FreeListMemoryHandler::allocate(size_t size) {
     return nullptr;
   }
 
+  /* Blocks of aligned sizes keep every following block aligned */
+  size = alignSize(size);
   AllocationHeader* block = mHead;
   assert(!mHead->prev);
 
@@ -75,6 +77,12 @@ void* FreeListMemoryHandler::allocate(size_t size) {
   }
 
   block->isAllocated = true;
+  mNumUsedBytes += block->size;
+  mNumAllocations++;
+
+  if(mNumUsedBytes > mNumPeakUsedBytes) {
+    mNumPeakUsedBytes = mNumUsedBytes;
+  }
 
   /* Debug */
   if(block->next && !block->next->isAllocated) {
@@ -82,7 +90,7 @@ void* FreeListMemoryHandler::allocate(size_t size) {
   }
 
   /* Void pointer to the memory space of the block after the allocation header */
-  return static_cast<void*>(reinterpret_cast<unsigned char*>(block) + sizeof(AllocationHeader));
+  return static_cast<void*>(reinterpret_cast<unsigned char*>(block) + HEADER_SIZE);
 }
 
 /* Free dynamically allocated memory */
@@ -95,10 +103,12 @@ void FreeListMemoryHandler::free(void* ptr, size_t size) {
     return;
   }
 
-  unsigned char* blockAddress = static_cast<unsigned char*>(ptr) - sizeof(AllocationHeader);
+  unsigned char* blockAddress = static_cast<unsigned char*>(ptr) - HEADER_SIZE;
   AllocationHeader* block = reinterpret_cast<AllocationHeader*>(blockAddress);
   assert(block->isAllocated);
   block->isAllocated = false;
+  mNumUsedBytes -= block->size;
+  mNumFrees++;
 
   AllocationHeader* tempBlock = block;
 
@@ -121,10 +131,10 @@ void FreeListMemoryHandler::split(AllocationHeader* block, size_t size) {
   assert(size <= block->size);
   assert(!block->isAllocated);
 
-  if(size + sizeof(AllocationHeader) < block->size) {
+  if(size + HEADER_SIZE < block->size) {
     /* New memory block for the leftover space */
-    unsigned char* nextBlockAddress = (reinterpret_cast<unsigned char*>(block)) + sizeof(AllocationHeader) + size;
-    AllocationHeader* newBlock = new (static_cast<void*>(nextBlockAddress)) AllocationHeader(block->size - sizeof(AllocationHeader) - size, block, block->next, block->isNextCoalescent);
+    unsigned char* nextBlockAddress = (reinterpret_cast<unsigned char*>(block)) + HEADER_SIZE + size;
+    AllocationHeader* newBlock = new (static_cast<void*>(nextBlockAddress)) AllocationHeader(block->size - HEADER_SIZE - size, block, block->next, block->isNextCoalescent);
     assert(newBlock->next != newBlock);
     block->next = newBlock;
 
@@ -150,7 +160,7 @@ void FreeListMemoryHandler::coalesce(AllocationHeader* block1, AllocationHeader*
   assert(!block2->isAllocated);
   assert(block1->isNextCoalescent);
 
-  block1->size += sizeof(AllocationHeader) + block2->size;
+  block1->size += HEADER_SIZE + block2->size;
   block1->next = block2->next;
   assert(block1->next != block1);
 
@@ -166,8 +176,10 @@ void FreeListMemoryHandler::coalesce(AllocationHeader* block1, AllocationHeader*
 
 /* Apportion additional memory */
 void FreeListMemoryHandler::apportion(size_t size) {
+  size = alignSize(size);
+
   /* Call on primary memory handler to allocate new memory */
-  void* raw = mPrimaryMemoryHandler.allocate(size + sizeof(AllocationHeader));
+  void* raw = mPrimaryMemoryHandler.allocate(size + HEADER_SIZE);
   assert(raw);
 
   /* New header for our allocated memory */
@@ -181,4 +193,30 @@ void FreeListMemoryHandler::apportion(size_t size) {
   mHead = block;
   mFree = mHead;
   mAllocated += size;
-}
\ No newline at end of file
+}
+/* Get the live statistics of the handler */
+MemoryStatistics FreeListMemoryHandler::getStatistics() {
+  std::lock_guard<std::mutex> lock(mMutex);
+  MemoryStatistics statistics;
+  statistics.numUsedBytes = mNumUsedBytes;
+  statistics.numReservedBytes = mAllocated;
+  statistics.numPeakUsedBytes = mNumPeakUsedBytes;
+  statistics.numAllocations = mNumAllocations;
+  statistics.numFrees = mNumFrees;
+  size_t numFreeBytes = 0;
+  size_t numLargestFreeBytes = 0;
+
+  /* Fragmentation requires the largest free block which is only known by walking the list */
+  for(AllocationHeader* block = mHead; block; block = block->next) {
+    if(!block->isAllocated) {
+      numFreeBytes += block->size;
+
+      if(block->size > numLargestFreeBytes) {
+        numLargestFreeBytes = block->size;
+      }
+    }
+  }
+
+  statistics.fragmentation = numFreeBytes ? 1.0f - static_cast<float>(numLargestFreeBytes) / static_cast<float>(numFreeBytes) : 0.0f;
+  return statistics;
+}
@@ -6,56 +6,107 @@
 using namespace physics;
 
 /* Constructor */
-LinearMemoryHandler::LinearMemoryHandler(MemoryHandler& primaryMemoryHandler) : mPrimaryMemoryHandler(primaryMemoryHandler), mOffset(0), mSize(INIT_SIZE), mNumValidShrinkFrames(0), mGrow(false) {
-  /* Allocate INIT_SIZE memory */
+LinearMemoryHandler::LinearMemoryHandler(MemoryHandler& primaryMemoryHandler) : LinearMemoryHandler(primaryMemoryHandler, INIT_SIZE) {}
+
+/* Constructor */
+LinearMemoryHandler::LinearMemoryHandler(MemoryHandler& primaryMemoryHandler, size_t initSize) : mPrimaryMemoryHandler(primaryMemoryHandler), mOffset(0), mSize(initSize), mNumValidShrinkFrames(0), mLastBlock(nullptr), mBlockOffset(0), mNumBlockBytes(0), mNumPeakUsedBytes(0), mNumAllocations(0), mNumFrees(0) {
+  /* Allocate the initial memory space */
   mStart = static_cast<char*>(mPrimaryMemoryHandler.allocate(mSize));
   assert(mStart);
 }
 
 /* Destructor */
 LinearMemoryHandler::~LinearMemoryHandler() {
+  freeBlocks();
   /* Free mSize memory beginning at mStart */
   mPrimaryMemoryHandler.free(mStart, mSize);
 }
 
+/* Chain a new block which is able to hold an allocation of size in bytes */
+void LinearMemoryHandler::addBlock(size_t size) {
+  /* Blocks grow geometrically so that a frame which overflows by far only chains a few of them */
+  size_t blockSize = 2 * (mLastBlock ? mLastBlock->size : mSize);
+
+  if(blockSize < size) {
+    blockSize = size;
+  }
+
+  Block* block = static_cast<Block*>(mPrimaryMemoryHandler.allocate(BLOCK_HEADER_SIZE + blockSize));
+  assert(block);
+  block->previous = mLastBlock;
+  block->size = blockSize;
+  mLastBlock = block;
+  mBlockOffset = 0;
+}
+
+/* Release the chained blocks */
+void LinearMemoryHandler::freeBlocks() {
+  while(mLastBlock) {
+    Block* previous = mLastBlock->previous;
+    mPrimaryMemoryHandler.free(mLastBlock, BLOCK_HEADER_SIZE + mLastBlock->size);
+    mLastBlock = previous;
+  }
+
+  mBlockOffset = 0;
+  mNumBlockBytes = 0;
+}
+
 /* Dynamically allocate memory of size in bytes and return a pointer to the heap allocated block */
 void* LinearMemoryHandler::allocate(size_t size) {
-  std::lock_guard<std::mutex> lock(mMutex);
+  /* Bumping by aligned sizes keeps every allocation aligned */
+  size = alignSize(size);
+  mNumAllocations++;
 
-  if(mOffset + size > mSize) {
-    /* Vanilla allocation */
-    mGrow = true;
-    return mPrimaryMemoryHandler.allocate(size);
+  if(mOffset + mNumBlockBytes + size > mNumPeakUsedBytes) {
+    mNumPeakUsedBytes = mOffset + mNumBlockBytes + size;
   }
 
-  /* Next available memory location */
-  void* raw = mStart + mOffset;
+  if(!mLastBlock) {
+    if(mOffset + size <= mSize) {
+      /* Next available memory location */
+      void* raw = mStart + mOffset;
+
+      /* Increase offset for new allocation */
+      mOffset += size;
 
-  /* Increase offset for new allocation */
-  mOffset += size;
+      /* Return requested memory block for user at mStart + mOffset of size bytes */
+      return raw;
+    }
 
-  /* Return requested memory block for user at mStart + mOffset of size bytes */
+    addBlock(size);
+  }
+  else if(mBlockOffset + size > mLastBlock->size) {
+    addBlock(size);
+  }
+
+  /* Bump allocate from the last block which follows its header */
+  void* raw = reinterpret_cast<char*>(mLastBlock) + BLOCK_HEADER_SIZE + mBlockOffset;
+  mBlockOffset += size;
+  mNumBlockBytes += size;
   return raw;
 }
 
 /* Free dynamically allocated memory */
 void LinearMemoryHandler::free(void* ptr, size_t size) {
-  std::lock_guard<std::mutex> lock(mMutex);
-
-  char* char_ptr = static_cast<char*>(ptr);
-
-  if(char_ptr < mStart ||
-     char_ptr > mStart + mSize) {
-      /* This memory would have been allocated if the memory space initially allocated was filled */
-      mPrimaryMemoryHandler.free(char_ptr, size);
-  }
+  /* Memory is released all at once by a reset */
+  NOT_USED(ptr);
+  NOT_USED(size);
+  mNumFrees++;
 }
 
 /* Reset pointer to mStart */
 void LinearMemoryHandler::reset() {
-  std::lock_guard<std::mutex> lock(mMutex);
-
-  if(mOffset < mSize / 2) {
+  if(mLastBlock) {
+    /* Merge the memory space and the chained blocks into a single memory space large enough for the whole frame */
+    const size_t size = mOffset + mNumBlockBytes;
+    freeBlocks();
+    mPrimaryMemoryHandler.free(mStart, mSize);
+    mSize = size;
+    mStart = static_cast<char*>(mPrimaryMemoryHandler.allocate(mSize));
+    assert(mStart);
+    mNumValidShrinkFrames = 0;
+  }
+  else if(mOffset < mSize / 2) {
     mNumValidShrinkFrames++;
 
     if(mNumValidShrinkFrames > NUM_FRAMES_BEFORE_SHRINK) {
@@ -79,16 +130,22 @@ void LinearMemoryHandler::reset() {
     mNumValidShrinkFrames = 0;
   }
 
-  if(mGrow) {
-    /* Free the current memory space, multiply the total size by 2 and reallocate */
-    mPrimaryMemoryHandler.free(mStart, mSize);
-    mSize *= 2;
-    mStart = static_cast<char*>(mPrimaryMemoryHandler.allocate(mSize));
-    assert(mStart);
-    mGrow = false;
-    mNumValidShrinkFrames = 0;
-  }
-
   /* Reset the offset so that it points to the beginning of the memory space */
   mOffset = 0;
-}
\ No newline at end of file
+}
+
+/* Get the live statistics of the handler, only while no other thread allocates from it */
+MemoryStatistics LinearMemoryHandler::getStatistics() {
+  MemoryStatistics statistics;
+  statistics.numUsedBytes = mOffset + mNumBlockBytes;
+  statistics.numReservedBytes = mSize;
+
+  for(Block* block = mLastBlock; block; block = block->previous) {
+    statistics.numReservedBytes += BLOCK_HEADER_SIZE + block->size;
+  }
+
+  statistics.numPeakUsedBytes = mNumPeakUsedBytes;
+  statistics.numAllocations = mNumAllocations;
+  statistics.numFrees = mNumFrees;
+  return statistics;
+}
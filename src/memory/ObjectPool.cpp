@@ -2,6 +2,8 @@
 #include <cassert>
 #include <physics/memory/ObjectPool.h>
 #include <physics/memory/MemoryHandler.h>
+#include <algorithm>
+#include <cstdint>
 
 using namespace physics;
 
@@ -9,20 +11,58 @@ using namespace physics;
 bool ObjectPoolMemoryHandler::init = false;
 uint ObjectPoolMemoryHandler::mChunkSizes[NUM_POOL_GROUPS];
 uint ObjectPoolMemoryHandler::mChunkSizePoolMap[MAX_CHUNK_SIZE + 1];
+uint ObjectPoolMemoryHandler::mBatchSizes[NUM_POOL_GROUPS];
+thread_local ObjectPoolMemoryHandler::ThreadCaches ObjectPoolMemoryHandler::mCallingThreadCaches;
+std::mutex ObjectPoolMemoryHandler::mThreadCacheMutex;
 
 /* Constructor */
-ObjectPoolMemoryHandler::ObjectPoolMemoryHandler(MemoryHandler& primaryMemoryHandler) : mPrimaryMemoryHandler(primaryMemoryHandler) {
+ObjectPoolMemoryHandler::ThreadCaches::ThreadCaches() {
+  for(uint i = 0; i < MAX_THREAD_CACHES; i++) {
+    caches[i].handler.store(nullptr, std::memory_order_relaxed);
+    caches[i].nextCache = nullptr;
+    caches[i].previousCache = nullptr;
+  }
+}
+
+/* Destructor */
+ObjectPoolMemoryHandler::ThreadCaches::~ThreadCaches() {
+  std::lock_guard<std::mutex> lock(mThreadCacheMutex);
+
+  /* Chunks cached by an exiting thread are handed back to the object pools which are still alive */
+  for(uint i = 0; i < MAX_THREAD_CACHES; i++) {
+    ObjectPoolMemoryHandler* handler = caches[i].handler.load(std::memory_order_relaxed);
+
+    if(handler) {
+      std::lock_guard<std::mutex> handlerLock(handler->mMutex);
+
+      for(uint j = 0; j < NUM_POOL_GROUPS; j++) {
+        handler->drain(caches[i], j, 0);
+      }
+
+      handler->detach(caches[i]);
+    }
+  }
+}
+
+/* Constructor */
+ObjectPoolMemoryHandler::ObjectPoolMemoryHandler(MemoryHandler& primaryMemoryHandler) : mPrimaryMemoryHandler(primaryMemoryHandler), mFirstThreadCache(nullptr), mNumFreeBytes(0), mTrimThreshold(0), mNextTrimBytes(0), mNumChunkBytes(0), mNumPeakUsedBytes(0), mNumLargeBytes(0), mNumAllocations(0), mNumFrees(0) {
   mNumAllocatedPools = 64;
   mNumUsedPools = 0;
   const size_t size = mNumAllocatedPools * sizeof(Pool);
   mPools = static_cast<Pool*>(primaryMemoryHandler.allocate(size));
   memset(mPools, 0, size);
   memset(mHeads, 0, sizeof(mHeads));
+  memset(mNumGroupChunks, 0, sizeof(mNumGroupChunks));
+  memset(mNumSharedChunks, 0, sizeof(mNumSharedChunks));
 
   if(!init) {
     /* Chunk sizes contains the range of all valid chunk sizes associated with the different pool groups */
     for(uint i = 0; i < NUM_POOL_GROUPS; i++) {
       mChunkSizes[i] = (i + 1) * 8;
+
+      /* Batches of an eighth of a pool, so that small chunks are not fetched one at a time and large ones are not hoarded */
+      const uint batchSize = static_cast<uint>(POOL_SIZE / 8) / mChunkSizes[i];
+      mBatchSizes[i] = batchSize < 1 ? 1 : (batchSize > 32 ? 32 : batchSize);
     }
 
     /* Associate allocation sizes with pool groups */
@@ -47,6 +87,15 @@ ObjectPoolMemoryHandler::ObjectPoolMemoryHandler(MemoryHandler& primaryMemoryHan
 
 /* Destructor */
 ObjectPoolMemoryHandler::~ObjectPoolMemoryHandler() {
+  {
+    std::lock_guard<std::mutex> lock(mThreadCacheMutex);
+
+    /* Chunks still cached by other threads belong to the pools released below so the caches are simply detached */
+    while(mFirstThreadCache) {
+      detach(*mFirstThreadCache);
+    }
+  }
+
   /* Free the memory for all chunks in each of the pools */
   for(uint i = 0; i < mNumUsedPools; i++) {
     mPrimaryMemoryHandler.free(mPools[i].chunks, POOL_SIZE);
@@ -55,9 +104,164 @@ ObjectPoolMemoryHandler::~ObjectPoolMemoryHandler() {
   mPrimaryMemoryHandler.free(mPools, mNumAllocatedPools * sizeof(Pool));
 }
 
+/* Allocate a new pool and add its chunks to the shared pool group */
+void ObjectPoolMemoryHandler::allocatePool(uint poolGroupIndex) {
+  /* More memory needs to be allocated for additional pools */
+  if(mNumUsedPools == mNumAllocatedPools) {
+    Pool* pools = mPools;
+    mNumAllocatedPools += 64;
+    mPools = static_cast<Pool*>(mPrimaryMemoryHandler.allocate(mNumAllocatedPools * sizeof(Pool)));
+    memcpy(mPools, pools, mNumUsedPools * sizeof(Pool));
+    memset(mPools + mNumUsedPools, 0, 64 * sizeof(Pool));
+    mPrimaryMemoryHandler.free(pools, mNumUsedPools * sizeof(Pool));
+  }
+
+  /* Allocate a new pool */
+  Pool* pool = mPools + mNumUsedPools;
+  pool->chunks = static_cast<Chunk*>(mPrimaryMemoryHandler.allocate(POOL_SIZE));
+  pool->poolGroupIndex = poolGroupIndex;
+  pool->numFreeChunks = 0;
+  assert(pool->chunks);
+  uint chunkSize = mChunkSizes[poolGroupIndex];
+  assert(chunkSize <= MAX_CHUNK_SIZE);
+  uint numChunks = (POOL_SIZE) / chunkSize;
+  void* rawChunkHead = static_cast<void*>(pool->chunks);
+  char* charChunkHead = static_cast<char*>(rawChunkHead);
+
+  /* Divide the pool into individual chunks and link them */
+  for(uint i = 0; i < numChunks; i++) {
+    void* rawChunk;
+    void* nextRawChunk;
+    Chunk* chunk;
+    Chunk* nextChunk;
+
+    /* Special case for the last chunk in the pool where we link the remaining free chunks of the pool group */
+    if(i == numChunks - 1) {
+      rawChunk = static_cast<void*>(charChunkHead + chunkSize * i);
+      chunk = static_cast<Chunk*>(rawChunk);
+      chunk->nextChunk = mHeads[poolGroupIndex];
+      continue;
+    }
+  
+    /* For all other chunks, we assign a valid chunk as the next chunk in the sequence */
+    rawChunk = static_cast<void*>(charChunkHead + chunkSize * i);
+    nextRawChunk = static_cast<void*>(charChunkHead + chunkSize * (i + 1));
+    chunk = static_cast<Chunk*>(rawChunk);
+    nextChunk = static_cast<Chunk*>(nextRawChunk);
+    chunk->nextChunk = nextChunk;
+  }
+
+  /* Update the head for the current pool group */
+  mHeads[poolGroupIndex] = pool->chunks;
+  mNumUsedPools++;
+  mNumFreeBytes += numChunks * chunkSize;
+  mNumChunkBytes += numChunks * chunkSize;
+  mNumGroupChunks[poolGroupIndex] += numChunks;
+  mNumSharedChunks[poolGroupIndex] += numChunks;
+}
+
+/* Get the cache of the calling thread for this object pool, null if the thread holds too many caches already */
+ObjectPoolMemoryHandler::ThreadCache* ObjectPoolMemoryHandler::getThreadCache() {
+  ThreadCache* caches = mCallingThreadCaches.caches;
+
+  for(uint i = 0; i < MAX_THREAD_CACHES; i++) {
+    if(caches[i].handler.load(std::memory_order_acquire) == this) {
+      return caches + i;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mThreadCacheMutex);
+
+  /* Attach an unused cache of the calling thread */
+  for(uint i = 0; i < MAX_THREAD_CACHES; i++) {
+    if(!caches[i].handler.load(std::memory_order_relaxed)) {
+      ThreadCache& cache = caches[i];
+      memset(cache.heads, 0, sizeof(cache.heads));
+
+      for(uint j = 0; j < NUM_POOL_GROUPS; j++) {
+        cache.numChunks[j].store(0, std::memory_order_relaxed);
+      }
+
+      cache.numAllocations.store(0, std::memory_order_relaxed);
+      cache.numFrees.store(0, std::memory_order_relaxed);
+      cache.previousCache = nullptr;
+      cache.nextCache = mFirstThreadCache;
+
+      if(mFirstThreadCache) {
+        mFirstThreadCache->previousCache = &cache;
+      }
+
+      mFirstThreadCache = &cache;
+      cache.handler.store(this, std::memory_order_release);
+      return &cache;
+    }
+  }
+
+  return nullptr;
+}
+
+/* Move a batch of chunks from the shared pool group into a thread cache */
+void ObjectPoolMemoryHandler::refill(ThreadCache& cache, uint poolGroupIndex) {
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  for(uint i = 0; i < mBatchSizes[poolGroupIndex]; i++) {
+    if(!mHeads[poolGroupIndex]) {
+      allocatePool(poolGroupIndex);
+    }
+
+    Chunk* chunk = mHeads[poolGroupIndex];
+    mHeads[poolGroupIndex] = chunk->nextChunk;
+    mNumFreeBytes -= mChunkSizes[poolGroupIndex];
+    mNumSharedChunks[poolGroupIndex]--;
+    chunk->nextChunk = cache.heads[poolGroupIndex];
+    cache.heads[poolGroupIndex] = chunk;
+    cache.numChunks[poolGroupIndex].store(cache.numChunks[poolGroupIndex].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  updatePeakUsedBytes();
+}
+
+/* Move chunks from a thread cache back into the shared pool group until the cache holds at most a number of chunks */
+void ObjectPoolMemoryHandler::drain(ThreadCache& cache, uint poolGroupIndex, uint numChunks) {
+  uint numCachedChunks = cache.numChunks[poolGroupIndex].load(std::memory_order_relaxed);
+
+  while(numCachedChunks > numChunks) {
+    Chunk* chunk = cache.heads[poolGroupIndex];
+    cache.heads[poolGroupIndex] = chunk->nextChunk;
+    numCachedChunks--;
+    chunk->nextChunk = mHeads[poolGroupIndex];
+    mHeads[poolGroupIndex] = chunk;
+    mNumFreeBytes += mChunkSizes[poolGroupIndex];
+    mNumSharedChunks[poolGroupIndex]++;
+  }
+
+  cache.numChunks[poolGroupIndex].store(numCachedChunks, std::memory_order_relaxed);
+}
+
+/* Detach a thread cache after returning all of its chunks */
+void ObjectPoolMemoryHandler::detach(ThreadCache& cache) {
+  if(cache.previousCache) {
+    cache.previousCache->nextCache = cache.nextCache;
+  }
+  else {
+    assert(mFirstThreadCache == &cache);
+    mFirstThreadCache = cache.nextCache;
+  }
+
+  if(cache.nextCache) {
+    cache.nextCache->previousCache = cache.previousCache;
+  }
+
+  /* Counts of the cache outlive it */
+  mNumAllocations.fetch_add(cache.numAllocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  mNumFrees.fetch_add(cache.numFrees.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  cache.nextCache = nullptr;
+  cache.previousCache = nullptr;
+  cache.handler.store(nullptr, std::memory_order_release);
+}
+
 /* Dynamically allocate memory of size in bytes and return a pointer to the heap allocated block */
 void* ObjectPoolMemoryHandler::allocate(size_t size) {
-  std::lock_guard<std::mutex> lock(mMutex);
   assert(size > 0);
 
   /* Not possible to allocate zero memory */
@@ -67,6 +271,9 @@ void* ObjectPoolMemoryHandler::allocate(size_t size) {
 
   /* Special case where the size to be allocated is more than the maximum size of a chunk */
   if(size > MAX_CHUNK_SIZE) {
+    mNumLargeBytes.fetch_add(size, std::memory_order_relaxed);
+    mNumAllocations.fetch_add(1, std::memory_order_relaxed);
+
     /* Base allocation */
     return mPrimaryMemoryHandler.allocate(size);
   }
@@ -74,69 +281,40 @@ void* ObjectPoolMemoryHandler::allocate(size_t size) {
   /* Find the pool group associated with the requested chunk size */
   int poolGroupIndex = mChunkSizePoolMap[size];
   assert(poolGroupIndex >= 0 && poolGroupIndex < NUM_POOL_GROUPS);
+  ThreadCache* cache = getThreadCache();
+
+  /* Calling thread caches chunks for too many object pools already */
+  if(!cache) {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if(!mHeads[poolGroupIndex]) {
+      allocatePool(poolGroupIndex);
+    }
 
-  /* A free chunk exists in the object pool */
-  if(mHeads[poolGroupIndex]) {
-    /* Return the next free chunk for the given pool group */
     Chunk* chunk = mHeads[poolGroupIndex];
     mHeads[poolGroupIndex] = chunk->nextChunk;
+    mNumFreeBytes -= mChunkSizes[poolGroupIndex];
+    mNumSharedChunks[poolGroupIndex]--;
+    mNumAllocations.fetch_add(1, std::memory_order_relaxed);
+    updatePeakUsedBytes();
     return chunk;
   }
-  else {
-    /* More memory needs to be allocated for additional pools */
-    if(mNumUsedPools == mNumAllocatedPools) {
-      Pool* pools = mPools;
-      mNumAllocatedPools += 64;
-      mPools = static_cast<Pool*>(mPrimaryMemoryHandler.allocate(mNumAllocatedPools * sizeof(Pool)));
-      memcpy(mPools, pools, mNumUsedPools * sizeof(Pool));
-      memset(mPools + mNumUsedPools, 0, 64 * sizeof(Pool));
-      mPrimaryMemoryHandler.free(pools, mNumUsedPools * sizeof(Pool));
-    }
-
-    /* Allocate a new pool */
-    Pool* pool = mPools + mNumUsedPools;
-    pool->chunks = static_cast<Chunk*>(mPrimaryMemoryHandler.allocate(POOL_SIZE));
-    assert(pool->chunks);
-    uint chunkSize = mChunkSizes[poolGroupIndex];
-    assert(chunkSize <= MAX_CHUNK_SIZE);
-    uint numChunks = (POOL_SIZE) / chunkSize;
-    void* rawChunkHead = static_cast<void*>(pool->chunks);
-    char* charChunkHead = static_cast<char*>(rawChunkHead);
-
-    /* Divide the pool into individual chunks and link them */
-    for(uint i = 0; i < numChunks; i++) {
-      void* rawChunk;
-      void* nextRawChunk;
-      Chunk* chunk;
-      Chunk* nextChunk;
-
-      /* Special case for the last chunk in the pool where we assign a null pointer as the next chunk */
-      if(i == numChunks - 1) {
-        rawChunk = static_cast<void*>(charChunkHead + chunkSize * i);
-        chunk = static_cast<Chunk*>(rawChunk);
-        chunk->nextChunk = nullptr;
-        continue;
-      }
-    
-      /* For all other chunks, we assign a valid chunk as the next chunk in the sequence */
-      rawChunk = static_cast<void*>(charChunkHead + chunkSize * i);
-      nextRawChunk = static_cast<void*>(charChunkHead + chunkSize * (i + 1));
-      chunk = static_cast<Chunk*>(rawChunk);
-      nextChunk = static_cast<Chunk*>(nextRawChunk);
-      chunk->nextChunk = nextChunk;
-    }
 
-    /* Update the head for the current pool group */
-    mHeads[poolGroupIndex] = pool->chunks->nextChunk;
-    mNumUsedPools++;
-
-    return pool->chunks;
+  /* Only the shared pool group is locked and only once per batch of chunks */
+  if(!cache->heads[poolGroupIndex]) {
+    refill(*cache, poolGroupIndex);
   }
+
+  /* Return the next free chunk cached for the given pool group */
+  Chunk* chunk = cache->heads[poolGroupIndex];
+  cache->heads[poolGroupIndex] = chunk->nextChunk;
+  cache->numChunks[poolGroupIndex].store(cache->numChunks[poolGroupIndex].load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+  cache->numAllocations.store(cache->numAllocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  return chunk;
 }
 
 /* Free dynamically allocated memory */
 void ObjectPoolMemoryHandler::free(void* ptr, size_t size) {
-  std::lock_guard<std::mutex> lock(mMutex);
   assert(size > 0);
 
   /* Not possible to free zero memory */
@@ -146,6 +324,9 @@ void ObjectPoolMemoryHandler::free(void* ptr, size_t size) {
 
   /* Special case where the size to be freed is more than the maximum size of a chunk */
   if(size > MAX_CHUNK_SIZE) {
+    mNumLargeBytes.fetch_sub(size, std::memory_order_relaxed);
+    mNumFrees.fetch_add(1, std::memory_order_relaxed);
+
     /* Free memory created using vanilla allocation */
     mPrimaryMemoryHandler.free(ptr, size);
     return;
@@ -154,9 +335,200 @@ void ObjectPoolMemoryHandler::free(void* ptr, size_t size) {
   /* Find the pool group associated with the requested chunk size */
   int poolGroupIndex = mChunkSizePoolMap[size];
   assert(poolGroupIndex >= 0 && poolGroupIndex < NUM_POOL_GROUPS);
-
-  /* Clear and move the freed chunk to the first free chunk position in the pool group */
   Chunk* chunk = static_cast<Chunk*>(ptr);
-  chunk->nextChunk = mHeads[poolGroupIndex];
-  mHeads[poolGroupIndex] = chunk;
-}
\ No newline at end of file
+  ThreadCache* cache = getThreadCache();
+
+  /* Calling thread caches chunks for too many object pools already */
+  if(!cache) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    chunk->nextChunk = mHeads[poolGroupIndex];
+    mHeads[poolGroupIndex] = chunk;
+    mNumFreeBytes += mChunkSizes[poolGroupIndex];
+    mNumSharedChunks[poolGroupIndex]++;
+    mNumFrees.fetch_add(1, std::memory_order_relaxed);
+    autoTrim();
+    return;
+  }
+
+  /* Clear and move the freed chunk to the first free chunk position in the thread cache */
+  chunk->nextChunk = cache->heads[poolGroupIndex];
+  cache->heads[poolGroupIndex] = chunk;
+  const uint numCachedChunks = cache->numChunks[poolGroupIndex].load(std::memory_order_relaxed) + 1;
+  cache->numChunks[poolGroupIndex].store(numCachedChunks, std::memory_order_relaxed);
+  cache->numFrees.store(cache->numFrees.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+  /* Return a batch to the shared pool group once the cache holds two of them */
+  if(numCachedChunks >= 2 * mBatchSizes[poolGroupIndex]) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    drain(*cache, poolGroupIndex, mBatchSizes[poolGroupIndex]);
+    autoTrim();
+  }
+}
+
+/* Find the pool containing a chunk, the pools being sorted by address */
+ObjectPoolMemoryHandler::Pool* ObjectPoolMemoryHandler::findPool(const Chunk* chunk) {
+  const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(chunk);
+
+  /* First pool starting past the chunk, the pool containing the chunk being the one before */
+  Pool* pool = std::upper_bound(mPools, mPools + mNumUsedPools, address, [](std::uintptr_t chunkAddress, const Pool& pool) {
+    return chunkAddress < reinterpret_cast<std::uintptr_t>(pool.chunks);
+  });
+
+  assert(pool != mPools);
+  pool--;
+  assert(address - reinterpret_cast<std::uintptr_t>(pool->chunks) < POOL_SIZE);
+  return pool;
+}
+
+/* Release the pools whose chunks are all in the shared pool groups and return the number of bytes released */
+size_t ObjectPoolMemoryHandler::trimPools() {
+  std::sort(mPools, mPools + mNumUsedPools, [](const Pool& first, const Pool& second) {
+    return reinterpret_cast<std::uintptr_t>(first.chunks) < reinterpret_cast<std::uintptr_t>(second.chunks);
+  });
+
+  for(uint i = 0; i < mNumUsedPools; i++) {
+    mPools[i].numFreeChunks = 0;
+  }
+
+  /* Occupancy of every pool is counted from the free chunks of its pool group */
+  for(uint i = 0; i < NUM_POOL_GROUPS; i++) {
+    for(Chunk* chunk = mHeads[i]; chunk; chunk = chunk->nextChunk) {
+      findPool(chunk)->numFreeChunks++;
+    }
+  }
+
+  /* Unlink the chunks of the pools which are entirely free */
+  for(uint i = 0; i < NUM_POOL_GROUPS; i++) {
+    const uint numChunks = static_cast<uint>(POOL_SIZE) / mChunkSizes[i];
+    Chunk** link = mHeads + i;
+
+    while(*link) {
+      if(findPool(*link)->numFreeChunks == numChunks) {
+        *link = (*link)->nextChunk;
+        mNumFreeBytes -= mChunkSizes[i];
+        mNumSharedChunks[i]--;
+      }
+      else {
+        link = &(*link)->nextChunk;
+      }
+    }
+  }
+
+  /* Release the free pools and compact the remaining ones */
+  size_t numReleasedBytes = 0;
+  uint numUsedPools = 0;
+
+  for(uint i = 0; i < mNumUsedPools; i++) {
+    Pool& pool = mPools[i];
+
+    if(pool.numFreeChunks == static_cast<uint>(POOL_SIZE) / mChunkSizes[pool.poolGroupIndex]) {
+      const uint numChunks = static_cast<uint>(POOL_SIZE) / mChunkSizes[pool.poolGroupIndex];
+      mPrimaryMemoryHandler.free(pool.chunks, POOL_SIZE);
+      mNumGroupChunks[pool.poolGroupIndex] -= numChunks;
+      mNumChunkBytes -= numChunks * mChunkSizes[pool.poolGroupIndex];
+      numReleasedBytes += POOL_SIZE;
+    }
+    else {
+      mPools[numUsedPools++] = pool;
+    }
+  }
+
+  mNumUsedPools = numUsedPools;
+  mNextTrimBytes = mNumFreeBytes + mTrimThreshold;
+  return numReleasedBytes;
+}
+
+/* Trim the pools once the shared pool groups hold enough memory as per the trim threshold */
+void ObjectPoolMemoryHandler::autoTrim() {
+  /* The next trim waits for the threshold to be exceeded again so pools which cannot be released are not swept over and over */
+  if(mTrimThreshold && mNumFreeBytes >= mNextTrimBytes) {
+    trimPools();
+  }
+}
+
+/* Release the pools of which no chunk is in use and return the number of bytes released */
+size_t ObjectPoolMemoryHandler::trim() {
+  ThreadCache* cache = getThreadCache();
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  /* Chunks cached by the calling thread are returned first */
+  if(cache) {
+    for(uint i = 0; i < NUM_POOL_GROUPS; i++) {
+      drain(*cache, i, 0);
+    }
+  }
+
+  return trimPools();
+}
+
+/* Set the size of the chunks held by the shared pool groups above which pools are trimmed automatically, zero to disable */
+void ObjectPoolMemoryHandler::setTrimThreshold(size_t trimThreshold) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mTrimThreshold = trimThreshold;
+  mNextTrimBytes = mNumFreeBytes + mTrimThreshold;
+}
+
+/* Record the size of the chunks outside of the shared pool groups if it is the highest so far */
+void ObjectPoolMemoryHandler::updatePeakUsedBytes() {
+  const size_t numUsedBytes = mNumChunkBytes - mNumFreeBytes + mNumLargeBytes.load(std::memory_order_relaxed);
+
+  if(numUsedBytes > mNumPeakUsedBytes) {
+    mNumPeakUsedBytes = numUsedBytes;
+  }
+}
+
+/* Get the number of chunks of a pool group which are in use, the shared pool groups and the thread caches being locked */
+uint ObjectPoolMemoryHandler::getNumUsedChunksLocked(uint poolGroupIndex) const {
+  uint numUsedChunks = mNumGroupChunks[poolGroupIndex] - mNumSharedChunks[poolGroupIndex];
+
+  for(ThreadCache* cache = mFirstThreadCache; cache; cache = cache->nextCache) {
+    numUsedChunks -= cache->numChunks[poolGroupIndex].load(std::memory_order_relaxed);
+  }
+
+  return numUsedChunks;
+}
+
+/* Get the live statistics of the handler */
+MemoryStatistics ObjectPoolMemoryHandler::getStatistics() {
+  std::lock_guard<std::mutex> lock(mThreadCacheMutex);
+  std::lock_guard<std::mutex> handlerLock(mMutex);
+  MemoryStatistics statistics;
+  const size_t numLargeBytes = mNumLargeBytes.load(std::memory_order_relaxed);
+
+  for(uint i = 0; i < NUM_POOL_GROUPS; i++) {
+    statistics.numUsedBytes += static_cast<size_t>(getNumUsedChunksLocked(i)) * mChunkSizes[i];
+  }
+
+  statistics.numUsedBytes += numLargeBytes;
+  statistics.numReservedBytes = mNumUsedPools * POOL_SIZE + mNumAllocatedPools * sizeof(Pool) + numLargeBytes;
+  statistics.numPeakUsedBytes = mNumPeakUsedBytes > statistics.numUsedBytes ? mNumPeakUsedBytes : statistics.numUsedBytes;
+  statistics.numAllocations = mNumAllocations.load(std::memory_order_relaxed);
+  statistics.numFrees = mNumFrees.load(std::memory_order_relaxed);
+
+  /* Counts of the attached caches may lag slightly behind the threads which own them */
+  for(ThreadCache* cache = mFirstThreadCache; cache; cache = cache->nextCache) {
+    statistics.numAllocations += cache->numAllocations.load(std::memory_order_relaxed);
+    statistics.numFrees += cache->numFrees.load(std::memory_order_relaxed);
+  }
+
+  return statistics;
+}
+
+/* Get the number of chunks of a pool group which are in use */
+uint ObjectPoolMemoryHandler::getNumUsedChunks(uint poolGroupIndex) {
+  assert(poolGroupIndex < NUM_POOL_GROUPS);
+  std::lock_guard<std::mutex> lock(mThreadCacheMutex);
+  std::lock_guard<std::mutex> handlerLock(mMutex);
+  return getNumUsedChunksLocked(poolGroupIndex);
+}
+
+/* Get the number of pool groups */
+uint ObjectPoolMemoryHandler::getNumPoolGroups() {
+  return NUM_POOL_GROUPS;
+}
+
+/* Get the chunk size of a pool group */
+uint ObjectPoolMemoryHandler::getChunkSize(uint poolGroupIndex) {
+  assert(init && poolGroupIndex < NUM_POOL_GROUPS);
+  return mChunkSizes[poolGroupIndex];
+}
@@ -0,0 +1,343 @@
+#include <cstdlib>
+#include <cassert>
+#include <physics/memory/TLSF.h>
+#include <physics/memory/MemoryHandler.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace physics;
+
+size_t TLSFMemoryHandler::INIT_SIZE = 5242880;
+
+/* Index of the least significant set bit of a non-zero word */
+static uint32 findFirstSet(uint32 word) {
+  assert(word);
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, word);
+  return static_cast<uint32>(index);
+#else
+  return static_cast<uint32>(__builtin_ctz(word));
+#endif
+}
+
+/* Index of the most significant set bit of a non-zero word */
+static uint32 findLastSet(uint32 word) {
+  assert(word);
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse(&index, word);
+  return static_cast<uint32>(index);
+#else
+  return static_cast<uint32>(31 - __builtin_clz(word));
+#endif
+}
+
+/* Constructor */
+TLSFMemoryHandler::TLSFMemoryHandler(MemoryHandler& primaryMemoryHandler, size_t initSize) : mPrimaryMemoryHandler(primaryMemoryHandler), mAllocated(0), mRegions(nullptr), mFirstLevelBitmap(0), mNumUsedBytes(0), mNumPeakUsedBytes(0), mNumAllocations(0), mNumFrees(0) {
+  for(uint32 i = 0; i < FIRST_LEVEL_COUNT; i++) {
+    mSecondLevelBitmaps[i] = 0;
+
+    for(uint32 j = 0; j < SECOND_LEVEL_COUNT; j++) {
+      mFreeBlocks[i][j] = nullptr;
+    }
+  }
+
+  apportion(initSize == 0 ? INIT_SIZE : initSize);
+}
+
+/* Destructor */
+TLSFMemoryHandler::~TLSFMemoryHandler() {
+  RegionHeader* region = mRegions;
+
+  while(region) {
+    /* Every block of the region must have been freed and coalesced back into a single one */
+    assert(reinterpret_cast<BlockHeader*>(reinterpret_cast<unsigned char*>(region) + REGION_HEADER_SIZE)->isFree);
+    assert(reinterpret_cast<BlockHeader*>(reinterpret_cast<unsigned char*>(region) + REGION_HEADER_SIZE)->isLast);
+    RegionHeader* next = region->next;
+
+    /* Release the memory allocated for each region */
+    mPrimaryMemoryHandler.free(static_cast<void*>(region), region->size);
+    region = next;
+  }
+}
+
+/* Get the size class of a block */
+void TLSFMemoryHandler::mapping(size_t size, uint32& firstLevel, uint32& secondLevel) {
+  assert(size < (uint64(1) << FIRST_LEVEL_MAX_LOG2));
+
+  /* Small blocks are spread linearly over the second level size classes of the first one */
+  if(size < SMALL_BLOCK_SIZE) {
+    firstLevel = 0;
+    secondLevel = static_cast<uint32>(size >> ALIGNMENT_LOG2);
+    return;
+  }
+
+  const uint32 lastSet = findLastSet(static_cast<uint32>(size));
+  firstLevel = lastSet - FIRST_LEVEL_SHIFT + 1;
+  secondLevel = static_cast<uint32>(size >> (lastSet - SECOND_LEVEL_LOG2)) ^ SECOND_LEVEL_COUNT;
+}
+
+/* Get the smallest size class whose blocks can all accomodate a size */
+void TLSFMemoryHandler::mappingSearch(size_t size, uint32& firstLevel, uint32& secondLevel) {
+  /* Round up to the next size class so that any block found is large enough without walking the list */
+  if(size >= SMALL_BLOCK_SIZE) {
+    size += (size_t(1) << (findLastSet(static_cast<uint32>(size)) - SECOND_LEVEL_LOG2)) - 1;
+  }
+
+  mapping(size, firstLevel, secondLevel);
+}
+
+/* Get the next block in memory */
+TLSFMemoryHandler::BlockHeader* TLSFMemoryHandler::getNextPhysical(BlockHeader* block) {
+  assert(!block->isLast);
+  return reinterpret_cast<BlockHeader*>(reinterpret_cast<unsigned char*>(block) + BLOCK_HEADER_SIZE + block->size);
+}
+
+/* Insert a free block into the list of its size class */
+void TLSFMemoryHandler::insertFreeBlock(BlockHeader* block) {
+  uint32 firstLevel;
+  uint32 secondLevel;
+  mapping(block->size, firstLevel, secondLevel);
+
+  BlockHeader* head = mFreeBlocks[firstLevel][secondLevel];
+  block->isFree = true;
+  block->previousFree = nullptr;
+  block->nextFree = head;
+
+  if(head) {
+    head->previousFree = block;
+  }
+
+  mFreeBlocks[firstLevel][secondLevel] = block;
+  mFirstLevelBitmap |= uint32(1) << firstLevel;
+  mSecondLevelBitmaps[firstLevel] |= uint32(1) << secondLevel;
+}
+
+/* Remove a free block from the list of its size class */
+void TLSFMemoryHandler::removeFreeBlock(BlockHeader* block) {
+  assert(block->isFree);
+  uint32 firstLevel;
+  uint32 secondLevel;
+  mapping(block->size, firstLevel, secondLevel);
+
+  if(block->previousFree) {
+    block->previousFree->nextFree = block->nextFree;
+  }
+  else {
+    assert(mFreeBlocks[firstLevel][secondLevel] == block);
+    mFreeBlocks[firstLevel][secondLevel] = block->nextFree;
+
+    /* Size class is now empty */
+    if(!block->nextFree) {
+      mSecondLevelBitmaps[firstLevel] &= ~(uint32(1) << secondLevel);
+
+      if(!mSecondLevelBitmaps[firstLevel]) {
+        mFirstLevelBitmap &= ~(uint32(1) << firstLevel);
+      }
+    }
+  }
+
+  if(block->nextFree) {
+    block->nextFree->previousFree = block->previousFree;
+  }
+
+  block->isFree = false;
+  block->nextFree = nullptr;
+  block->previousFree = nullptr;
+}
+
+/* Find and remove a free block which can accomodate a size */
+TLSFMemoryHandler::BlockHeader* TLSFMemoryHandler::findFreeBlock(size_t size) {
+  uint32 firstLevel;
+  uint32 secondLevel;
+  mappingSearch(size, firstLevel, secondLevel);
+
+  /* Free blocks within the same first level size class */
+  uint32 secondLevelBitmap = mSecondLevelBitmaps[firstLevel] & (~uint32(0) << secondLevel);
+
+  if(!secondLevelBitmap) {
+    /* Free blocks within a larger first level size class */
+    const uint32 firstLevelBitmap = firstLevel + 1 < FIRST_LEVEL_COUNT ? mFirstLevelBitmap & (~uint32(0) << (firstLevel + 1)) : 0;
+
+    if(!firstLevelBitmap) {
+      return nullptr;
+    }
+
+    firstLevel = findFirstSet(firstLevelBitmap);
+    secondLevelBitmap = mSecondLevelBitmaps[firstLevel];
+  }
+
+  secondLevel = findFirstSet(secondLevelBitmap);
+  BlockHeader* block = mFreeBlocks[firstLevel][secondLevel];
+  assert(block && block->size >= size);
+  removeFreeBlock(block);
+  return block;
+}
+
+/* Split memory block into two portions, keeping the remainder free */
+void TLSFMemoryHandler::split(BlockHeader* block, size_t size) {
+  assert(block->size >= size);
+
+  /* Remainder is too small to hold a block of its own */
+  if(block->size - size < BLOCK_HEADER_SIZE + ALIGNMENT) {
+    return;
+  }
+
+  BlockHeader* remainder = reinterpret_cast<BlockHeader*>(reinterpret_cast<unsigned char*>(block) + BLOCK_HEADER_SIZE + size);
+  remainder->previousPhysical = block;
+  remainder->size = block->size - size - BLOCK_HEADER_SIZE;
+  remainder->isLast = block->isLast;
+
+  if(!remainder->isLast) {
+    getNextPhysical(remainder)->previousPhysical = remainder;
+  }
+
+  block->size = size;
+  block->isLast = false;
+  insertFreeBlock(remainder);
+}
+
+/* Absorb the next block in memory into a block */
+void TLSFMemoryHandler::absorb(BlockHeader* block, BlockHeader* next) {
+  assert(!block->isLast && getNextPhysical(block) == next);
+  block->size += BLOCK_HEADER_SIZE + next->size;
+  block->isLast = next->isLast;
+
+  if(!block->isLast) {
+    getNextPhysical(block)->previousPhysical = block;
+  }
+}
+
+/* Apportion additional memory */
+void TLSFMemoryHandler::apportion(size_t size) {
+  size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  const size_t regionSize = REGION_HEADER_SIZE + BLOCK_HEADER_SIZE + size;
+
+  /* Call on primary memory handler to allocate new memory */
+  void* raw = mPrimaryMemoryHandler.allocate(regionSize);
+  assert(raw);
+
+  RegionHeader* region = static_cast<RegionHeader*>(raw);
+  region->next = mRegions;
+  region->size = regionSize;
+  mRegions = region;
+
+  /* Region starts out as a single free block */
+  BlockHeader* block = reinterpret_cast<BlockHeader*>(static_cast<unsigned char*>(raw) + REGION_HEADER_SIZE);
+  block->previousPhysical = nullptr;
+  block->size = size;
+  block->isLast = true;
+  insertFreeBlock(block);
+  mAllocated += size;
+}
+
+/* Dynamically allocate memory of size in bytes and return a pointer to the heap allocated block */
+void* TLSFMemoryHandler::allocate(size_t size) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  assert(size);
+
+  /* Not possible to allocate zero memory */
+  if(!size) {
+    return nullptr;
+  }
+
+  size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  BlockHeader* block = findFreeBlock(size);
+
+  /* More memory required */
+  if(!block) {
+    /* Leave room for the block to be found through the rounded up size class */
+    apportion((mAllocated > size ? mAllocated : size) + (size >> SECOND_LEVEL_LOG2) + ALIGNMENT);
+    block = findFreeBlock(size);
+    assert(block);
+  }
+
+  split(block, size);
+  mNumUsedBytes += block->size;
+  mNumAllocations++;
+
+  if(mNumUsedBytes > mNumPeakUsedBytes) {
+    mNumPeakUsedBytes = mNumUsedBytes;
+  }
+
+  /* Void pointer to the memory space of the block after the block header */
+  return static_cast<void*>(reinterpret_cast<unsigned char*>(block) + BLOCK_HEADER_SIZE);
+}
+
+/* Free dynamically allocated memory */
+void TLSFMemoryHandler::free(void* ptr, size_t size) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  assert(size > 0);
+
+  /* Not possible to free zero memory */
+  if(size == 0) {
+    return;
+  }
+
+  BlockHeader* block = reinterpret_cast<BlockHeader*>(static_cast<unsigned char*>(ptr) - BLOCK_HEADER_SIZE);
+  assert(!block->isFree && block->size >= size);
+  mNumUsedBytes -= block->size;
+  mNumFrees++;
+
+  /* Merge with the previous block in memory if it is free */
+  if(block->previousPhysical && block->previousPhysical->isFree) {
+    BlockHeader* previous = block->previousPhysical;
+    removeFreeBlock(previous);
+    absorb(previous, block);
+    block = previous;
+  }
+
+  /* Merge with the next block in memory if it is free */
+  if(!block->isLast) {
+    BlockHeader* next = getNextPhysical(block);
+
+    if(next->isFree) {
+      removeFreeBlock(next);
+      absorb(block, next);
+    }
+  }
+
+  insertFreeBlock(block);
+}
+
+/* Get the live statistics of the handler */
+MemoryStatistics TLSFMemoryHandler::getStatistics() {
+  std::lock_guard<std::mutex> lock(mMutex);
+  MemoryStatistics statistics;
+  statistics.numUsedBytes = mNumUsedBytes;
+  statistics.numReservedBytes = mAllocated;
+  statistics.numPeakUsedBytes = mNumPeakUsedBytes;
+  statistics.numAllocations = mNumAllocations;
+  statistics.numFrees = mNumFrees;
+
+  /* Headers of the blocks count as neither used nor free */
+  size_t numFreeBytes = 0;
+
+  for(uint32 i = 0; i < FIRST_LEVEL_COUNT; i++) {
+    for(uint32 j = 0; j < SECOND_LEVEL_COUNT; j++) {
+      for(BlockHeader* block = mFreeBlocks[i][j]; block; block = block->nextFree) {
+        numFreeBytes += block->size;
+      }
+    }
+  }
+
+  /* Largest free block is within the highest non empty size class */
+  size_t numLargestFreeBytes = 0;
+
+  if(mFirstLevelBitmap) {
+    const uint32 firstLevel = findLastSet(mFirstLevelBitmap);
+    const uint32 secondLevel = findLastSet(mSecondLevelBitmaps[firstLevel]);
+
+    for(BlockHeader* block = mFreeBlocks[firstLevel][secondLevel]; block; block = block->nextFree) {
+      if(block->size > numLargestFreeBytes) {
+        numLargestFreeBytes = block->size;
+      }
+    }
+  }
+
+  statistics.fragmentation = numFreeBytes ? 1.0f - static_cast<float>(numLargestFreeBytes) / static_cast<float>(numFreeBytes) : 0.0f;
+  return statistics;
+}
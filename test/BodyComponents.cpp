@@ -0,0 +1,75 @@
+#include "UnitTests.h"
+
+#include <physics/common/BodyComponents.h>
+#include <physics/memory/Vanilla.h>
+
+#include <sstream>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+
+using namespace physics;
+
+TEST(BodyComponents, NumSleepingBodies) {
+  VanillaMemoryHandler memoryHandler;
+  BodyComponents components(memoryHandler);
+  const Vector2 position;
+  Entity entities[4] = {Entity(0, 0), Entity(1, 0), Entity(2, 0), Entity(3, 0)};
+
+  for(uint32 i = 0; i < 4; i++) {
+    components.insertComponent(entities[i], false, BodyComponents::BodyComponent(nullptr, BodyType::Dynamic, position));
+  }
+
+  components.setIsSleeping(entities[2], true);
+  components.setIsSleeping(entities[3], true);
+  EXPECT_TRUE(components.getNumSleepingBodies() == 2);
+
+  /* Sleeping bodies keep being counted while they are swapped and moved around */
+  components.setIsEntityDisabled(entities[2], true);
+  components.setIsEntityDisabled(entities[3], true);
+  EXPECT_TRUE(components.getNumSleepingBodies() == 2);
+  components.insertComponent(Entity(4, 0), false, BodyComponents::BodyComponent(nullptr, BodyType::Dynamic, position));
+  EXPECT_TRUE(components.getNumSleepingBodies() == 2);
+  components.removeComponent(entities[0]);
+  EXPECT_TRUE(components.getNumSleepingBodies() == 2);
+
+  /* Removing a sleeping body stops counting it */
+  components.removeComponent(entities[3]);
+  EXPECT_TRUE(components.getNumSleepingBodies() == 1);
+  EXPECT_TRUE(components.getIsSleeping(entities[2]));
+  components.setIsSleeping(entities[2], false);
+  EXPECT_TRUE(components.getNumSleepingBodies() == 0);
+}
+
+TEST(BodyComponents, NumStaticBodies) {
+  VanillaMemoryHandler memoryHandler;
+  BodyComponents components(memoryHandler);
+  const Vector2 position;
+  Entity entities[4] = {Entity(0, 0), Entity(1, 0), Entity(2, 0), Entity(3, 0)};
+
+  for(uint32 i = 0; i < 4; i++) {
+    components.insertComponent(entities[i], false, BodyComponents::BodyComponent(nullptr, i < 2 ? BodyType::Static : BodyType::Dynamic, position));
+  }
+
+  EXPECT_TRUE(components.getNumStaticBodies() == 2);
+
+  /* Only changes from or to the static type are counted */
+  components.setType(entities[2], BodyType::Kinematic);
+  EXPECT_TRUE(components.getNumStaticBodies() == 2);
+  components.setType(entities[2], BodyType::Static);
+  EXPECT_TRUE(components.getNumStaticBodies() == 3);
+  components.setType(entities[2], BodyType::Dynamic);
+  EXPECT_TRUE(components.getNumStaticBodies() == 2);
+
+  /* Static bodies keep being counted while they are swapped and moved around */
+  components.setIsEntityDisabled(entities[0], true);
+  EXPECT_TRUE(components.getNumStaticBodies() == 2);
+  components.removeComponent(entities[3]);
+  EXPECT_TRUE(components.getNumStaticBodies() == 2);
+  EXPECT_TRUE(components.getType(entities[0]) == BodyType::Static);
+  EXPECT_TRUE(components.getType(entities[1]) == BodyType::Static);
+
+  /* Removing a static body stops counting it */
+  components.removeComponent(entities[1]);
+  EXPECT_TRUE(components.getNumStaticBodies() == 1);
+}
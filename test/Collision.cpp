@@ -1,6 +1,10 @@
 #include "UnitTests.h"
 
 #include <physics/Physics.h>
+#include <physics/collision/NarrowPhase.h>
+#include <physics/collision/algorithms/CircleVCircleAlgorithm.h>
+#include <physics/collision/algorithms/PolygonVPolygonAlgorithm.h>
+#include <physics/memory/Vanilla.h>
 
 #include <sstream>
 #include <type_traits>
@@ -10,3 +14,203 @@
 
 using namespace physics;
 
+
+TEST(Collision, CircleVCircleBatch) {
+  VanillaMemoryHandler memoryHandler;
+  Factory factory;
+  CircleShape* smallCircle = factory.createCircle(0.5f);
+  CircleShape* largeCircle = factory.createCircle(1.25f);
+  CircleVCircleAlgorithm algorithm;
+  NarrowPhase::NarrowPhaseBatch scalarBatch(memoryHandler);
+  NarrowPhase::NarrowPhaseBatch wideBatch(memoryHandler);
+  /* A count which is not a multiple of the lane count exercises the masked tail */
+  const uint32 numEntries = 37;
+
+  for(uint32 i = 0; i < numEntries; i++) {
+    CircleShape* secondShape = i % 2 ? largeCircle : smallCircle;
+    const Transform firstTransform(Vector2(0.1f * i, -0.2f * i), Rotation(0.3f * i));
+    const Transform secondTransform(Vector2(0.1f * i + 0.15f * (i % 13), -0.2f * i + 0.05f * (i % 7)), Rotation(0.0f));
+
+    for(NarrowPhase::NarrowPhaseBatch* batch : {&scalarBatch, &wideBatch}) {
+      batch->add(i, i, Entity(2 * i, 0), Entity(2 * i + 1, 0), smallCircle, secondShape, firstTransform, secondTransform, SeparatingAxis());
+    }
+  }
+
+  for(uint32 i = 0; i < numEntries; i++) {
+    algorithm.execute(scalarBatch, i);
+  }
+
+  algorithm.executeBatch(wideBatch, 0, numEntries);
+  uint32 numColliding = 0;
+
+  for(uint32 i = 0; i < numEntries; i++) {
+    EXPECT_TRUE(scalarBatch.isColliding[i] == wideBatch.isColliding[i]);
+    EXPECT_TRUE(scalarBatch.manifolds[i].numPoints == wideBatch.manifolds[i].numPoints);
+
+    if(wideBatch.isColliding[i]) {
+      numColliding++;
+      EXPECT_TRUE(wideBatch.manifolds[i].type == LocalManifoldInfo::ManifoldType::Circles);
+      EXPECT_TRUE(wideBatch.manifolds[i].numPoints == 1);
+      EXPECT_TRUE(wideBatch.manifolds[i].localPoint == scalarBatch.manifolds[i].localPoint);
+      EXPECT_TRUE(wideBatch.manifolds[i].points[0].localPoint == scalarBatch.manifolds[i].points[0].localPoint);
+    }
+  }
+
+  /* Both colliding and separated pairs are covered */
+  EXPECT_TRUE(numColliding > 0 && numColliding < numEntries);
+}
+
+TEST(Collision, PolygonVPolygonSeparatingAxis) {
+  VanillaMemoryHandler memoryHandler;
+  Factory factory;
+  Vector2 points[MAX_POLYGON_VERTICES];
+
+  /* An octagon fills every padded lane so the deepest axis may lie in any SIMD register */
+  for(uint32 i = 0; i < MAX_POLYGON_VERTICES; i++) {
+    const float angle = 2.0f * PI * i / MAX_POLYGON_VERTICES;
+    points[i] = Vector2(std::cos(angle), std::sin(angle));
+  }
+
+  PolygonShape* octagon = factory.createPolygon(points, MAX_POLYGON_VERTICES);
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+  PolygonVPolygonAlgorithm algorithm;
+
+  /* Face to face contact along each edge normal of the octagon */
+  for(uint32 i = 0; i < MAX_POLYGON_VERTICES; i++) {
+    const float angle = 2.0f * PI * (i + 0.5f) / MAX_POLYGON_VERTICES;
+    const Vector2 direction(std::cos(angle), std::sin(angle));
+    const float apothem = std::cos(PI / MAX_POLYGON_VERTICES);
+
+    for(float gap : {-0.05f, 0.2f}) {
+      NarrowPhase::NarrowPhaseBatch batch(memoryHandler);
+      const Transform firstTransform(Vector2(1.0f, -2.0f), Rotation(0.0f));
+      const Transform secondTransform(firstTransform.getPosition() + (apothem + 0.5f + gap) * direction, Rotation(angle));
+      batch.add(i, i, Entity(0, 0), Entity(1, 0), octagon, box, firstTransform, secondTransform, SeparatingAxis());
+      algorithm.executeBatch(batch, 0, 1);
+
+      if(gap > 0.0f) {
+        EXPECT_FALSE(batch.isColliding[0]);
+        continue;
+      }
+
+      ASSERT_TRUE(batch.isColliding[0]);
+      const LocalManifoldInfo& manifold = batch.manifolds[0];
+      EXPECT_TRUE(manifold.numPoints == 2);
+
+      /* The reference face may belong to either polygon since both faces are parallel */
+      if(manifold.type == LocalManifoldInfo::ManifoldType::FaceA) {
+        EXPECT_NEAR(dot(firstTransform.getOrientation() * manifold.localNormal, direction), 1.0f, 1e-4f);
+      }
+      else {
+        EXPECT_TRUE(manifold.type == LocalManifoldInfo::ManifoldType::FaceB);
+        EXPECT_NEAR(dot(secondTransform.getOrientation() * manifold.localNormal, direction), -1.0f, 1e-4f);
+      }
+    }
+  }
+}
+
+TEST(Collision, PolygonVPolygonSeparatingAxisCache) {
+  VanillaMemoryHandler memoryHandler;
+  Factory factory;
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+  PolygonVPolygonAlgorithm algorithm;
+  const Transform firstTransform(Vector2(0.0f, 0.0f), Rotation(0.0f));
+  const Transform separatedTransform(Vector2(1.5f, 0.2f), Rotation(0.1f));
+  const Transform touchingTransform(Vector2(0.95f, 0.2f), Rotation(0.0f));
+  NarrowPhase::NarrowPhaseBatch batch(memoryHandler);
+
+  /* A separated pair records its separating axis */
+  batch.add(0, 0, Entity(0, 0), Entity(1, 0), box, box, firstTransform, separatedTransform, SeparatingAxis());
+  algorithm.executeBatch(batch, 0, 1);
+  EXPECT_FALSE(batch.isColliding[0]);
+  const SeparatingAxis separatingAxis = batch.separatingAxes[0];
+  EXPECT_TRUE(separatingAxis.owner != SeparatingAxis::Owner::None);
+
+  /* The cached axis still separates the pair during the next frame */
+  batch.clear();
+  batch.add(0, 0, Entity(0, 0), Entity(1, 0), box, box, firstTransform, separatedTransform, separatingAxis);
+  algorithm.executeBatch(batch, 0, 1);
+  EXPECT_FALSE(batch.isColliding[0]);
+  EXPECT_TRUE(batch.separatingAxes[0].owner == separatingAxis.owner && batch.separatingAxes[0].edge == separatingAxis.edge);
+
+  /* A stale axis which no longer separates the pair leads to the same manifold as no axis at all */
+  NarrowPhase::NarrowPhaseBatch uncachedBatch(memoryHandler);
+  batch.clear();
+  batch.add(0, 0, Entity(0, 0), Entity(1, 0), box, box, firstTransform, touchingTransform, SeparatingAxis(SeparatingAxis::Owner::SecondShape, 2));
+  uncachedBatch.add(0, 0, Entity(0, 0), Entity(1, 0), box, box, firstTransform, touchingTransform, SeparatingAxis());
+  algorithm.executeBatch(batch, 0, 1);
+  algorithm.executeBatch(uncachedBatch, 0, 1);
+  ASSERT_TRUE(batch.isColliding[0] && uncachedBatch.isColliding[0]);
+  EXPECT_TRUE(batch.manifolds[0].type == uncachedBatch.manifolds[0].type);
+  EXPECT_TRUE(batch.manifolds[0].numPoints == uncachedBatch.manifolds[0].numPoints);
+  EXPECT_TRUE(batch.manifolds[0].localNormal == uncachedBatch.manifolds[0].localNormal);
+
+  /* A touching pair caches its reference face */
+  EXPECT_TRUE(batch.separatingAxes[0].owner == uncachedBatch.separatingAxes[0].owner && batch.separatingAxes[0].edge == uncachedBatch.separatingAxes[0].edge);
+  EXPECT_TRUE(batch.separatingAxes[0].owner != SeparatingAxis::Owner::None);
+}
+
+TEST(Collision, PolygonVPolygonIncidentEdge) {
+  VanillaMemoryHandler memoryHandler;
+  Factory factory;
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+  PolygonVPolygonAlgorithm algorithm;
+
+  /* A box resting on another box far away from the origin, where a normal moved as a point would pick a side face of the upper box */
+  for(const Vector2& position : {Vector2(0.0f, 0.0f), Vector2(100.0f, 50.0f), Vector2(-40.0f, -80.0f)}) {
+    NarrowPhase::NarrowPhaseBatch batch(memoryHandler);
+    const Transform firstTransform(position, Rotation(0.0f));
+    const Transform secondTransform(position + Vector2(0.2f, 0.99f), Rotation(0.0f));
+    batch.add(0, 0, Entity(0, 0), Entity(1, 0), box, box, firstTransform, secondTransform, SeparatingAxis());
+    algorithm.executeBatch(batch, 0, 1);
+
+    ASSERT_TRUE(batch.isColliding[0]);
+    const LocalManifoldInfo& manifold = batch.manifolds[0];
+    EXPECT_TRUE(manifold.type == LocalManifoldInfo::ManifoldType::FaceA);
+    EXPECT_TRUE(manifold.numPoints == 2);
+    EXPECT_NEAR(manifold.localNormal.y, 1.0f, 1e-4f);
+
+    /* Both contact points lie on the bottom face of the upper box */
+    for(uint32 i = 0; i < manifold.numPoints; i++) {
+      EXPECT_NEAR(manifold.points[i].localPoint.y, -0.5f, 1e-4f);
+    }
+  }
+}
+
+TEST(Collision, PolygonVPolygonVertexCounts) {
+  VanillaMemoryHandler memoryHandler;
+  Factory factory;
+  Vector2 points[MAX_POLYGON_VERTICES];
+
+  for(uint32 i = 0; i < MAX_POLYGON_VERTICES; i++) {
+    const float angle = 2.0f * PI * i / MAX_POLYGON_VERTICES;
+    points[i] = Vector2(std::cos(angle), std::sin(angle));
+  }
+
+  PolygonShape* octagon = factory.createPolygon(points, MAX_POLYGON_VERTICES);
+  Vector2 trianglePoints[3] = {Vector2(-1.0f, 0.0f), Vector2(1.0f, 0.0f), Vector2(0.0f, 1.5f)};
+  PolygonShape* triangle = factory.createPolygon(trianglePoints, 3);
+  PolygonVPolygonAlgorithm algorithm;
+
+  /* Each vertex of the octagon in turn pokes into the flat bottom of the triangle, so the deepest vertex is found only if every vertex of the octagon is visited */
+  for(uint32 i = 0; i < MAX_POLYGON_VERTICES; i++) {
+    const float vertexAngle = 2.0f * PI * i / MAX_POLYGON_VERTICES;
+    const Transform octagonTransform(Vector2(3.0f, -1.0f), Rotation(0.5f * PI - vertexAngle));
+    const Transform triangleTransform(octagonTransform.getPosition() + Vector2(0.0f, 0.95f), Rotation(0.0f));
+    NarrowPhase::NarrowPhaseBatch batch(memoryHandler);
+    batch.add(0, 0, Entity(0, 0), Entity(1, 0), triangle, octagon, triangleTransform, octagonTransform, SeparatingAxis());
+    batch.add(1, 1, Entity(1, 0), Entity(0, 0), octagon, triangle, octagonTransform, triangleTransform, SeparatingAxis());
+    algorithm.executeBatch(batch, 0, 2);
+
+    ASSERT_TRUE(batch.isColliding[0] && batch.isColliding[1]);
+    EXPECT_TRUE(batch.manifolds[0].type == LocalManifoldInfo::ManifoldType::FaceA);
+    EXPECT_TRUE(batch.manifolds[1].type == LocalManifoldInfo::ManifoldType::FaceB);
+
+    /* Only the poking vertex of the octagon is in contact */
+    for(uint32 j = 0; j < 2; j++) {
+      ASSERT_TRUE(batch.manifolds[j].numPoints == 1);
+      EXPECT_NEAR(batch.manifolds[j].points[0].localPoint.x, std::cos(vertexAngle), 1e-4f);
+      EXPECT_NEAR(batch.manifolds[j].points[0].localPoint.y, std::sin(vertexAngle), 1e-4f);
+    }
+  }
+}
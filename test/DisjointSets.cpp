@@ -0,0 +1,81 @@
+#include "UnitTests.h"
+
+#include <physics/collections/DisjointSets.h>
+#include <physics/common/JobSystem.h>
+#include <physics/memory/Linear.h>
+#include <physics/memory/Vanilla.h>
+
+#include <sstream>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+using namespace physics;
+
+TEST(DisjointSets, Merge) {
+  VanillaMemoryHandler memoryHandler;
+  DisjointSets sets(memoryHandler, 8);
+  EXPECT_TRUE(sets.size() == 8);
+
+  for(uint32 i = 0; i < 8; i++) {
+    EXPECT_TRUE(sets.findRoot(i) == i);
+  }
+
+  sets.merge(5, 7);
+  sets.merge(7, 3);
+  sets.merge(1, 2);
+  EXPECT_TRUE(sets.findRoot(5) == 3);
+  EXPECT_TRUE(sets.findRoot(7) == 3);
+  EXPECT_TRUE(sets.findRoot(3) == 3);
+  EXPECT_TRUE(sets.findRoot(2) == 1);
+  EXPECT_TRUE(sets.findRoot(0) == 0);
+
+  /* Merging two elements of the same set changes nothing */
+  sets.merge(3, 5);
+  EXPECT_TRUE(sets.findRoot(5) == 3);
+
+  sets.merge(7, 2);
+  EXPECT_TRUE(sets.findRoot(5) == 1);
+  EXPECT_TRUE(sets.findRoot(3) == 1);
+  EXPECT_TRUE(sets.findRoot(6) == 6);
+
+  DisjointSets emptySets(memoryHandler, 0);
+  EXPECT_TRUE(emptySets.size() == 0);
+}
+
+TEST(DisjointSets, ParallelMerge) {
+  VanillaMemoryHandler memoryHandler;
+  JobSystem jobSystem(memoryHandler, 3);
+  const uint32 count = 10000;
+  DisjointSets sets(memoryHandler, count);
+
+  /* Link every element to the one ten places ahead, leaving ten sets in the end */
+  jobSystem.parallelFor(count - 10, 16, [&](uint32 begin, uint32 end, uint32 threadIndex) {
+    NOT_USED(threadIndex);
+
+    for(uint32 i = begin; i < end; i++) {
+      sets.merge(count - 1 - i, count - 11 - i);
+    }
+  });
+
+  for(uint32 i = 0; i < count; i++) {
+    EXPECT_TRUE(sets.findRoot(i) == i % 10);
+  }
+}
+
+TEST(DisjointSets, LinearMemory) {
+  VanillaMemoryHandler memoryHandler;
+  LinearMemoryHandler linearMemoryHandler(memoryHandler, 1024);
+
+  /* An odd sized allocation ahead of the sets must not leave their atomics misaligned */
+  linearMemoryHandler.allocate(3);
+  DisjointSets sets(linearMemoryHandler, 5);
+  linearMemoryHandler.allocate(1);
+  DisjointSets otherSets(linearMemoryHandler, 5);
+  sets.merge(4, 2);
+  otherSets.merge(3, 1);
+  EXPECT_TRUE(sets.findRoot(4) == 2);
+  EXPECT_TRUE(otherSets.findRoot(3) == 1);
+  linearMemoryHandler.reset();
+}
@@ -2,6 +2,7 @@
 
 #include <physics/collision/DynamicTree.h>
 #include <physics/collections/DynamicArray.h>
+#include <physics/memory/Linear.h>
 #include <physics/memory/Vanilla.h>
 
 #include <sstream>
@@ -208,4 +209,30 @@ TEST(DynamicTree, Overlap) {
   EXPECT_TRUE(std::find(overlapNodes.begin(), overlapNodes.end(), identifier2) != overlapNodes.end());
   EXPECT_FALSE(std::find(overlapNodes.begin(), overlapNodes.end(), identifier3) != overlapNodes.end());
   EXPECT_FALSE(std::find(overlapNodes.begin(), overlapNodes.end(), identifier4) != overlapNodes.end());
-}
\ No newline at end of file
+}
+
+TEST(DynamicTree, OverlapMemoryHandler) {
+  CountingMemoryHandler treeMemoryHandler;
+  VanillaMemoryHandler memoryHandler;
+  LinearMemoryHandler linearMemoryHandler(memoryHandler);
+  DynamicTree tree(treeMemoryHandler);
+  DynamicArray<int32> testNodes(memoryHandler);
+  DynamicArray<Pair<int32, int32>> overlapNodes(memoryHandler);
+  DynamicArray<int32> aabbOverlapNodes(memoryHandler);
+
+  for(uint32 i = 0; i < 16; i++) {
+    testNodes.add(tree.add(AABB(Vector2(1.5f * i, 0.0f), Vector2(1.5f * i + 2.0f, 2.0f)), nullptr));
+  }
+
+  /* Queries which run in parallel take their traversal stacks from the provided handler rather than from the one of the tree */
+  const uint32 numAllocations = treeMemoryHandler.numAllocations;
+  tree.getShapeShapeOverlaps(linearMemoryHandler, testNodes, 0, static_cast<uint32>(testNodes.size()), overlapNodes);
+  tree.getShapeAABBOverlap(linearMemoryHandler, AABB(Vector2(0.0f, 0.0f), Vector2(1.0f, 1.0f)), aabbOverlapNodes);
+  EXPECT_TRUE(treeMemoryHandler.numAllocations == numAllocations);
+  EXPECT_TRUE(linearMemoryHandler.getStatistics().numAllocations > 0);
+
+  /* Every shape overlaps with itself and with its neighbours */
+  EXPECT_TRUE(overlapNodes.size() == 16 + 2 * 15);
+  EXPECT_TRUE(aabbOverlapNodes.size() == 1);
+  linearMemoryHandler.reset();
+}
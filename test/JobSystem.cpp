@@ -0,0 +1,175 @@
+#include "UnitTests.h"
+
+#include <physics/common/JobSystem.h>
+#include <physics/common/TaskScheduler.h>
+#include <physics/memory/Vanilla.h>
+
+#include <sstream>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+using namespace physics;
+
+TEST(JobSystem, SerialTaskScheduler) {
+  SerialTaskScheduler scheduler;
+  std::vector<uint32> begins;
+  std::vector<uint32> ends;
+  EXPECT_TRUE(scheduler.getNumThreads() == 1);
+
+  scheduler.parallelFor(10, 4, [&](uint32 begin, uint32 end, uint32 threadIndex) {
+    EXPECT_TRUE(threadIndex == 0);
+    begins.push_back(begin);
+    ends.push_back(end);
+  });
+
+  EXPECT_TRUE(begins == std::vector<uint32>({0, 4, 8}));
+  EXPECT_TRUE(ends == std::vector<uint32>({4, 8, 10}));
+  EXPECT_TRUE(TaskScheduler::getNumChunks(10, 4) == 3);
+  EXPECT_TRUE(TaskScheduler::getNumChunks(0, 4) == 0);
+}
+
+TEST(JobSystem, ParallelFor) {
+  VanillaMemoryHandler memoryHandler;
+  JobSystem jobSystem(memoryHandler, 3);
+  EXPECT_TRUE(jobSystem.getNumThreads() == 4);
+
+  const uint32 count = 10000;
+  std::vector<std::atomic<uint32>> visits(count);
+  std::atomic<uint32> numChunks(0);
+
+  for(uint32 i = 0; i < count; i++) {
+    visits[i] = 0;
+  }
+
+  jobSystem.parallelFor(count, 64, [&](uint32 begin, uint32 end, uint32 threadIndex) {
+    EXPECT_TRUE(threadIndex < jobSystem.getNumThreads());
+    EXPECT_TRUE(begin % 64 == 0);
+    EXPECT_TRUE(end - begin <= 64);
+    numChunks++;
+
+    for(uint32 i = begin; i < end; i++) {
+      visits[i]++;
+    }
+  });
+
+  EXPECT_TRUE(numChunks == TaskScheduler::getNumChunks(count, 64));
+
+  for(uint32 i = 0; i < count; i++) {
+    EXPECT_TRUE(visits[i] == 1);
+  }
+}
+
+TEST(JobSystem, NestedParallelFor) {
+  VanillaMemoryHandler memoryHandler;
+  JobSystem jobSystem(memoryHandler, 2);
+  std::atomic<uint32> sum(0);
+
+  for(uint32 iteration = 0; iteration < 50; iteration++) {
+    sum = 0;
+
+    jobSystem.parallelFor(16, 1, [&](uint32 begin, uint32 end, uint32 threadIndex) {
+      NOT_USED(threadIndex);
+
+      for(uint32 i = begin; i < end; i++) {
+        jobSystem.parallelFor(100, 10, [&](uint32 innerBegin, uint32 innerEnd, uint32 innerThreadIndex) {
+          NOT_USED(innerThreadIndex);
+          sum += innerEnd - innerBegin;
+        });
+      }
+    });
+
+    EXPECT_TRUE(sum == 1600);
+  }
+}
+
+TEST(JobSystem, WorkStealing) {
+  VanillaMemoryHandler memoryHandler;
+  JobSystem jobSystem(memoryHandler, 1);
+  std::atomic<uint32> numCallerChunks(0);
+  EXPECT_TRUE(jobSystem.getNumStolenJobs() == 0);
+
+  /* The calling thread queues two of the four chunks, the worker thread holds on to its first chunk until the calling thread ran three */
+  jobSystem.parallelFor(4, 1, [&](uint32 begin, uint32 end, uint32 threadIndex) {
+    NOT_USED(begin);
+    NOT_USED(end);
+
+    if(threadIndex == 0) {
+      numCallerChunks++;
+      return;
+    }
+
+    while(numCallerChunks.load() < 3) {
+      std::this_thread::yield();
+    }
+  });
+
+  EXPECT_TRUE(numCallerChunks >= 3);
+  EXPECT_TRUE(jobSystem.getNumStolenJobs() > 0);
+}
+
+TEST(JobSystem, NoWorkerThreads) {
+  VanillaMemoryHandler memoryHandler;
+  JobSystem jobSystem(memoryHandler, 0);
+  uint32 sum = 0;
+  EXPECT_TRUE(jobSystem.getNumThreads() == 1);
+
+  jobSystem.parallelFor(1000, 7, [&](uint32 begin, uint32 end, uint32 threadIndex) {
+    EXPECT_TRUE(threadIndex == 0);
+    sum += end - begin;
+  });
+
+  EXPECT_TRUE(sum == 1000);
+}
+
+TEST(JobSystem, ExternalThreads) {
+  VanillaMemoryHandler memoryHandler;
+  JobSystem jobSystem(memoryHandler, 2);
+  std::atomic<uint32> sum(0);
+  std::atomic<uint32> numActiveTasks[4];
+  std::atomic<uint32> numOverlappingTasks(0);
+  std::atomic<bool> isStarted(false);
+
+  for(uint32 i = 0; i < 4; i++) {
+    numActiveTasks[i] = 0;
+  }
+
+  /* External threads submitting at once wait for their turn rather than sharing the first queue */
+  std::vector<std::thread> threads;
+
+  for(uint32 i = 0; i < 4; i++) {
+    threads.emplace_back([&, i]() {
+      while(!isStarted.load()) {
+        std::this_thread::yield();
+      }
+
+      jobSystem.parallelFor(1000, 10, [&, i](uint32 begin, uint32 end, uint32 threadIndex) {
+        EXPECT_TRUE(threadIndex < jobSystem.getNumThreads());
+        numActiveTasks[i]++;
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+
+        for(uint32 j = 0; j < 4; j++) {
+          if(j != i && numActiveTasks[j].load()) {
+            numOverlappingTasks++;
+          }
+        }
+
+        sum += end - begin;
+        numActiveTasks[i]--;
+      });
+    });
+  }
+
+  isStarted = true;
+
+  for(std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_TRUE(sum == 4000);
+  EXPECT_TRUE(numOverlappingTasks == 0);
+}
@@ -0,0 +1,48 @@
+#include "UnitTests.h"
+
+#include <physics/memory/Linear.h>
+#include <physics/memory/Vanilla.h>
+
+#include <sstream>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace physics;
+
+TEST(LinearMemoryHandler, ChainedBlocks) {
+  CountingMemoryHandler primaryMemoryHandler;
+  LinearMemoryHandler linearMemoryHandler(primaryMemoryHandler, 64);
+  const uint32 count = 1000;
+  std::vector<uint32*> blocks(count);
+  EXPECT_TRUE(primaryMemoryHandler.numAllocations == 1);
+
+  /* Overflowing the memory space chains a few geometrically growing blocks rather than allocating every time */
+  for(uint32 i = 0; i < count; i++) {
+    blocks[i] = static_cast<uint32*>(linearMemoryHandler.allocate(4 * sizeof(uint32)));
+    std::fill(blocks[i], blocks[i] + 4, i);
+  }
+
+  for(uint32 i = 0; i < count; i++) {
+    EXPECT_TRUE(std::count(blocks[i], blocks[i] + 4, i) == 4);
+  }
+
+  EXPECT_TRUE(primaryMemoryHandler.numAllocations < 16);
+
+  /* An allocation larger than twice the last block gets a block of its own */
+  char* large = static_cast<char*>(linearMemoryHandler.allocate(1 << 20));
+  std::fill(large, large + (1 << 20), 1);
+
+  /* The reset merges everything into a single memory space which fits the same frame again */
+  linearMemoryHandler.reset();
+  const uint32 numAllocations = primaryMemoryHandler.numAllocations;
+
+  for(uint32 i = 0; i < count; i++) {
+    blocks[i] = static_cast<uint32*>(linearMemoryHandler.allocate(4 * sizeof(uint32)));
+  }
+
+  linearMemoryHandler.allocate(1 << 20);
+  EXPECT_TRUE(primaryMemoryHandler.numAllocations == numAllocations);
+  linearMemoryHandler.reset();
+}
@@ -0,0 +1,114 @@
+#include "UnitTests.h"
+
+#include <physics/Physics.h>
+#include <physics/common/Logger.h>
+
+#include <chrono>
+#include <fstream>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace physics;
+
+/* Read back the lines written into a log file */
+static std::vector<std::string> readLines(const std::string& file) {
+  std::ifstream stream(file);
+  std::vector<std::string> lines;
+  std::string line;
+
+  while(std::getline(stream, line)) {
+    lines.push_back(line);
+  }
+
+  return lines;
+}
+
+TEST(Logger, Filtering) {
+  const std::string file = "logger_filtering.txt";
+  std::remove(file.c_str());
+
+  {
+    Logger logger(file, 16, LogLevel::Info);
+    logger.log(LogLevel::Debug, LogCategory::Common, "hidden");
+    logger.log(LogLevel::Warning, LogCategory::Collision, "shown");
+    logger.setIsCategoryEnabled(LogCategory::Collision, false);
+    EXPECT_TRUE(!logger.isEnabled(LogLevel::Error, LogCategory::Collision));
+    logger.log(LogLevel::Error, LogCategory::Collision, "hidden");
+    logger.setLevel(LogLevel::Debug);
+    logger.log(LogLevel::Debug, LogCategory::Memory, std::string(1000, 'a'));
+    logger.flush();
+
+    std::vector<std::string> lines = readLines(file);
+    ASSERT_TRUE(lines.size() == 2);
+    EXPECT_TRUE(lines[0].find("] [Warning] [Collision] shown") != std::string::npos);
+    /* Long messages are truncated */
+    EXPECT_TRUE(lines[1].find("] [Debug] [Memory] " + std::string(255, 'a')) != std::string::npos);
+    EXPECT_TRUE(lines[1].find(std::string(256, 'a')) == std::string::npos);
+  }
+
+  std::remove(file.c_str());
+}
+
+TEST(Logger, ConcurrentProducers) {
+  const std::string file = "logger_producers.txt";
+  const uint32 numThreads = 4;
+  const uint32 numMessages = 2000;
+  std::remove(file.c_str());
+  uint64 numDroppedMessages;
+
+  /* The destructor writes every queued message */
+  {
+    Logger logger(file, 256, LogLevel::Debug);
+    std::vector<std::thread> threads;
+
+    for(uint32 i = 0; i < numThreads; i++) {
+      threads.emplace_back([&logger, i, numMessages]() {
+        for(uint32 j = 0; j < numMessages; j++) {
+          logger.log(LogLevel::Info, LogCategory::Dynamics, "thread " + std::to_string(i) + " message " + std::to_string(j));
+        }
+      });
+    }
+
+    for(std::thread& thread : threads) {
+      thread.join();
+    }
+
+    numDroppedMessages = logger.getNumDroppedMessages();
+  }
+
+  /* Every message is either written whole or counted as dropped */
+  std::vector<std::string> lines = readLines(file);
+  EXPECT_TRUE(lines.size() + numDroppedMessages == numThreads * numMessages);
+
+  for(const std::string& line : lines) {
+    EXPECT_TRUE(line.find("] [Info] [Dynamics] thread ") != std::string::npos);
+  }
+
+  std::remove(file.c_str());
+}
+
+TEST(Logger, IdleWriter) {
+  const std::string file = "logger_idle.txt";
+  std::remove(file.c_str());
+
+  {
+    Logger logger(file, 16, LogLevel::Debug);
+
+    /* The writer thread sleeps until a message wakes it up, without flushing */
+    for(uint32 i = 0; i < 3; i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      logger.log(LogLevel::Info, LogCategory::Common, "message " + std::to_string(i));
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+      while(readLines(file).size() < i + 1 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+        std::this_thread::yield();
+      }
+
+      EXPECT_TRUE(readLines(file).size() == i + 1);
+    }
+  }
+
+  std::remove(file.c_str());
+}
@@ -210,6 +210,24 @@ TEST(Map, Modifiers) {
   }
 
   EXPECT_TRUE(map6.size() == 0);
+
+  /* Maps which released their memory grow again from scratch */
+  Map<int, int> map7(memoryHandler);
+
+  for(int i = 0; i < 2; i++) {
+    for(int j = 0; j < 100; j++) {
+      map7.insert(Pair<int, int>(j, j));
+    }
+
+    map7.clear(true);
+    map7.reserve(16);
+  }
+
+  for(int i = 0; i < 100; i++) {
+    map7.insert(Pair<int, int>(i, i));
+  }
+
+  EXPECT_TRUE(map7.size() == 100 && map7[99] == 99);
 }
 
 TEST(Map, ContainsKey) {
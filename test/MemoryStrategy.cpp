@@ -0,0 +1,150 @@
+#include "UnitTests.h"
+
+#include <physics/common/JobSystem.h>
+#include <physics/memory/MemoryStrategy.h>
+#include <physics/memory/Vanilla.h>
+
+#include <sstream>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace physics;
+
+TEST(MemoryStrategy, ThreadLinearMemoryHandlers) {
+  VanillaMemoryHandler memoryHandler;
+  MemoryStrategy memoryStrategy(&memoryHandler);
+  JobSystem jobSystem(memoryHandler, 3);
+  memoryStrategy.reserveThreadLinearMemoryHandlers(jobSystem.getNumThreads());
+
+  const uint32 count = 4096;
+  std::vector<uint32*> blocks(count);
+
+  /* Run a few frames so that the handlers are reset in between */
+  for(uint32 frame = 0; frame < 3; frame++) {
+    /* Every thread bump allocates from its own handler without locking */
+    jobSystem.parallelFor(count, 16, [&](uint32 begin, uint32 end, uint32 threadIndex) {
+      LinearMemoryHandler& linearMemoryHandler = memoryStrategy.getThreadLinearMemoryHandler(threadIndex);
+
+      for(uint32 i = begin; i < end; i++) {
+        blocks[i] = static_cast<uint32*>(linearMemoryHandler.allocate(4 * sizeof(uint32)));
+        std::fill(blocks[i], blocks[i] + 4, i + frame);
+      }
+    });
+
+    /* Blocks must not have been handed out twice */
+    for(uint32 i = 0; i < count; i++) {
+      EXPECT_TRUE(std::count(blocks[i], blocks[i] + 4, i + frame) == 4);
+    }
+
+    memoryStrategy.reset(MemoryStrategy::HandlerType::Linear);
+  }
+
+  /* Reserving fewer handlers than there are keeps the existing ones */
+  LinearMemoryHandler* firstHandler = &memoryStrategy.getThreadLinearMemoryHandler(0);
+  memoryStrategy.reserveThreadLinearMemoryHandlers(1);
+  EXPECT_TRUE(firstHandler == &memoryStrategy.getThreadLinearMemoryHandler(0));
+}
+
+TEST(MemoryStrategy, TLSFGeneralMemoryHandler) {
+  VanillaMemoryHandler memoryHandler;
+  MemoryStrategy memoryStrategy(&memoryHandler, 0, MemoryStrategy::HandlerType::TLSF);
+  EXPECT_TRUE(&memoryStrategy.getGeneralMemoryHandler() == &memoryStrategy.getTLSFMemoryHandler());
+
+  /* Object Pool handler is backed by the selected general purpose handler */
+  std::vector<void*> blocks;
+
+  for(uint32 i = 0; i < 1000; i++) {
+    blocks.push_back(memoryStrategy.allocate(MemoryStrategy::HandlerType::ObjectPool, 48));
+  }
+
+  for(void* block : blocks) {
+    memoryStrategy.free(MemoryStrategy::HandlerType::ObjectPool, block, 48);
+  }
+}
+
+TEST(MemoryStrategy, Statistics) {
+  VanillaMemoryHandler memoryHandler;
+  MemoryStrategy memoryStrategy(&memoryHandler);
+  std::vector<void*> blocks;
+
+  /* Free List handler already backs the Object Pool and Linear handlers */
+  const MemoryStatistics freeListStatistics = memoryStrategy.getStatistics(MemoryStrategy::HandlerType::FreeList);
+
+  for(uint32 i = 0; i < 100; i++) {
+    blocks.push_back(memoryStrategy.allocate(MemoryStrategy::HandlerType::FreeList, 256));
+  }
+
+  /* Freeing every other block leaves holes which fragment the free memory */
+  for(uint32 i = 0; i < 100; i += 2) {
+    memoryStrategy.free(MemoryStrategy::HandlerType::FreeList, blocks[i], 256);
+  }
+
+  MemoryStatistics statistics = memoryStrategy.getStatistics(MemoryStrategy::HandlerType::FreeList);
+  EXPECT_TRUE(statistics.numUsedBytes == freeListStatistics.numUsedBytes + 50 * 256);
+  EXPECT_TRUE(statistics.numPeakUsedBytes == freeListStatistics.numUsedBytes + 100 * 256);
+  EXPECT_TRUE(statistics.numReservedBytes >= statistics.numPeakUsedBytes);
+  EXPECT_TRUE(statistics.numAllocations == freeListStatistics.numAllocations + 100);
+  EXPECT_TRUE(statistics.numFrees == freeListStatistics.numFrees + 50);
+  EXPECT_TRUE(statistics.fragmentation > 0.0f && statistics.fragmentation < 1.0f);
+
+  for(uint32 i = 1; i < 100; i += 2) {
+    memoryStrategy.free(MemoryStrategy::HandlerType::FreeList, blocks[i], 256);
+  }
+
+  /* Object Pool handler counts the chunks in use per pool group */
+  blocks.clear();
+  ObjectPoolMemoryHandler& objectPoolMemoryHandler = memoryStrategy.getObjectPoolMemoryHandler();
+  const uint poolGroupIndex = 40 / 8 - 1;
+  const uint numUsedChunks = objectPoolMemoryHandler.getNumUsedChunks(poolGroupIndex);
+  const MemoryStatistics initialStatistics = memoryStrategy.getStatistics(MemoryStrategy::HandlerType::ObjectPool);
+
+  for(uint32 i = 0; i < 1000; i++) {
+    blocks.push_back(memoryStrategy.allocate(MemoryStrategy::HandlerType::ObjectPool, 40));
+  }
+
+  statistics = memoryStrategy.getStatistics(MemoryStrategy::HandlerType::ObjectPool);
+  EXPECT_TRUE(ObjectPoolMemoryHandler::getChunkSize(poolGroupIndex) == 40);
+  EXPECT_TRUE(objectPoolMemoryHandler.getNumUsedChunks(poolGroupIndex) == numUsedChunks + 1000);
+  EXPECT_TRUE(statistics.numUsedBytes == initialStatistics.numUsedBytes + 1000 * 40);
+  EXPECT_TRUE(statistics.numAllocations == initialStatistics.numAllocations + 1000);
+
+  for(void* block : blocks) {
+    memoryStrategy.free(MemoryStrategy::HandlerType::ObjectPool, block, 40);
+  }
+
+  EXPECT_TRUE(objectPoolMemoryHandler.getNumUsedChunks(poolGroupIndex) == numUsedChunks);
+
+  /* Linear handlers report the memory of the current frame */
+  memoryStrategy.allocate(MemoryStrategy::HandlerType::Linear, 1024);
+  statistics = memoryStrategy.getStatistics(MemoryStrategy::HandlerType::Linear);
+  EXPECT_TRUE(statistics.numUsedBytes == 1024 && statistics.numAllocations == 1);
+  memoryStrategy.reset(MemoryStrategy::HandlerType::Linear);
+  statistics = memoryStrategy.getStatistics(MemoryStrategy::HandlerType::Linear);
+  EXPECT_TRUE(statistics.numUsedBytes == 0 && statistics.numPeakUsedBytes == 1024);
+}
+
+TEST(MemoryStrategy, Alignment) {
+  VanillaMemoryHandler memoryHandler;
+  MemoryStrategy memoryStrategy(&memoryHandler);
+  const MemoryStrategy::HandlerType handlerTypes[] = {MemoryStrategy::HandlerType::Linear, MemoryStrategy::HandlerType::FreeList, MemoryStrategy::HandlerType::TLSF};
+
+  /* Odd sizes must not shift the blocks which follow them off the alignment */
+  for(MemoryStrategy::HandlerType handlerType : handlerTypes) {
+    std::vector<std::pair<void*, size_t>> blocks;
+
+    for(size_t size = 1; size < 200; size += 7) {
+      void* block = memoryStrategy.allocate(handlerType, size);
+      EXPECT_TRUE(reinterpret_cast<std::uintptr_t>(block) % alignof(std::max_align_t) == 0);
+      blocks.push_back(std::make_pair(block, size));
+    }
+
+    for(const std::pair<void*, size_t>& block : blocks) {
+      memoryStrategy.free(handlerType, block.first, block.second);
+    }
+  }
+
+  memoryStrategy.reset(MemoryStrategy::HandlerType::Linear);
+}
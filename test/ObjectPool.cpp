@@ -0,0 +1,173 @@
+#include "UnitTests.h"
+
+#include <physics/memory/ObjectPool.h>
+#include <physics/memory/Vanilla.h>
+
+#include <sstream>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <thread>
+
+using namespace physics;
+
+/* Memory handler tracking the memory held from the heap */
+class ResidentMemoryHandler : public VanillaMemoryHandler {
+
+  public:
+    /* -- Attributes -- */
+
+    /* Size of the memory allocated and not yet freed */
+    size_t numResidentBytes = 0;
+
+    /* -- Methods -- */
+
+    /* Dynamically allocate memory of size in bytes and return a pointer to the heap allocated block */
+    void* allocate(size_t size) override {
+      numResidentBytes += size;
+      return VanillaMemoryHandler::allocate(size);
+    }
+
+    /* Free dynamically allocated memory */
+    void free(void* ptr, size_t size) override {
+      numResidentBytes -= size;
+      VanillaMemoryHandler::free(ptr, size);
+    }
+};
+
+TEST(ObjectPoolMemoryHandler, ThreadCaches) {
+  VanillaMemoryHandler primaryMemoryHandler;
+  ObjectPoolMemoryHandler memoryHandler(primaryMemoryHandler);
+  const uint32 numThreads = 4;
+  const uint32 count = 5000;
+  std::vector<std::vector<uint32*>> blocks(numThreads, std::vector<uint32*>(count));
+  std::vector<std::thread> threads;
+
+  /* Threads allocate chunks of a few pool groups at once, exiting with chunks still cached */
+  for(uint32 t = 0; t < numThreads; t++) {
+    threads.emplace_back([&memoryHandler, &blocks, t]() {
+      for(uint32 i = 0; i < count; i++) {
+        const uint32 size = 1 + (i % 12);
+        blocks[t][i] = static_cast<uint32*>(memoryHandler.allocate(size * sizeof(uint32)));
+        std::fill(blocks[t][i], blocks[t][i] + size, t * count + i);
+
+        /* Free some of the chunks right away so that they cycle through the cache */
+        if(i % 3 == 0) {
+          memoryHandler.free(blocks[t][i], size * sizeof(uint32));
+          blocks[t][i] = nullptr;
+        }
+      }
+    });
+  }
+
+  for(std::thread& thread : threads) {
+    thread.join();
+  }
+
+  /* Chunks must not have been handed out twice and may be freed by another thread than the one which allocated them */
+  for(uint32 t = 0; t < numThreads; t++) {
+    for(uint32 i = 0; i < count; i++) {
+      if(blocks[t][i]) {
+        const uint32 size = 1 + (i % 12);
+        EXPECT_TRUE(std::count(blocks[t][i], blocks[t][i] + size, t * count + i) == size);
+        memoryHandler.free(blocks[t][i], size * sizeof(uint32));
+      }
+    }
+  }
+}
+
+TEST(ObjectPoolMemoryHandler, ManyObjectPools) {
+  VanillaMemoryHandler primaryMemoryHandler;
+  const uint32 numHandlers = 6;
+  std::vector<ObjectPoolMemoryHandler*> memoryHandlers;
+  std::vector<uint32*> blocks;
+
+  /* A thread caches chunks of a limited number of object pools and falls back to the shared pool groups for the others */
+  for(uint32 i = 0; i < numHandlers; i++) {
+    memoryHandlers.push_back(new ObjectPoolMemoryHandler(primaryMemoryHandler));
+    blocks.push_back(static_cast<uint32*>(memoryHandlers[i]->allocate(sizeof(uint32))));
+    *blocks[i] = i;
+  }
+
+  for(uint32 i = 0; i < numHandlers; i++) {
+    EXPECT_TRUE(*blocks[i] == i);
+    memoryHandlers[i]->free(blocks[i], sizeof(uint32));
+  }
+
+  /* Destroying an object pool releases the cache of the thread for the next object pool */
+  delete memoryHandlers[0];
+  ObjectPoolMemoryHandler memoryHandler(primaryMemoryHandler);
+  uint32* block = static_cast<uint32*>(memoryHandler.allocate(sizeof(uint32)));
+  *block = numHandlers;
+  EXPECT_TRUE(*block == numHandlers);
+  memoryHandler.free(block, sizeof(uint32));
+
+  for(uint32 i = 1; i < numHandlers; i++) {
+    delete memoryHandlers[i];
+  }
+}
+
+TEST(ObjectPoolMemoryHandler, Trim) {
+  ResidentMemoryHandler primaryMemoryHandler;
+  ObjectPoolMemoryHandler memoryHandler(primaryMemoryHandler);
+  const uint32 count = 20000;
+  std::vector<uint32*> blocks(count);
+  const size_t numInitialBytes = primaryMemoryHandler.numResidentBytes;
+
+  for(uint32 i = 0; i < count; i++) {
+    blocks[i] = static_cast<uint32*>(memoryHandler.allocate(16 * sizeof(uint32)));
+    blocks[i][0] = i;
+  }
+
+  const size_t numPeakBytes = primaryMemoryHandler.numResidentBytes;
+
+  /* Keep a single chunk in use so that its pool survives the trim */
+  for(uint32 i = 1; i < count; i++) {
+    memoryHandler.free(blocks[i], 16 * sizeof(uint32));
+  }
+
+  const size_t numReleasedBytes = memoryHandler.trim();
+  EXPECT_TRUE(numReleasedBytes > 0);
+  EXPECT_TRUE(primaryMemoryHandler.numResidentBytes == numPeakBytes - numReleasedBytes);
+  /* Only the pool of the chunk in use and the grown array of pools remain */
+  EXPECT_TRUE(primaryMemoryHandler.numResidentBytes - numInitialBytes < 2 * 16 * 1024);
+  EXPECT_TRUE(blocks[0][0] == 0);
+
+  /* Pool is still usable after trimming */
+  for(uint32 i = 1; i < count; i++) {
+    blocks[i] = static_cast<uint32*>(memoryHandler.allocate(16 * sizeof(uint32)));
+    blocks[i][0] = i;
+  }
+
+  for(uint32 i = 0; i < count; i++) {
+    EXPECT_TRUE(blocks[i][0] == i);
+    memoryHandler.free(blocks[i], 16 * sizeof(uint32));
+  }
+
+  /* Only the grown array of pools remains */
+  EXPECT_TRUE(memoryHandler.trim() > 0);
+  EXPECT_TRUE(primaryMemoryHandler.numResidentBytes - numInitialBytes < 16 * 1024);
+}
+
+TEST(ObjectPoolMemoryHandler, AutomaticTrim) {
+  ResidentMemoryHandler primaryMemoryHandler;
+  ObjectPoolMemoryHandler memoryHandler(primaryMemoryHandler);
+  memoryHandler.setTrimThreshold(256 * 1024);
+  const uint32 count = 20000;
+  std::vector<void*> blocks(count);
+
+  for(uint32 i = 0; i < count; i++) {
+    blocks[i] = memoryHandler.allocate(64);
+  }
+
+  const size_t numPeakBytes = primaryMemoryHandler.numResidentBytes;
+
+  for(uint32 i = 0; i < count; i++) {
+    memoryHandler.free(blocks[i], 64);
+  }
+
+  /* Memory is given back while freeing without ever holding much more than the threshold */
+  EXPECT_TRUE(primaryMemoryHandler.numResidentBytes < numPeakBytes);
+  EXPECT_TRUE(primaryMemoryHandler.numResidentBytes < 512 * 1024);
+}
@@ -0,0 +1,91 @@
+#include "UnitTests.h"
+
+#include <physics/dynamics/PersistentIslands.h>
+#include <physics/memory/Vanilla.h>
+
+#include <sstream>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+
+using namespace physics;
+
+TEST(PersistentIslands, AwakeIslands) {
+  VanillaMemoryHandler memoryHandler;
+  PersistentIslands islands(memoryHandler);
+
+  for(uint32 i = 0; i < 4; i++) {
+    islands.addBody(Entity(i, 0));
+  }
+
+  EXPECT_TRUE(islands.getNumAwakeIslands() == 4);
+
+  islands.merge(0, 1);
+  islands.merge(2, 3);
+  EXPECT_TRUE(islands.getNumAwakeIslands() == 2);
+  EXPECT_TRUE(islands.findRoot(0) == islands.findRoot(1));
+  EXPECT_TRUE(islands.getNumBodies(islands.findRoot(0)) == 2);
+
+  /* A sleeping island which merges with an awake one is awake */
+  const uint32 sleepingRoot = islands.findRoot(2);
+  islands.setIsAwake(sleepingRoot, false);
+  EXPECT_TRUE(islands.getNumAwakeIslands() == 1);
+  EXPECT_FALSE(islands.isAwake(sleepingRoot));
+
+  islands.merge(1, 3);
+  const uint32 root = islands.findRoot(3);
+  EXPECT_TRUE(islands.getNumAwakeIslands() == 1);
+  EXPECT_TRUE(islands.getAwakeIsland(0) == root);
+  EXPECT_TRUE(islands.getAwakeIndex(root) == 0);
+  EXPECT_TRUE(islands.getNumBodies(root) == 4);
+
+  uint32 numBodies = 0;
+
+  for(uint32 body = islands.getFirstBody(root); body != PersistentIslands::INVALID_INDEX; body = islands.getNextBody(body)) {
+    numBodies++;
+  }
+
+  EXPECT_TRUE(numBodies == 4);
+
+  /* An island is only split once it has lost a contact */
+  islands.considerSplit(root);
+  islands.split();
+  EXPECT_TRUE(islands.getNumAwakeIslands() == 1);
+  EXPECT_FALSE(islands.hasLinkPending());
+
+  islands.markSplit(2);
+  islands.considerSplit(islands.findRoot(2));
+  islands.split();
+  EXPECT_TRUE(islands.getNumAwakeIslands() == 4);
+  EXPECT_TRUE(islands.hasLinkPending());
+
+  for(uint32 i = 0; i < 4; i++) {
+    EXPECT_TRUE(islands.findRoot(i) == i);
+    EXPECT_TRUE(islands.isLinkPending(i));
+  }
+
+  islands.clearLinkPending();
+  EXPECT_FALSE(islands.hasLinkPending());
+
+  /* Static bodies are never awake and removed bodies leave the awake islands */
+  islands.setIsStatic(0, true);
+  EXPECT_TRUE(islands.getNumAwakeIslands() == 3);
+  EXPECT_FALSE(islands.isAwake(0));
+
+  islands.removeBody(Entity(1, 0));
+  EXPECT_TRUE(islands.getNumAwakeIslands() == 2);
+  EXPECT_FALSE(islands.containsBody(Entity(1, 0)));
+  EXPECT_TRUE(islands.containsBody(Entity(2, 0)));
+  EXPECT_FALSE(islands.containsBody(Entity(2, 1)));
+
+  /* A sleeping island is not split until it wakes up */
+  islands.clearLinkPending();
+  islands.merge(2, 3);
+  islands.setIsAwake(islands.findRoot(2), false);
+  islands.markSplit(2);
+  islands.considerSplit(islands.findRoot(2));
+  islands.split();
+  EXPECT_TRUE(islands.getNumAwakeIslands() == 0);
+  EXPECT_TRUE(islands.findRoot(2) == islands.findRoot(3));
+  EXPECT_FALSE(islands.hasLinkPending());
+}
@@ -0,0 +1,108 @@
+#include "UnitTests.h"
+
+#include <physics/Physics.h>
+#include <physics/common/Profiler.h>
+
+#include <sstream>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace physics;
+
+TEST(Profiler, RingBuffer) {
+  VanillaMemoryHandler memoryHandler;
+  Profiler profiler(memoryHandler, 4, false);
+
+  /* Switched off profilers record nothing */
+  {
+    ProfileScope scope(profiler, "disabled");
+  }
+
+  EXPECT_TRUE(profiler.getNumEvents() == 0);
+  profiler.setIsEnabled(true);
+
+  /* Oldest events are overwritten once the ring buffer is full */
+  const char* names[] = {"a", "b", "c", "d", "e", "f"};
+
+  for(uint32 i = 0; i < 6; i++) {
+    profiler.beginFrame();
+    ProfileScope scope(profiler, names[i]);
+  }
+
+  EXPECT_TRUE(profiler.getNumEvents() == 4);
+
+  for(uint32 i = 0; i < 4; i++) {
+    EXPECT_TRUE(std::strcmp(profiler.getEvent(i).name, names[i + 2]) == 0);
+    EXPECT_TRUE(profiler.getEvent(i).frame == i + 3);
+  }
+
+  DynamicArray<Profiler::Event> events(memoryHandler);
+  profiler.getFrameEvents(6, events);
+  EXPECT_TRUE(events.size() == 1 && std::strcmp(events[0].name, "f") == 0);
+
+  profiler.clear();
+  EXPECT_TRUE(profiler.getNumEvents() == 0);
+}
+
+#if defined(PHYSICS_PROFILING)
+TEST(Profiler, StepStages) {
+  World::Settings settings;
+  settings.isProfilingEnabled = true;
+  Factory factory;
+  World* world = factory.createWorld(settings);
+  BoxShape* box = factory.createBox(10.0f, 1.0f);
+  CircleShape* circle = factory.createCircle(0.5f);
+
+  Body* ground = world->createBody(Transform(Vector2(0.0f, -1.0f), Rotation(0.0f)));
+  ground->setType(BodyType::Static);
+  ground->addCollider(box, Transform());
+
+  for(uint32 i = 0; i < 10; i++) {
+    Body* body = world->createBody(Transform(Vector2(1.5f * i - 7.0f, 1.0f), Rotation(0.0f)));
+    body->addCollider(circle, Transform());
+    body->setMassPropertiesUsingColliders();
+  }
+
+  for(uint32 i = 0; i < 5; i++) {
+    world->step(1.0f / 60.0f);
+  }
+
+  /* Every stage of the last step is recorded */
+  Profiler& profiler = world->getProfiler();
+  VanillaMemoryHandler memoryHandler;
+  DynamicArray<Profiler::Event> events(memoryHandler);
+  profiler.getFrameEvents(profiler.getFrame(), events);
+  const char* stages[] = {"runBroadPhase", "prepareNarrowPhase", "runNarrowPhase", "generateIslands", "prepareForContactSolver",
+                          "integrateVelocities", "initializeContactSolver", "solveVelocityConstraints", "integratePositions",
+                          "solvePositionConstraints", "updateBodyStates", "updateColliders", "sleepBodies", "step"};
+
+  for(const char* stage : stages) {
+    uint32 numEvents = 0;
+
+    for(uint32 i = 0; i < events.size(); i++) {
+      numEvents += std::strcmp(events[i].name, stage) == 0;
+    }
+
+    EXPECT_TRUE(numEvents == 1) << stage;
+  }
+
+  /* Step ends last and encloses the other stages */
+  const Profiler::Event& step = events[events.size() - 1];
+  EXPECT_TRUE(std::strcmp(step.name, "step") == 0);
+
+  for(uint32 i = 0; i < events.size(); i++) {
+    EXPECT_TRUE(events[i].start >= step.start && events[i].start + events[i].duration <= step.start + step.duration);
+  }
+
+  std::stringstream stream;
+  profiler.exportChromeTrace(stream);
+  const std::string trace = stream.str();
+  EXPECT_TRUE(trace.find("{\"traceEvents\":[") == 0);
+  EXPECT_TRUE(trace.find("\"name\":\"runNarrowPhase\",\"cat\":\"physics\",\"ph\":\"X\"") != std::string::npos);
+  EXPECT_TRUE(std::count(trace.begin(), trace.end(), '{') == 2 * profiler.getNumEvents() + 1);
+}
+#endif
@@ -0,0 +1,154 @@
+#include "UnitTests.h"
+
+#include <physics/mathematics/SIMD.h>
+#include <physics/mathematics/Vector2.h>
+
+#include <sstream>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+
+using namespace physics;
+
+TEST(SIMD, LoadStore) {
+  float values[SIMD_WIDTH];
+  float result[SIMD_WIDTH];
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    values[i] = static_cast<float>(i) - 1.5f;
+  }
+
+  simdStore(result, simdLoad(values));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == values[i]);
+  }
+
+  simdStore(result, simdSet(3.0f));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == 3.0f);
+  }
+}
+
+TEST(SIMD, Arithmetic) {
+  float a[SIMD_WIDTH];
+  float b[SIMD_WIDTH];
+  float result[SIMD_WIDTH];
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    a[i] = 0.25f * static_cast<float>(i) - 0.5f;
+    b[i] = 2.0f - 0.75f * static_cast<float>(i);
+  }
+
+  const SimdFloat wideA = simdLoad(a);
+  const SimdFloat wideB = simdLoad(b);
+
+  /* Lanes must match the scalar operations exactly */
+  simdStore(result, (wideA + wideB) * wideA - wideB / simdSet(3.0f));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == (a[i] + b[i]) * a[i] - b[i] / 3.0f);
+  }
+
+  simdStore(result, -simdMin(wideA, wideB) + simdMax(wideA, wideB));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == -std::min(a[i], b[i]) + std::max(a[i], b[i]));
+  }
+
+  simdStore(result, simdClamp(wideB, simdSet(-1.0f), simdSet(1.0f)));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == clamp(b[i], -1.0f, 1.0f));
+  }
+
+  simdStore(result, simdSqrt(wideA * wideA));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == std::sqrt(a[i] * a[i]));
+  }
+}
+
+TEST(SIMD, Select) {
+  float a[SIMD_WIDTH];
+  float b[SIMD_WIDTH];
+  float result[SIMD_WIDTH];
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    a[i] = static_cast<float>(i);
+    b[i] = static_cast<float>(SIMD_WIDTH - i) - 0.5f;
+  }
+
+  const SimdFloat wideA = simdLoad(a);
+  const SimdFloat wideB = simdLoad(b);
+  simdStore(result, simdSelect(simdGreater(wideA, wideB), wideA, wideB));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == (a[i] > b[i] ? a[i] : b[i]));
+  }
+
+  const SimdFloat isInside = simdAnd(simdGreaterEqual(wideA, simdSet(1.0f)), simdGreaterEqual(simdSet(2.0f), wideA));
+  const SimdFloat isOutside = simdOr(simdGreater(simdSet(1.0f), wideA), simdGreater(wideA, simdSet(2.0f)));
+  simdStore(result, simdSelect(isInside, simdSet(1.0f), simdSelect(isOutside, simdSet(-1.0f), simdZero())));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == (a[i] >= 1.0f && a[i] <= 2.0f ? 1.0f : -1.0f));
+  }
+
+  simdStore(result, simdSelect(simdEqual(wideA, simdSet(1.0f)), simdSet(1.0f), simdZero()));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == (i == 1 ? 1.0f : 0.0f));
+  }
+}
+
+TEST(SIMD, Mask) {
+  float a[SIMD_WIDTH];
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    a[i] = static_cast<float>(i % 3);
+  }
+
+  const uint32 bits = simdMask(simdGreater(simdLoad(a), simdSet(0.5f)));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(((bits >> i) & 1u) == (a[i] > 0.5f ? 1u : 0u));
+  }
+
+  EXPECT_TRUE(simdMask(simdZero()) == 0);
+  EXPECT_TRUE(simdMask(simdEqual(simdZero(), simdZero())) == (1u << SIMD_WIDTH) - 1);
+}
+
+TEST(SIMD, Vector2) {
+  float x[SIMD_WIDTH];
+  float y[SIMD_WIDTH];
+  float result[SIMD_WIDTH];
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    x[i] = static_cast<float>(i) + 1.0f;
+    y[i] = 2.0f * static_cast<float>(i) - 3.0f;
+  }
+
+  const SimdVector2 a = {simdLoad(x), simdLoad(y)};
+  const SimdVector2 b = {simdLoad(y), simdLoad(x)};
+
+  simdStore(result, dot(a, b));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == dot(Vector2(x[i], y[i]), Vector2(y[i], x[i])));
+  }
+
+  simdStore(result, cross(a - b, a + b));
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == cross(Vector2(x[i], y[i]) - Vector2(y[i], x[i]), Vector2(x[i], y[i]) + Vector2(y[i], x[i])));
+  }
+
+  const SimdVector2 c = cross(simdSet(2.0f), a);
+  simdStore(result, c.x);
+
+  for(uint32 i = 0; i < SIMD_WIDTH; i++) {
+    EXPECT_TRUE(result[i] == cross(2.0f, Vector2(x[i], y[i])).x);
+  }
+}
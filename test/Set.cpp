@@ -204,6 +204,24 @@ TEST(Set, Modifiers) {
   }
 
   EXPECT_TRUE(set6.size() == 0);
+
+  /* Sets which released their memory grow again from scratch */
+  Set<int> set7(memoryHandler);
+
+  for(int i = 0; i < 2; i++) {
+    for(int j = 0; j < 100; j++) {
+      set7.insert(j);
+    }
+
+    set7.clear(true);
+    set7.reserve(16);
+  }
+
+  for(int i = 0; i < 100; i++) {
+    set7.insert(i);
+  }
+
+  EXPECT_TRUE(set7.size() == 100 && set7.contains(99));
 }
 
 TEST(Set, ToArray) {
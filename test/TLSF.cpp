@@ -0,0 +1,76 @@
+#include "UnitTests.h"
+
+#include <physics/memory/TLSF.h>
+#include <physics/memory/Vanilla.h>
+
+#include <sstream>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace physics;
+
+TEST(TLSFMemoryHandler, AllocateFree) {
+  VanillaMemoryHandler primaryMemoryHandler;
+  TLSFMemoryHandler memoryHandler(primaryMemoryHandler, 4096);
+  const uint32 count = 2000;
+  std::vector<uint32*> blocks(count, nullptr);
+  std::vector<uint32> sizes(count, 0);
+  uint32 seed = 12345;
+
+  /* Interleave allocations and frees of every size class, growing past the initial size several times */
+  for(uint32 round = 0; round < 4; round++) {
+    for(uint32 i = 0; i < count; i++) {
+      seed = seed * 1664525 + 1013904223;
+
+      if(blocks[i]) {
+        EXPECT_TRUE(std::count(blocks[i], blocks[i] + sizes[i], i + round) == sizes[i]);
+        memoryHandler.free(blocks[i], sizes[i] * sizeof(uint32));
+        blocks[i] = nullptr;
+      }
+
+      if(seed & 0x100) {
+        sizes[i] = 1 + (seed >> 16) % ((seed & 0x200) ? 16 : 2048);
+        blocks[i] = static_cast<uint32*>(memoryHandler.allocate(sizes[i] * sizeof(uint32)));
+        EXPECT_TRUE(reinterpret_cast<std::uintptr_t>(blocks[i]) % 16 == 0);
+        std::fill(blocks[i], blocks[i] + sizes[i], i + round + 1);
+      }
+    }
+  }
+
+  /* Blocks must not overlap */
+  for(uint32 i = 0; i < count; i++) {
+    if(blocks[i]) {
+      EXPECT_TRUE(std::count(blocks[i], blocks[i] + sizes[i], i + 4) == sizes[i]);
+      memoryHandler.free(blocks[i], sizes[i] * sizeof(uint32));
+    }
+  }
+}
+
+TEST(TLSFMemoryHandler, Coalesce) {
+  CountingMemoryHandler primaryMemoryHandler;
+  TLSFMemoryHandler memoryHandler(primaryMemoryHandler, 65536);
+  const uint32 count = 64;
+  std::vector<void*> blocks(count);
+  EXPECT_TRUE(primaryMemoryHandler.numAllocations == 1);
+
+  for(uint32 i = 0; i < count; i++) {
+    blocks[i] = memoryHandler.allocate(512);
+  }
+
+  /* Free every other block first so that the remaining ones have to merge with both of their neighbours */
+  for(uint32 i = 0; i < count; i += 2) {
+    memoryHandler.free(blocks[i], 512);
+  }
+
+  for(uint32 i = 1; i < count; i += 2) {
+    memoryHandler.free(blocks[i], 512);
+  }
+
+  /* Freed blocks merged back into a single one which fits an allocation of nearly the whole region */
+  void* block = memoryHandler.allocate(32768);
+  EXPECT_TRUE(primaryMemoryHandler.numAllocations == 1);
+  memoryHandler.free(block, 32768);
+}
@@ -3,5 +3,25 @@
 
 #include <iostream>
 #include "gtest/gtest.h"
+#include <physics/Configuration.h>
+#include <physics/memory/Vanilla.h>
+
+/* Memory handler counting the allocations forwarded to the heap */
+class CountingMemoryHandler : public physics::VanillaMemoryHandler {
+
+  public:
+    /* -- Attributes -- */
+
+    /* Number of allocations */
+    physics::uint32 numAllocations = 0;
+
+    /* -- Methods -- */
+
+    /* Dynamically allocate memory of size in bytes and return a pointer to the heap allocated block */
+    void* allocate(size_t size) override {
+      numAllocations++;
+      return physics::VanillaMemoryHandler::allocate(size);
+    }
+};
 
 #endif
\ No newline at end of file
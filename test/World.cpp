@@ -1,10 +1,12 @@
 #include "UnitTests.h"
 
 #include <physics/Physics.h>
+#include <physics/collision/BroadPhase.h>
 
 #include <sstream>
 #include <type_traits>
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <vector>
 
@@ -49,4 +51,710 @@ TEST(World, General) {
 
     std::cout << "Dynamic Body Data: " << position.x << ", " << position.y << ", " << angle << std::endl;
   }
-}
\ No newline at end of file
+
+  /* The logger is shared by every factory so it is detached before being destroyed */
+  factory.setLogger(nullptr);
+  delete logger;
+}
+
+/* Task scheduler running the chunks of a range in reverse order on the calling thread under rotating thread indices */
+/* Results which depend on the order in which chunks run or on the thread running them show up regardless of the number of hardware threads */
+class ReversedTaskScheduler : public TaskScheduler {
+
+  public:
+    /* -- Attributes -- */
+
+    /* Number of chunks run under a thread index other than zero */
+    uint32 numOtherThreadChunks = 0;
+
+    /* -- Methods -- */
+
+    /* Get the number of threads which may execute tasks */
+    uint32 getNumThreads() const override {
+      return 4;
+    }
+
+    /* Execute the chunks of the range from the last one to the first one */
+    void parallelFor(uint32 count, uint32 grainSize, const Task& task) override {
+      for(uint32 chunk = getNumChunks(count, grainSize); chunk-- > 0;) {
+        const uint32 begin = chunk * grainSize;
+        const uint32 threadIndex = chunk % getNumThreads();
+        numOtherThreadChunks += threadIndex != 0;
+        task(begin, count - begin > grainSize ? begin + grainSize : count, threadIndex);
+      }
+    }
+};
+
+/* Drop a grid of bodies onto a static box and record the final positions and angles along with the statistics of the last step */
+/* Every other body of a mixed grid is a box while the others are circles */
+static std::vector<float> simulateGrid(const World::Settings& settings, uint32 numColumns, uint32 numRows, bool isMixed, World::StepStatistics* statistics = nullptr) {
+  Factory factory;
+  World* world = factory.createWorld(settings);
+  BoxShape* groundBox = factory.createBox(100.0f, 1.0f);
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+  CircleShape* circle = factory.createCircle(0.5f);
+  Transform transformLocalBody;
+  std::vector<Body*> bodies;
+
+  Body* ground = world->createBody(Transform(Vector2(0.0f, -1.0f), Rotation(0.0f)));
+  ground->setType(BodyType::Static);
+  ground->addCollider(groundBox, transformLocalBody);
+  ground->setMassPropertiesUsingColliders();
+
+  for(uint32 i = 0; i < numColumns; i++) {
+    for(uint32 j = 0; j < numRows; j++) {
+      /* Offset every other row so that the bodies topple */
+      const float x = -0.75f * numColumns + 1.5f * i + (j % 2 ? 0.25f : 0.0f);
+      const float y = 1.0f + 1.5f * j;
+      Body* body = world->createBody(Transform(Vector2(x, y), Rotation(0.1f * j)));
+      body->addCollider(isMixed && (i + j) % 2 ? static_cast<Shape*>(box) : static_cast<Shape*>(circle), transformLocalBody);
+      body->setMassPropertiesUsingColliders();
+      bodies.push_back(body);
+    }
+  }
+
+  for(uint32 i = 0; i < 120; i++) {
+    world->step(1.0f / 60.0f);
+  }
+
+  if(statistics) {
+    *statistics = world->getStepStatistics();
+  }
+
+  std::vector<float> states;
+
+  for(Body* body : bodies) {
+    const Transform& transform = body->getTransform();
+    states.push_back(transform.getPosition().x);
+    states.push_back(transform.getPosition().y);
+    states.push_back(transform.getOrientation().getAngle());
+  }
+
+  return states;
+}
+
+/* Simulate a grid serially, on worker threads and under the reversed task scheduler and expect identical results which rest on the ground */
+/* Returns the states of the serial simulation along with the statistics of its last step */
+static std::vector<float> expectDeterministic(const World::Settings& settings, uint32 numColumns, uint32 numRows, bool isMixed, World::StepStatistics* statistics = nullptr) {
+  World::Settings parallelSettings = settings;
+  parallelSettings.numWorkerThreads = 3;
+  ReversedTaskScheduler reversedScheduler;
+  World::Settings reversedSettings = settings;
+  reversedSettings.taskScheduler = &reversedScheduler;
+
+  const std::vector<float> serialStates = simulateGrid(settings, numColumns, numRows, isMixed, statistics);
+  const std::vector<float> parallelStates = simulateGrid(parallelSettings, numColumns, numRows, isMixed);
+  const std::vector<float> reversedStates = simulateGrid(reversedSettings, numColumns, numRows, isMixed);
+
+  /* Results must be bitwise identical regardless of the number of threads */
+  EXPECT_TRUE(serialStates == parallelStates);
+
+  /* Chunks which run out of order under other thread indices must not change the results either, even with a single hardware thread */
+  EXPECT_TRUE(reversedScheduler.numOtherThreadChunks > 0);
+  EXPECT_TRUE(serialStates == reversedStates);
+
+  /* Every body has come to rest on the ground or on other bodies */
+  for(size_t i = 0; i < serialStates.size(); i += 3) {
+    EXPECT_TRUE(serialStates[i + 1] > -0.1f);
+  }
+
+  return serialStates;
+}
+
+TEST(World, JobSystemDeterminism) {
+  World::Settings settings;
+  VanillaMemoryHandler memoryHandler;
+  JobSystem jobSystem(memoryHandler, 2);
+  World::Settings schedulerSettings;
+  schedulerSettings.taskScheduler = &jobSystem;
+  World::StepStatistics statistics;
+
+  const std::vector<float> serialStates = expectDeterministic(settings, 30, 20, false, &statistics);
+
+  /* An external job system runs the same chunks as the one owned by the world */
+  EXPECT_TRUE(serialStates == simulateGrid(schedulerSettings, 30, 20, false));
+
+  /* Islands are spread over several batches which are solved as independent tasks */
+  EXPECT_TRUE(statistics.numIslands > 1);
+  EXPECT_TRUE(statistics.numIslandBatches > 1);
+  EXPECT_TRUE(statistics.numIslandBatches <= statistics.numIslands);
+  EXPECT_TRUE(statistics.numColoredIslands == 0);
+}
+
+TEST(World, GraphColoringDeterminism) {
+  World::Settings settings;
+  settings.isGraphColoringEnabled = true;
+  settings.graphColoringManifoldThreshold = 8;
+  World::StepStatistics statistics;
+
+  /* Colors are solved in a fixed order so results must not depend on the number of threads */
+  expectDeterministic(settings, 30, 20, false, &statistics);
+
+  /* Islands past the threshold are colored, with bodies which touch several others needing more than one color */
+  EXPECT_TRUE(statistics.numColoredIslands > 0);
+  EXPECT_TRUE(statistics.numColors > statistics.numColoredIslands);
+  EXPECT_TRUE(statistics.numWideConstraints == 0);
+}
+
+TEST(World, SimdSolverAccuracy) {
+  World::Settings scalarSettings;
+  scalarSettings.isGraphColoringEnabled = true;
+  scalarSettings.graphColoringManifoldThreshold = 8;
+  World::Settings simdSettings = scalarSettings;
+  simdSettings.isSimdSolverEnabled = true;
+  World::Settings parallelSimdSettings = simdSettings;
+  parallelSimdSettings.numWorkerThreads = 3;
+  ReversedTaskScheduler reversedScheduler;
+  World::Settings reversedSimdSettings = simdSettings;
+  reversedSimdSettings.taskScheduler = &reversedScheduler;
+  World::StepStatistics statistics;
+
+  const std::vector<float> scalarStates = simulateGrid(scalarSettings, 30, 20, false);
+  const std::vector<float> simdStates = simulateGrid(simdSettings, 30, 20, false, &statistics);
+  const std::vector<float> parallelSimdStates = simulateGrid(parallelSimdSettings, 30, 20, false);
+  const std::vector<float> reversedSimdStates = simulateGrid(reversedSimdSettings, 30, 20, false);
+
+  /* The colors of the colored islands are packed into wide constraints */
+  EXPECT_TRUE(statistics.numColoredIslands > 0);
+  EXPECT_TRUE(statistics.numWideConstraints > 0);
+
+  /* The scalar solver is the reference, lanes may only differ by rounding */
+  ASSERT_TRUE(scalarStates.size() == simdStates.size());
+
+  for(size_t i = 0; i < scalarStates.size(); i++) {
+    EXPECT_NEAR(scalarStates[i], simdStates[i], 1e-3f);
+  }
+
+  EXPECT_TRUE(simdStates == parallelSimdStates);
+  EXPECT_TRUE(simdStates == reversedSimdStates);
+}
+
+TEST(World, PersistentIslands) {
+  World::Settings settings;
+  settings.islandGeneration = IslandGeneration::Persistent;
+  expectDeterministic(settings, 30, 20, false);
+
+  /* Destroying bodies and changing body types dissolves their islands */
+  Factory factory;
+  World* world = factory.createWorld(settings);
+  BoxShape* box = factory.createBox(100.0f, 1.0f);
+  CircleShape* circle = factory.createCircle(0.5f);
+  Transform transformLocalBody;
+  std::vector<Body*> bodies;
+
+  Body* ground = world->createBody(Transform(Vector2(0.0f, -1.0f), Rotation(0.0f)));
+  ground->setType(BodyType::Static);
+  ground->addCollider(box, transformLocalBody);
+  ground->setMassPropertiesUsingColliders();
+
+  for(uint32 i = 0; i < 10; i++) {
+    Body* body = world->createBody(Transform(Vector2(0.0f, 1.0f * i), Rotation(0.0f)));
+    body->addCollider(circle, transformLocalBody);
+    body->setMassPropertiesUsingColliders();
+    bodies.push_back(body);
+  }
+
+  for(uint32 i = 0; i < 240; i++) {
+    if(i == 60) {
+      world->destroyBody(bodies[3]);
+      bodies.erase(bodies.begin() + 3);
+    }
+
+    if(i == 120) {
+      bodies[5]->setType(BodyType::Static);
+    }
+
+    if(i == 180) {
+      bodies[5]->setType(BodyType::Dynamic);
+    }
+
+    world->step(1.0f / 60.0f);
+  }
+
+  for(Body* body : bodies) {
+    EXPECT_TRUE(body->getTransform().getPosition().y > -0.1f);
+  }
+
+  /* Two circles resting against each other share an island until they roll apart */
+  World::Settings splitSettings = settings;
+  splitSettings.isSleepingEnabled = false;
+  World* splitWorld = factory.createWorld(splitSettings);
+  Body* splitGround = splitWorld->createBody(Transform(Vector2(0.0f, -1.0f), Rotation(0.0f)));
+  splitGround->setType(BodyType::Static);
+  splitGround->addCollider(box, transformLocalBody);
+  Body* splitBodies[2];
+
+  for(uint32 i = 0; i < 2; i++) {
+    splitBodies[i] = splitWorld->createBody(Transform(Vector2(0.99f * i, 0.5f), Rotation(0.0f)));
+    splitBodies[i]->addCollider(circle, transformLocalBody);
+    splitBodies[i]->setMassPropertiesUsingColliders();
+  }
+
+  for(uint32 i = 0; i < 10; i++) {
+    splitWorld->step(1.0f / 60.0f);
+  }
+
+  EXPECT_TRUE(splitWorld->getStepStatistics().numIslands == 1);
+  EXPECT_TRUE(splitWorld->getStepStatistics().maxNumIslandBodies == 2);
+
+  splitBodies[0]->setLinearVelocity(Vector2(-2.0f, 0.0f));
+  splitBodies[1]->setLinearVelocity(Vector2(2.0f, 0.0f));
+
+  for(uint32 i = 0; i < 30; i++) {
+    splitWorld->step(1.0f / 60.0f);
+  }
+
+  EXPECT_TRUE(splitWorld->getStepStatistics().numIslands == 2);
+  EXPECT_TRUE(splitWorld->getStepStatistics().maxNumIslandBodies == 1);
+}
+
+TEST(World, ParallelIslands) {
+  World::Settings serialSettings;
+  serialSettings.islandGeneration = IslandGeneration::Parallel;
+  expectDeterministic(serialSettings, 30, 20, false);
+
+  /* Four stacks of three touching circles form four islands, the static ground linking none of them */
+  World::Settings parallelSettings = serialSettings;
+  parallelSettings.numWorkerThreads = 3;
+  ReversedTaskScheduler reversedScheduler;
+  World::Settings reversedSettings = serialSettings;
+  reversedSettings.taskScheduler = &reversedScheduler;
+  Factory factory;
+  BoxShape* box = factory.createBox(100.0f, 1.0f);
+  CircleShape* circle = factory.createCircle(0.5f);
+
+  for(World::Settings settings : {serialSettings, parallelSettings, reversedSettings}) {
+    World* world = factory.createWorld(settings);
+    Body* ground = world->createBody(Transform(Vector2(0.0f, -1.0f), Rotation(0.0f)));
+    ground->setType(BodyType::Static);
+    ground->addCollider(box, Transform());
+
+    for(uint32 i = 0; i < 4; i++) {
+      for(uint32 j = 0; j < 3; j++) {
+        Body* body = world->createBody(Transform(Vector2(3.0f * i, 0.5f + 0.99f * j), Rotation(0.0f)));
+        body->addCollider(circle, Transform());
+        body->setMassPropertiesUsingColliders();
+      }
+    }
+
+    world->step(1.0f / 60.0f);
+    EXPECT_TRUE(world->getStepStatistics().numIslands == 4);
+    EXPECT_TRUE(world->getStepStatistics().maxNumIslandBodies == 3);
+  }
+}
+
+TEST(World, BoxStack) {
+  Factory factory;
+  World* world = factory.createWorld();
+  BoxShape* groundBox = factory.createBox(100.0f, 1.0f);
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+  Transform transformLocalBody;
+  std::vector<Body*> bodies;
+
+  Body* ground = world->createBody(Transform(Vector2(0.0f, -1.0f), Rotation(0.0f)));
+  ground->setType(BodyType::Static);
+  ground->addCollider(groundBox, transformLocalBody);
+  ground->setMassPropertiesUsingColliders();
+
+  for(uint32 i = 0; i < 5; i++) {
+    Body* body = world->createBody(Transform(Vector2(0.0f, 1.0f + 1.1f * i), Rotation(0.0f)));
+    body->addCollider(box, transformLocalBody);
+    body->setMassPropertiesUsingColliders();
+    bodies.push_back(body);
+  }
+
+  for(uint32 i = 0; i < 240; i++) {
+    world->step(1.0f / 60.0f);
+  }
+
+  /* Polygon-Polygon contacts keep the boxes stacked on top of each other */
+  for(uint32 i = 0; i < bodies.size(); i++) {
+    const Vector2& position = bodies[i]->getTransform().getPosition();
+    EXPECT_NEAR(position.x, 0.0f, 0.1f);
+    EXPECT_NEAR(position.y, 0.5f + 1.0f * i, 0.15f);
+  }
+}
+
+TEST(World, ManifoldReuse) {
+  Factory factory;
+  World::Settings settings;
+  settings.isManifoldReuseEnabled = true;
+  World* world = factory.createWorld(settings);
+  BoxShape* groundBox = factory.createBox(100.0f, 1.0f);
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+  CircleShape* circle = factory.createCircle(0.5f);
+  Transform transformLocalBody;
+  std::vector<Body*> bodies;
+
+  Body* ground = world->createBody(Transform(Vector2(0.0f, -1.0f), Rotation(0.0f)));
+  ground->setType(BodyType::Static);
+  ground->addCollider(groundBox, transformLocalBody);
+  ground->setMassPropertiesUsingColliders();
+
+  for(uint32 i = 0; i < 5; i++) {
+    Body* body = world->createBody(Transform(Vector2(0.0f, 1.0f + 1.1f * i), Rotation(0.0f)));
+    body->addCollider(box, transformLocalBody);
+    body->setMassPropertiesUsingColliders();
+    bodies.push_back(body);
+  }
+
+  /* A ball resting next to the stack covers the circle algorithms */
+  Body* ball = world->createBody(Transform(Vector2(5.0f, 1.0f), Rotation(0.0f)));
+  ball->addCollider(circle, transformLocalBody);
+  ball->setMassPropertiesUsingColliders();
+  uint32 numReusedEntries = 0;
+
+  for(uint32 i = 0; i < 240; i++) {
+    world->step(1.0f / 60.0f);
+    numReusedEntries += world->getStepStatistics().numReusedEntries;
+  }
+
+  EXPECT_TRUE(numReusedEntries > 0);
+
+  /* Resting contacts reuse their manifolds without the stack drifting apart */
+  for(uint32 i = 0; i < bodies.size(); i++) {
+    const Vector2& position = bodies[i]->getTransform().getPosition();
+    EXPECT_NEAR(position.x, 0.0f, 0.1f);
+    EXPECT_NEAR(position.y, 0.5f + 1.0f * i, 0.15f);
+  }
+
+  EXPECT_NEAR(ball->getTransform().getPosition().x, 5.0f, 0.1f);
+  EXPECT_NEAR(ball->getTransform().getPosition().y, 0.5f, 0.05f);
+}
+
+TEST(World, ManifoldReuseShapeChange) {
+  Factory factory;
+  World::Settings settings;
+  settings.isManifoldReuseEnabled = true;
+  settings.isSleepingEnabled = false;
+  World* world = factory.createWorld(settings);
+  BoxShape* groundBox = factory.createBox(100.0f, 1.0f);
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+  Transform transformLocalBody;
+
+  Body* ground = world->createBody(Transform(Vector2(0.0f, -1.0f), Rotation(0.0f)));
+  ground->setType(BodyType::Static);
+  ground->addCollider(groundBox, transformLocalBody);
+
+  Body* body = world->createBody(Transform(Vector2(0.0f, 0.5f), Rotation(0.0f)));
+  Collider* collider = body->addCollider(box, transformLocalBody);
+  body->setMassPropertiesUsingColliders();
+
+  for(uint32 i = 0; i < 60; i++) {
+    world->step(1.0f / 60.0f);
+  }
+
+  EXPECT_TRUE(world->getStepStatistics().numReusedEntries == 1);
+
+  /* The resting box grows into the ground without moving relative to it so only a new manifold pushes it out */
+  box->set(1.0f, 1.0f);
+  world->step(1.0f / 60.0f);
+  EXPECT_TRUE(world->getStepStatistics().numReusedEntries == 0);
+  EXPECT_TRUE(world->getStepStatistics().numContactPairs == 1);
+
+  for(uint32 i = 0; i < 60; i++) {
+    world->step(1.0f / 60.0f);
+  }
+
+  EXPECT_NEAR(body->getTransform().getPosition().y, 1.0f, 0.05f);
+
+  /* Moving the collider within its body discards its manifold in the same way */
+  collider->setTransformLocalBody(Transform(Vector2(0.0f, -0.5f), Rotation(0.0f)));
+  world->step(1.0f / 60.0f);
+  EXPECT_TRUE(world->getStepStatistics().numReusedEntries == 0);
+  EXPECT_TRUE(world->getStepStatistics().numContactPairs == 1);
+}
+
+TEST(World, SleepingBodies) {
+  for(IslandGeneration islandGeneration : {IslandGeneration::DepthFirstSearch, IslandGeneration::Persistent, IslandGeneration::Parallel}) {
+    Factory factory;
+    World::Settings settings;
+    settings.islandGeneration = islandGeneration;
+    World* world = factory.createWorld(settings);
+    BoxShape* groundBox = factory.createBox(100.0f, 1.0f);
+    BoxShape* box = factory.createBox(0.5f, 0.5f);
+    std::vector<Body*> bodies;
+
+    Body* ground = world->createBody(Transform(Vector2(0.0f, -1.0f), Rotation(0.0f)));
+    ground->setType(BodyType::Static);
+    ground->addCollider(groundBox, Transform());
+
+    for(uint32 i = 0; i < 3; i++) {
+      Body* body = world->createBody(Transform(Vector2(0.0f, 0.5f + 1.0f * i), Rotation(0.0f)));
+      body->addCollider(box, Transform());
+      body->setMassPropertiesUsingColliders();
+      bodies.push_back(body);
+    }
+
+    world->step(1.0f / 60.0f);
+    EXPECT_TRUE(world->getStepStatistics().numSolverBodies == 4);
+
+    for(uint32 i = 0; i < 300; i++) {
+      world->step(1.0f / 60.0f);
+    }
+
+    /* Only the static ground is left in the solver arrays once the stack sleeps */
+    for(Body* body : bodies) {
+      EXPECT_TRUE(body->isSleeping());
+    }
+
+    world->step(1.0f / 60.0f);
+    EXPECT_TRUE(world->getStepStatistics().numSolverBodies == 1);
+    EXPECT_TRUE(world->getStepStatistics().numIslands == 0);
+
+    /* Pushing the top box wakes it and, one contact further each step, the boxes below it */
+    bodies[2]->applyForceToCenter(Vector2(0.0f, -1.0f));
+
+    for(uint32 i = 0; i < 3; i++) {
+      world->step(1.0f / 60.0f);
+    }
+
+    EXPECT_TRUE(world->getStepStatistics().numSolverBodies == 4);
+
+    for(uint32 i = 0; i < bodies.size(); i++) {
+      EXPECT_FALSE(bodies[i]->isSleeping());
+      EXPECT_NEAR(bodies[i]->getTransform().getPosition().y, 0.5f + 1.0f * i, 0.15f);
+    }
+  }
+}
+
+TEST(World, NarrowPhaseDeterminism) {
+  for(bool isManifoldReuseEnabled : {false, true}) {
+    World::Settings settings;
+    settings.isManifoldReuseEnabled = isManifoldReuseEnabled;
+    World::StepStatistics statistics;
+
+    /* Contact pairs are merged in entry order so results must not depend on the number of threads */
+    expectDeterministic(settings, 20, 10, true, &statistics);
+
+    /* Every collision algorithm has entries in its own batch */
+    EXPECT_TRUE(statistics.numCircleVCircleEntries > 0);
+    EXPECT_TRUE(statistics.numCircleVPolygonEntries > 0);
+    EXPECT_TRUE(statistics.numPolygonVPolygonEntries > 0);
+    EXPECT_TRUE((statistics.numReusedEntries > 0) == isManifoldReuseEnabled);
+  }
+}
+
+TEST(World, MemoryStatistics) {
+  Factory factory;
+  World* world = factory.createWorld();
+  CircleShape* circle = factory.createCircle(0.5f);
+  const MemoryStatistics initialStatistics = world->getMemoryStatistics(MemoryStrategy::HandlerType::ObjectPool);
+
+  for(uint32 i = 0; i < 100; i++) {
+    Body* body = world->createBody(Transform(Vector2(2.0f * i, 0.0f), Rotation(0.0f)));
+    body->addCollider(circle, Transform());
+  }
+
+  world->step(1.0f / 60.0f);
+
+  /* Bodies and colliders are allocated from the Object Pool handler */
+  const MemoryStatistics statistics = world->getMemoryStatistics(MemoryStrategy::HandlerType::ObjectPool);
+  EXPECT_TRUE(statistics.numUsedBytes >= initialStatistics.numUsedBytes + 100 * (sizeof(Body) + sizeof(Collider)));
+  EXPECT_TRUE(statistics.numAllocations >= initialStatistics.numAllocations + 200);
+  EXPECT_TRUE(world->getMemoryStatistics(MemoryStrategy::HandlerType::Linear).numPeakUsedBytes > 0);
+}
+
+TEST(World, TLSFGeneralMemoryHandler) {
+  Factory factory(nullptr, MemoryStrategy::HandlerType::TLSF);
+  World::Settings settings;
+  settings.numWorkerThreads = 2;
+  World* world = factory.createWorld(settings);
+  CircleShape* circle = factory.createCircle(0.5f);
+
+  for(uint32 i = 0; i < 10; i++) {
+    Body* body = world->createBody(Transform(Vector2(0.0f, 1.0f * i), Rotation(0.0f)));
+    body->addCollider(circle, Transform());
+    body->setMassPropertiesUsingColliders();
+  }
+
+  world->step(1.0f / 60.0f);
+
+  /* The world and its job system come from the selected handler while the Free List handler stays idle */
+  EXPECT_TRUE(world->getMemoryStatistics(MemoryStrategy::HandlerType::TLSF).numUsedBytes >= sizeof(World) + sizeof(JobSystem));
+  EXPECT_TRUE(world->getMemoryStatistics(MemoryStrategy::HandlerType::FreeList).numAllocations == 0);
+}
+
+TEST(World, MemoryTrim) {
+  Factory factory;
+  World* world = factory.createWorld();
+  CircleShape* circle = factory.createCircle(0.5f);
+  std::vector<Body*> bodies;
+
+  for(uint32 round = 0; round < 2; round++) {
+    for(uint32 i = 0; i < 2000; i++) {
+      Body* body = world->createBody(Transform(Vector2(2.0f * i, 0.0f), Rotation(0.0f)));
+      body->addCollider(circle, Transform());
+      bodies.push_back(body);
+    }
+
+    world->step(1.0f / 60.0f);
+    const size_t numReservedBytes = world->getMemoryStatistics(MemoryStrategy::HandlerType::ObjectPool).numReservedBytes;
+
+    for(Body* body : bodies) {
+      world->destroyBody(body);
+    }
+
+    bodies.clear();
+
+    /* The pools emptied by the destroyed bodies go back to the primary memory handler, on request first and then automatically */
+    if(round == 0) {
+      EXPECT_TRUE(factory.trimMemory() > 0);
+      factory.setMemoryTrimThreshold(64 * 1024);
+    }
+
+    EXPECT_TRUE(world->getMemoryStatistics(MemoryStrategy::HandlerType::ObjectPool).numReservedBytes < numReservedBytes);
+  }
+}
+
+TEST(World, StepStatistics) {
+  Factory factory;
+  World* world = factory.createWorld();
+  BoxShape* groundBox = factory.createBox(100.0f, 1.0f);
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+  CircleShape* circle = factory.createCircle(0.5f);
+  std::vector<Body*> bodies;
+
+  Body* ground = world->createBody(Transform(Vector2(0.0f, -1.0f), Rotation(0.0f)));
+  ground->setType(BodyType::Static);
+  ground->addCollider(groundBox, Transform());
+  bodies.push_back(ground);
+
+  for(uint32 i = 0; i < 5; i++) {
+    Body* body = world->createBody(Transform(Vector2(0.0f, 0.5f + 1.0f * i), Rotation(0.0f)));
+    body->addCollider(box, Transform());
+    body->setMassPropertiesUsingColliders();
+    bodies.push_back(body);
+  }
+
+  for(uint32 i = 0; i < 2; i++) {
+    Body* body = world->createBody(Transform(Vector2(5.0f + 1.0f * i, 0.5f), Rotation(0.0f)));
+    body->addCollider(circle, Transform());
+    body->setMassPropertiesUsingColliders();
+    bodies.push_back(body);
+  }
+
+  world->step(1.0f / 60.0f);
+
+  /* Every stage of the step reports the work it did */
+  const World::StepStatistics& statistics = world->getStepStatistics();
+  EXPECT_TRUE(statistics.numMovedShapes == 8);
+  EXPECT_TRUE(statistics.numOverlapNodes >= statistics.numOverlapPairs);
+  EXPECT_TRUE(statistics.numOverlapPairs >= 8);
+  EXPECT_TRUE(statistics.numPolygonVPolygonEntries >= 5);
+  EXPECT_TRUE(statistics.numCircleVPolygonEntries >= 2);
+  EXPECT_TRUE(statistics.numCircleVCircleEntries == 1);
+  EXPECT_TRUE(statistics.numReusedEntries == 0);
+  EXPECT_TRUE(statistics.numContactPairs >= 8);
+  EXPECT_TRUE(statistics.numManifolds == statistics.numContactPairs);
+  EXPECT_TRUE(statistics.numIslands == 2);
+  EXPECT_TRUE(statistics.maxNumIslandBodies >= 5);
+  /* Both islands fit in a single batch and are not colored */
+  EXPECT_TRUE(statistics.numIslandBatches == 1);
+  EXPECT_TRUE(statistics.numColoredIslands == 0);
+  EXPECT_TRUE(statistics.numColors == 0);
+  EXPECT_TRUE(statistics.numWideConstraints == 0);
+  EXPECT_TRUE(statistics.numVelocitySolverIterations == 10);
+  EXPECT_TRUE(statistics.numPositionSolverIterations == 8);
+  /* The static ground is neither awake nor sleeping */
+  EXPECT_TRUE(statistics.numAwakeBodies == 7);
+  EXPECT_TRUE(statistics.numSleepingBodies == 0);
+
+  for(uint32 i = 0; i < 300; i++) {
+    world->step(1.0f / 60.0f);
+  }
+
+  /* Resting bodies fall asleep and are counted as their status changes */
+  uint32 numSleepingBodies = 0;
+
+  for(uint32 i = 0; i < bodies.size(); i++) {
+    numSleepingBodies += bodies[i]->isSleeping();
+  }
+
+  EXPECT_TRUE(numSleepingBodies > 0);
+  EXPECT_TRUE(world->getStepStatistics().numSleepingBodies == numSleepingBodies);
+  EXPECT_TRUE(world->getStepStatistics().numAwakeBodies == 7 - numSleepingBodies);
+}
+
+TEST(World, StaticBroadPhase) {
+  Factory factory;
+  World* world = factory.createWorld();
+  BoxShape* groundBox = factory.createBox(1.0f, 1.0f);
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+
+  /* Row of overlapping static boxes */
+  for(uint32 i = 0; i < 10; i++) {
+    Body* ground = world->createBody(Transform(Vector2(1.0f * i, -1.0f), Rotation(0.0f)));
+    ground->setType(BodyType::Static);
+    ground->addCollider(groundBox, Transform());
+  }
+
+  Body* body = world->createBody(Transform(Vector2(0.0f, 0.5f), Rotation(0.0f)));
+  body->addCollider(box, Transform());
+  body->setMassPropertiesUsingColliders();
+  /* Starts out static and only later falls onto the static boxes */
+  Body* switched = world->createBody(Transform(Vector2(6.0f, 0.5f), Rotation(0.0f)));
+  switched->setType(BodyType::Static);
+  switched->addCollider(box, Transform());
+  switched->setMassPropertiesUsingColliders();
+  world->step(1.0f / 60.0f);
+
+  /* Static shapes overlapping with each other are never paired, only the dynamic shape and the two static boxes below it are */
+  /* Both moved shapes of each pair find the other one while the dynamic shape also finds itself in the dynamic tree */
+  const World::StepStatistics& statistics = world->getStepStatistics();
+  EXPECT_TRUE(statistics.numMovedShapes == 12);
+  EXPECT_TRUE(statistics.numOverlapNodes == 5);
+  EXPECT_TRUE(statistics.numOverlapPairs == 2);
+
+  switched->setType(BodyType::Dynamic);
+
+  for(uint32 i = 0; i < 120; i++) {
+    world->step(1.0f / 60.0f);
+  }
+
+  /* Both bodies rest on the static boxes */
+  EXPECT_TRUE(std::abs(body->getTransform().getPosition().y - 0.5f) < 0.05f);
+  EXPECT_TRUE(std::abs(switched->getTransform().getPosition().y - 0.5f) < 0.05f);
+}
+
+TEST(World, BroadPhaseTypeChange) {
+  Factory factory;
+  World* world = factory.createWorld();
+  BoxShape* groundBox = factory.createBox(1.0f, 1.0f);
+  BoxShape* box = factory.createBox(0.5f, 0.5f);
+
+  /* Row of overlapping static boxes */
+  for(uint32 i = 0; i < 10; i++) {
+    Body* ground = world->createBody(Transform(Vector2(1.0f * i, -1.0f), Rotation(0.0f)));
+    ground->setType(BodyType::Static);
+    ground->addCollider(groundBox, Transform());
+  }
+
+  /* Rests on the static boxes at x = 5, 6 and 7 */
+  Body* body = world->createBody(Transform(Vector2(6.0f, 0.5f), Rotation(0.0f)));
+  body->setIsAllowedToSleep(false);
+  Collider* collider = body->addCollider(box, Transform());
+  body->setMassPropertiesUsingColliders();
+  world->step(1.0f / 60.0f);
+
+  EXPECT_FALSE(BroadPhase::isStatic(collider->getBroadPhaseIdentifier()));
+  EXPECT_TRUE(world->getStepStatistics().numOverlapPairs == 3);
+
+  /* A static body moves into the static tree and loses its pairs with the other static bodies */
+  body->setType(BodyType::Static);
+  EXPECT_TRUE(BroadPhase::isStatic(collider->getBroadPhaseIdentifier()));
+  world->step(1.0f / 60.0f);
+  EXPECT_TRUE(world->getStepStatistics().numMovedShapes == 1);
+  EXPECT_TRUE(world->getStepStatistics().numOverlapNodes == 0);
+  EXPECT_TRUE(world->getStepStatistics().numOverlapPairs == 0);
+
+  /* A dynamic body moves back into the dynamic tree and is paired with the static bodies again */
+  body->setType(BodyType::Dynamic);
+  EXPECT_FALSE(BroadPhase::isStatic(collider->getBroadPhaseIdentifier()));
+  world->step(1.0f / 60.0f);
+  EXPECT_TRUE(world->getStepStatistics().numMovedShapes == 1);
+  /* The three static boxes below it along with itself in the dynamic tree */
+  EXPECT_TRUE(world->getStepStatistics().numOverlapNodes == 4);
+  EXPECT_TRUE(world->getStepStatistics().numOverlapPairs == 3);
+  EXPECT_TRUE(world->getStepStatistics().numContactPairs == 3);
+}